@@ -162,6 +162,7 @@ target_sources(simutrans PRIVATE
 		src/simutrans/gui/message_frame.cc
 		src/simutrans/gui/message_option.cc
 		src/simutrans/gui/message_stats.cc
+		src/simutrans/gui/memory_stats_frame.cc
 		src/simutrans/gui/messagebox.cc
 		src/simutrans/gui/minimap.cc
 		src/simutrans/gui/money_frame.cc
@@ -173,6 +174,7 @@ target_sources(simutrans PRIVATE
 		src/simutrans/gui/player_frame.cc
 		src/simutrans/gui/player_ranking_frame.cc
 		src/simutrans/gui/privatesign_info.cc
+		src/simutrans/gui/profiler_frame.cc
 		src/simutrans/gui/savegame_frame.cc
 		src/simutrans/gui/scenario_frame.cc
 		src/simutrans/gui/scenario_info.cc
@@ -302,10 +304,13 @@ target_sources(simutrans PRIVATE
 		src/simutrans/tool/simmenu.cc
 		src/simutrans/tool/simtool-scripted.cc
 		src/simutrans/tool/simtool.cc
+		src/simutrans/utils/benchmark.cc
 		src/simutrans/utils/cbuffer.cc
 		src/simutrans/utils/checklist.cc
 		src/simutrans/utils/csv.cc
 		src/simutrans/utils/log.cc
+		src/simutrans/utils/memory_stats.cc
+		src/simutrans/utils/profiler.cc
 		src/simutrans/utils/searchfolder.cc
 		src/simutrans/utils/sha1.cc
 		src/simutrans/utils/sha1_hash.cc
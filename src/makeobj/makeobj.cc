@@ -34,7 +34,8 @@ int main(int argc, char* argv[])
 	init_logging("stderr", true, true, "", "makeobj");
 	debuglevel = log_t::LEVEL_WARN; // only warnings and errors
 
-	while(  argc  &&  (  !STRICMP(argv[0], "quiet")  ||  !STRICMP(argv[0], "verbose")  ||  !STRICMP(argv[0], "debug")  )  ) {
+	while(  argc  &&  (  !STRICMP(argv[0], "quiet")  ||  !STRICMP(argv[0], "verbose")  ||  !STRICMP(argv[0], "debug")  ||
+	                     !STRNICMP(argv[0], "jobs=", 5)  ||  !STRICMP(argv[0], "incremental")  )  ) {
 
 		if (argc && !STRICMP(argv[0], "debug")) {
 			argv++; argc--;
@@ -48,6 +49,15 @@ int main(int argc, char* argv[])
 			argv++; argc--;
 			debuglevel = log_t::LEVEL_ERROR; // only fatal errors
 		}
+		else if (argc && !STRNICMP(argv[0], "jobs=", 5)) {
+			const int jobs = atoi(argv[0] + 5);
+			argv++; argc--;
+			root_writer_t::set_jobs( jobs > 1 ? jobs : 1 );
+		}
+		else if (argc && !STRICMP(argv[0], "incremental")) {
+			argv++; argc--;
+			root_writer_t::set_incremental(true);
+		}
 	}
 
 	if(  debuglevel>=log_t::LEVEL_WARN  ) {
@@ -168,7 +178,7 @@ int main(int argc, char* argv[])
 	}
 
 	puts(
-		"\n   Usage: MakeObj [QUIET|VERBOSE|DEBUG] <Command> <params>\n"
+		"\n   Usage: MakeObj [QUIET|VERBOSE|DEBUG] [JOBS=<n>] [INCREMENTAL] <Command> <params>\n"
 		"\n"
 		"      MakeObj CAPABILITIES\n"
 		"         Gives the list of objects, this program can read\n"
@@ -196,6 +206,13 @@ int main(int argc, char* argv[])
 		"      with VERBOSE as first arg also unused lines\n"
 		"      and unassigned entries are printed\n"
 		"\n"
+		"      with JOBS=<n> PAK compiles the dat files with n processes\n"
+		"      (not on Windows)\n"
+		"\n"
+		"      with INCREMENTAL PAK keeps the compiled dat files in a cache\n"
+		"      folder next to the pak file and only compiles dat files again,\n"
+		"      when they or their images changed\n"
+		"\n"
 		"      DEBUG dumps extended information about the pak process.\n"
 		"          Source: interpreted line from .dat file\n"
 		"          Image:  .png file name\n"
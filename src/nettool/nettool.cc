@@ -427,6 +427,9 @@ void usage()
 		"      remove-company <company number>\n"
 		"        Immediately remove company and all its belongings\n"
 		"\n"
+		"      memory\n"
+		"        Show the memory used by the game, per category and object type\n"
+		"\n"
 		"      kick-client <client number>\n"
 		"      ban-client  <client number>\n"
 		"        Kick / ban client (use clients command to get client number)\n"
@@ -551,7 +554,8 @@ int main(int argc, char* argv[]) {
 		{"info-company",   true,  nwc_service_t::SRVC_GET_COMPANY_INFO, 1, &simple_gettext_command},
 		{"unlock-company", true,  nwc_service_t::SRVC_UNLOCK_COMPANY,   1, &simple_command},
 		{"remove-company", true,  nwc_service_t::SRVC_REMOVE_COMPANY,   1, &simple_command},
-		{"lock-company",   true,  nwc_service_t::SRVC_LOCK_COMPANY,     2, &lock_company}
+		{"lock-company",   true,  nwc_service_t::SRVC_LOCK_COMPANY,     2, &lock_company},
+		{"memory",         true,  nwc_service_t::SRVC_GET_MEMORY_STATS, 0, &simple_gettext_command}
 	};
 	int numcommands = lengthof(commands);
 
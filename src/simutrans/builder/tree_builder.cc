@@ -52,7 +52,20 @@ const tree_desc_t *tree_builder_t::find_tree(const char *tree_name)
 
 uint8 tree_builder_t::plant_tree_on_coordinate(koord pos, const uint8 maximum_count, const uint8 count)
 {
-	grund_t *gr = welt->lookup_kartenboden(pos);
+	const uint8 count_planted = min( get_free_tree_count( pos, maximum_count ), count );
+	if(  count_planted > 0  ) {
+		grund_t *gr = welt->lookup_kartenboden(pos);
+		for (uint8 i=0; i<count_planted; i++) {
+			gr->obj_add( new baum_t(gr->get_pos()) ); //plants the tree(s)
+		}
+	}
+	return count_planted;
+}
+
+
+uint8 tree_builder_t::get_free_tree_count(koord pos, const uint8 maximum_count)
+{
+	const grund_t *gr = welt->lookup_kartenboden(pos);
 	if(  gr  ) {
 		if(  has_trees_for_climate( welt->get_climate(pos) )  &&  gr->ist_natur()  &&  gr->get_top() < maximum_count  ) {
 			obj_t *obj = gr->obj_bei(0);
@@ -77,12 +90,7 @@ uint8 tree_builder_t::plant_tree_on_coordinate(koord pos, const uint8 maximum_co
 				}
 			}
 
-			const uint8 count_planted = min( maximum_count - gr->get_top(), count);
-			for (uint8 i=0; i<count_planted; i++) {
-				gr->obj_add( new baum_t(gr->get_pos()) ); //plants the tree(s)
-			}
-
-			return count_planted;
+			return maximum_count - gr->get_top();
 		}
 	}
 
@@ -79,6 +79,9 @@ public:
 	/// tree planting function - it takes care of checking suitability of area
 	static uint8 plant_tree_on_coordinate(koord pos, const uint8 maximum_count, const uint8 count);
 
+	/// number of trees, which can be planted here without exceeding maximum_count trees
+	static uint8 get_free_tree_count(koord pos, const uint8 maximum_count);
+
 	static const tree_desc_t *find_tree( const char *tree_name );
 
 	static const tree_desc_t *random_tree_for_climate(climate cl);
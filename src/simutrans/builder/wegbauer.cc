@@ -3005,8 +3005,8 @@ void way_builder_t::build_river()
 		fluss_test_driver_t river_tester;
 
 		if (to_the_sea.calc_route(welt, welt->lookup_kartenboden(route[last_common_water_tile].get_2d())->get_pos(), welt->lookup_kartenboden(route[0].get_2d())->get_pos(), &river_tester, 0, 0x7FFFFFFF)) {
-			for(koord3d const& entry : to_the_sea.get_route()) {
-				if (weg_t* const w = welt->lookup(entry)->get_weg(water_wt)) {
+			for(  uint32 i = 0;  i < to_the_sea.get_count();  i++  ) {
+				if (weg_t* const w = welt->lookup(to_the_sea.at(i))->get_weg(water_wt)) {
 					int type;
 					for(  type=env_t::river_types-1;  type>0;  type--  ) {
 						// lookup type
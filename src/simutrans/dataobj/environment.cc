@@ -157,7 +157,12 @@ sint32 env_t::autosave;
 uint32 env_t::fps;
 uint32 env_t::ff_fps;
 sint16 env_t::max_acceleration;
+bool env_t::fast_forward_unthrottled;
+uint32 env_t::fast_forward_time_limit;
 uint8 env_t::num_threads;
+bool env_t::pak_cache;
+uint32 env_t::image_cache_budget;
+uint8 env_t::far_traffic_interval;
 bool env_t::show_tooltips;
 rgb888_t env_t::tooltip_color_rgb;
 PIXVAL env_t::tooltip_color;
@@ -288,11 +293,18 @@ void env_t::init()
 	// maximum speedup set to 1000 (effectively no limit)
 	max_acceleration=50;
 
+	// fast forward is limited by max_acceleration unless requested otherwise
+	fast_forward_unthrottled = false;
+	fast_forward_time_limit = 0;
+
 #ifdef MULTI_THREAD
 	num_threads = min(MAX_THREADS,dr_get_max_threads());
 #else
 	num_threads = 1;
 #endif
+	pak_cache = false;
+	image_cache_budget = 0;
+	far_traffic_interval = 1;
 
 	sound_distance_scaling = 10;
 
@@ -428,9 +428,25 @@ public:
 	/// maximum acceleration with fast forward
 	static sint16 max_acceleration;
 
+	/// if true, fast forward ignores max_acceleration and frame pacing:
+	/// step() and sync_step() run back-to-back and the display is only refreshed at min_fps
+	static bool fast_forward_unthrottled;
+
+	/// quit unthrottled fast forward after this many seconds of real time (0 = no limit)
+	static uint32 fast_forward_time_limit;
+
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/// keep the converted images and the checksum of the pakset in a cache file in the user directory for a faster startup
+	static bool pak_cache;
+
+	/// citycars (only in single player games) and pedestrians outside the view move only every this many frames (1 = always)
+	static uint8 far_traffic_interval;
+
+	/// memory in MB for zoomed and player coloured image copies, least recently drawn ones are freed above it (0 = no limit)
+	static uint32 image_cache_budget;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
@@ -34,6 +34,7 @@ static pthread_mutex_t freelist_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // list of all allocated memory
 static nodelist_node_t *chunk_list = NULL;
+static size_t chunk_bytes = 0;
 
 /* this module keeps account of the free nodes of list and recycles them.
  * nodes of the same size will be kept in the same list
@@ -109,6 +110,7 @@ void *freelist_t::gimme_node(size_t size)
 	if(  *list == NULL  ) {
 		int num_elements = 32764/(int)size;
 		char* p = (char*)xmalloc(num_elements * size + sizeof(p));
+		chunk_bytes += num_elements * size + sizeof(p);
 
 #ifdef USE_VALGRIND_MEMCHECK
 		// tell valgrind that we still cannot access the pool p
@@ -233,9 +235,16 @@ void freelist_t::free_all_nodes()
 #endif
 		free( p );
 	}
+	chunk_bytes = 0;
 	printf("freelist_t::free_all_nodes(): zeroing\n");
 	for( int i=0;  i<NUM_LIST;  i++  ) {
 		all_lists[i] = NULL;
 	}
 	printf("freelist_t::free_all_nodes(): ok\n");
 }
+
+
+size_t freelist_t::get_chunk_bytes()
+{
+	return chunk_bytes;
+}
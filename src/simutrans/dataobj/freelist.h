@@ -22,6 +22,9 @@ public:
 
 	// clears all list memories
 	static void free_all_nodes();
+
+	// bytes held by all chunks
+	static size_t get_chunk_bytes();
 };
 
 #endif
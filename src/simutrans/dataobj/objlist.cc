@@ -1424,10 +1424,16 @@ void objlist_t::display_obj_overlay(const sint16 xpos, const sint16 ypos) const
 #endif
 
 
-void objlist_t::check_season(const bool calc_only_season_change)
+static bool has_tree_event(const obj_t *obj)
+{
+	return obj->get_typ() == obj_t::baum  &&  static_cast<const baum_t *>(obj)->has_season_event();
+}
+
+
+bool objlist_t::check_season(const bool calc_only_season_change, const bool defer_tree_events)
 {
 	if(  0 == top  ) {
-		return;
+		return false;
 	}
 
 	if(  capacity <= 1  ) {
@@ -1436,10 +1442,27 @@ void objlist_t::check_season(const bool calc_only_season_change)
 			dbg->fatal( "objlist_t::check_season()", "top not matching!" );
 		}
 		obj_t *check_obj = obj.one;
+		if(  defer_tree_events  &&  has_tree_event( check_obj )  ) {
+			return true;
+		}
 		if(  !check_obj->check_season( calc_only_season_change )  ) {
 			delete check_obj;
 		}
 	}
+	else if(  defer_tree_events  ) {
+		// only trees plant or die, so the list stays the same
+		bool deferred = false;
+		for(  uint8 i = 0;  i < top;  i++  ) {
+			obj_t *check_obj = obj.some[i];
+			if(  has_tree_event( check_obj )  ) {
+				deferred = true;
+			}
+			else {
+				check_obj->check_season( calc_only_season_change );
+			}
+		}
+		return deferred;
+	}
 	else {
 		// copy object pointers to check them
 		vector_tpl<obj_t*> list;
@@ -1457,4 +1480,23 @@ void objlist_t::check_season(const bool calc_only_season_change)
 		}
 
 	}
+	return false;
+}
+
+
+void objlist_t::check_season_tree_events(const bool calc_only_season_change)
+{
+	// planting new trees changes this list, so work on a copy
+	vector_tpl<obj_t*> list;
+	for(  uint8 i = 0;  i < top;  i++  ) {
+		obj_t *check_obj = bei(i);
+		if(  has_tree_event( check_obj )  ) {
+			list.append( check_obj );
+		}
+	}
+	for(  obj_t *check_obj : list  ) {
+		if(  !check_obj->check_season( calc_only_season_change )  ) {
+			delete check_obj;
+		}
+	}
 }
@@ -93,6 +93,9 @@ public:
 
 	inline uint8 get_top() const {return top;}
 
+	/// bytes allocated for the list itself (a single object is stored inline)
+	size_t get_memory() const { return capacity > 1 ? capacity * sizeof(obj_t *) : 0; }
+
 	/**
 	 * sorts the trees according to their offsets
 	 */
@@ -114,8 +117,16 @@ public:
 
 	/**
 	 * Called whenever the season or snowline height changes
+	 * @param defer_tree_events skip trees which plant new trees or die, then
+	 *        the list is not changed and tiles can be checked in parallel
+	 * @return true if trees were skipped
+	 */
+	bool check_season(const bool calc_only_season_change, const bool defer_tree_events = false);
+
+	/**
+	 * The trees skipped by check_season(), which plant new trees or die
 	 */
-	void check_season(const bool calc_only_season_change);
+	void check_season_tree_events(const bool calc_only_season_change);
 
 	/** display all things, faster, but will lead to clipping errors
 	 */
@@ -3,6 +3,15 @@
  * (see LICENSE.txt)
  */
 
+#include <string.h>
+#include <stdlib.h>
+
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #include "pakset_manager.h"
 
 #include "../utils/searchfolder.h"
@@ -11,6 +20,8 @@
 #include "../simskin.h"
 #include "../simloadingscreen.h"
 #include "../descriptor/ground_desc.h"
+#include "../descriptor/image.h"
+#include "../descriptor/obj_node_info.h"
 #include "../descriptor/reader/obj_reader.h"
 #include "../descriptor/vehicle_desc.h"
 #include "../utils/simstring.h"
@@ -20,6 +31,11 @@
 #include "../gui/simwin.h"
 #include "../dataobj/environment.h"
 #include "../network/pakset_info.h"
+#include "../simversion.h"
+
+#ifdef MULTI_THREAD
+#include "../utils/simthread.h"
+#endif
 
 
 pakset_manager_t::obj_map_t*                                  pakset_manager_t::registered_readers;
@@ -31,6 +47,518 @@ stringhashtable_tpl<missing_level_t>                          pakset_manager_t::
 std::string                                                   pakset_manager_t::overlaid_warning;
 
 
+/**
+ * A pak file in memory. It is mapped where possible, otherwise read in one go.
+ * The readers decode the descriptors directly from this memory.
+ */
+struct pak_file_t
+{
+	enum state_t : uint8 { PENDING, READY, FAILED };
+
+	const char *filename;
+	char *data;
+	size_t size;
+	bool mapped;
+	state_t state;
+
+	pak_file_t(const char *name = NULL) : filename(name), data(NULL), size(0), mapped(false), state(PENDING) {}
+
+	bool open()
+	{
+		FILE *const fp = dr_fopen( filename, "rb" );
+		if(  !fp  ) {
+			return false;
+		}
+		fseek( fp, 0, SEEK_END );
+		const long len = ftell( fp );
+		fseek( fp, 0, SEEK_SET );
+		if(  len <= 0  ) {
+			fclose( fp );
+			return false;
+		}
+		size = (size_t)len;
+
+#ifndef _WIN32
+		// private writable mapping, the readers must never see changes of the file
+		void *const map = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(fp), 0 );
+		if(  map != MAP_FAILED  ) {
+#ifdef POSIX_MADV_WILLNEED
+			posix_madvise( map, size, POSIX_MADV_WILLNEED );
+#endif
+			data = (char *)map;
+			mapped = true;
+			fclose( fp );
+			return true;
+		}
+#endif
+
+		data = (char *)malloc( size );
+		if(  !data  ||  fread( data, size, 1, fp ) != 1  ) {
+			free( data );
+			data = NULL;
+			fclose( fp );
+			return false;
+		}
+		fclose( fp );
+		return true;
+	}
+
+	void close()
+	{
+#ifndef _WIN32
+		if(  mapped  ) {
+			munmap( data, size );
+		}
+		else
+#endif
+		{
+			free( data );
+		}
+		data = NULL;
+		mapped = false;
+	}
+};
+
+
+/// start of an image node kept in the pak cache to recognise it
+#define PAK_CACHE_NODE_START (8)
+
+/**
+ * Optional cache of the work done while loading a pakset (pak_cache = 1 in simuconf.tab):
+ * the converted images of all image nodes in loading order and the pakset checksum.
+ * The pak files are still read, since the descriptors cannot be stored.
+ *
+ * For every directory the cache lists the names, sizes and times of the pak files. It is
+ * read in the same order as it was written; as soon as anything differs, the part read so
+ * far is copied into a new cache and the rest of the pakset is loaded as usual.
+ */
+class pak_cache_t
+{
+	enum record_t : uint8 { REC_FILES = 1, REC_IMAGE, REC_SAME, REC_BROKEN, REC_CHECKSUM };
+
+	/// identifies the node an image record belongs to
+	struct node_key_t
+	{
+		uint32 size;
+		char start[PAK_CACHE_NODE_START];
+	};
+
+	struct image_record_t
+	{
+		scr_coord_val x, y, w, h;
+		uint32 len;
+		uint8 zoomable;
+		uint8 colour_flags;
+	};
+
+	/// reads or writes the digest of a checksum from or to memory
+	struct digest_rdwr_t
+	{
+		bool saving;
+		uint8 *digest;
+
+		bool is_saving() const { return saving; }
+		void rdwr_byte(uint8 &b) { if(  saving  ) { *digest++ = b; } else { b = *digest++; } }
+	};
+
+	std::string filename;
+	std::string header;
+
+	// reading
+	pak_file_t file;
+	const char *pos;
+	vector_tpl<image_t *> read_images; ///< images of the image records read so far
+
+	// writing
+	FILE *out;
+	uint32 written_images;
+	vector_tpl<uint32> image_records; ///< image record (plus one) written for an image id
+
+	bool is_reading() const { return file.data != NULL; }
+
+	void clear()
+	{
+		read_images.clear();
+		image_records.clear();
+		written_images = 0;
+		pos = NULL;
+	}
+
+	bool can_read(size_t len) const { return (size_t)(file.data + file.size - pos) >= len; }
+
+	static node_key_t get_node_key(const obj_node_info_t &node, const char *data)
+	{
+		node_key_t key;
+		memset( &key, 0, sizeof(key) );
+		key.size = node.size;
+		memcpy( key.start, data, min( node.size, (uint32)PAK_CACHE_NODE_START ) );
+		return key;
+	}
+
+	/// folds the names and checksums of all objects, to be sure the pakset checksum in the cache belongs to them
+	static uint64 get_info_hash()
+	{
+		uint64 sum = 0;
+		for(auto const& i : pakset_info_t::get_info()) {
+			uint8 digest[20];
+			digest_rdwr_t rdwr = { true, digest };
+			i.value->rdwr( &rdwr );
+
+			uint64 hash = 14695981039346656037ull;
+			for(  const char *c = i.key;  *c;  c++  ) {
+				hash = (hash ^ (uint8)*c) * 1099511628211ull;
+			}
+			for(  int n = 0;  n < 20;  n++  ) {
+				hash = (hash ^ digest[n]) * 1099511628211ull;
+			}
+			// independent of the order of the hashtable
+			sum += hash;
+		}
+		return sum;
+	}
+
+	void write(const void *data, size_t len)
+	{
+		if(  out  &&  fwrite( data, len, 1, out ) != 1  ) {
+			dbg->warning( "pak_cache_t::write()", "Cannot write %s", (filename + ".tmp").c_str() );
+			abort();
+		}
+	}
+
+	void set_image_record(const image_t *image, uint32 record)
+	{
+		if(  image->len != 0  &&  image->imageid != IMG_EMPTY  ) {
+			while(  image_records.get_count() <= image->imageid  ) {
+				image_records.append( 0 );
+			}
+			image_records[image->imageid] = record + 1;
+		}
+	}
+
+	/// stops reading and writes a new cache, starting with the part that was still valid
+	void start_writing()
+	{
+		out = dr_fopen( (filename + ".tmp").c_str(), "wb" );
+		if(  is_reading()  ) {
+			dbg->message( "pak_cache_t::start_writing()", "Pak cache %s is outdated after %u images", filename.c_str(), read_images.get_count() );
+			write( file.data, pos - file.data );
+			for(  uint32 i = 0;  i < read_images.get_count();  i++  ) {
+				set_image_record( read_images[i], i );
+			}
+			written_images = read_images.get_count();
+			file.close();
+		}
+		else {
+			const uint32 count = 0; // known at the end
+			write( header.data(), header.size() );
+			write( &count, sizeof(count) );
+		}
+	}
+
+public:
+	pak_cache_t() : pos(NULL), out(NULL), written_images(0) {}
+
+	void open(const std::string &pak_dir)
+	{
+		uint32 hash = 5381;
+		for(  size_t i = 0;  i < pak_dir.size();  i++  ) {
+			hash = hash*33 + (uint8)pak_dir[i];
+		}
+		char name[32];
+		sprintf( name, "pakcache-%08x.bin", hash );
+		filename = std::string(env_t::user_dir) + name;
+
+		// the records are stored as they are in memory
+		const uint32 byte_order = 0x01020304;
+		const uint8 sizes[3] = { (uint8)sizeof(PIXVAL), (uint8)sizeof(scr_coord_val), (uint8)COLOUR_DEPTH };
+		header = "Simutrans pak cache\n" SIM_TITLE " " VERSION_DATE "\n";
+		header.append( (const char *)&byte_order, sizeof(byte_order) );
+		header.append( (const char *)sizes, sizeof(sizes) );
+
+		file.filename = filename.c_str();
+		if(  file.open()  ) {
+			uint32 count;
+			if(  file.size >= header.size() + sizeof(count)  &&  memcmp( file.data, header.data(), header.size() ) == 0  ) {
+				pos = file.data + header.size();
+				memcpy( &count, pos, sizeof(count) );
+				pos += sizeof(count);
+				display_reserve_images( count );
+				return;
+			}
+			file.close();
+		}
+		start_writing();
+	}
+
+	/// checks the pak files of a directory against the cache, before any of them is loaded
+	void add_files(const searchfolder_t &find)
+	{
+		if(  !is_reading()  &&  !out  ) {
+			return;
+		}
+
+		std::string files;
+		files.push_back( (char)REC_FILES );
+		const uint32 count = find.end() - find.begin();
+		files.append( (const char *)&count, sizeof(count) );
+		for(const char *pak_filename : find) {
+			struct stat st;
+			if(  dr_stat( pak_filename, &st ) != 0  ) {
+				abort();
+				return;
+			}
+			const uint64 size = st.st_size;
+			const sint64 mtime = st.st_mtime;
+			files.append( pak_filename );
+			files.push_back( 0 );
+			files.append( (const char *)&size, sizeof(size) );
+			files.append( (const char *)&mtime, sizeof(mtime) );
+		}
+
+		if(  is_reading()  ) {
+			if(  can_read( files.size() )  &&  memcmp( pos, files.data(), files.size() ) == 0  ) {
+				pos += files.size();
+				return;
+			}
+			start_writing();
+		}
+		write( files.data(), files.size() );
+	}
+
+	/// @returns false if the image of this node is not in the cache
+	bool read_image(const obj_node_info_t &node, const char *data, image_t *&image)
+	{
+		if(  !is_reading()  ) {
+			return false;
+		}
+
+		const node_key_t key = get_node_key( node, data );
+		if(  !can_read( 1 + sizeof(key) )  ||  memcmp( pos + 1, &key, sizeof(key) ) != 0  ) {
+			start_writing();
+			return false;
+		}
+		const char *p = pos + 1 + sizeof(key);
+
+		switch(  (uint8)*pos  ) {
+			case REC_BROKEN:
+				image = NULL;
+				break;
+
+			case REC_SAME: {
+				uint32 record;
+				if(  !can_read( p - pos + sizeof(record) )  ) {
+					start_writing();
+					return false;
+				}
+				memcpy( &record, p, sizeof(record) );
+				p += sizeof(record);
+				if(  record >= read_images.get_count()  ) {
+					start_writing();
+					return false;
+				}
+				image = read_images[record];
+				break;
+			}
+
+			case REC_IMAGE: {
+				image_record_t rec;
+				if(  !can_read( p - pos + sizeof(rec) )  ) {
+					start_writing();
+					return false;
+				}
+				memcpy( &rec, p, sizeof(rec) );
+				p += sizeof(rec);
+				if(  !can_read( p - pos + rec.len * sizeof(PIXVAL) )  ) {
+					start_writing();
+					return false;
+				}
+				image = new image_t();
+				image->alloc( rec.len );
+				image->x = rec.x;
+				image->y = rec.y;
+				image->w = rec.w;
+				image->h = rec.h;
+				image->zoomable = rec.zoomable;
+				image->imageid = IMG_EMPTY;
+				memcpy( image->data, p, rec.len * sizeof(PIXVAL) );
+				p += rec.len * sizeof(PIXVAL);
+				if(  image->len != 0  ) {
+					// already converted and checked, and the player colours are known
+					register_image( image, rec.colour_flags );
+				}
+				read_images.append( image );
+				break;
+			}
+
+			default:
+				start_writing();
+				return false;
+		}
+
+		pos = p;
+		return true;
+	}
+
+	/// stores the image read from this node (NULL for a broken node) in a new cache
+	void write_image(const obj_node_info_t &node, const char *data, const image_t *image)
+	{
+		if(  !out  ) {
+			return;
+		}
+
+		const node_key_t key = get_node_key( node, data );
+		const uint32 record = image  &&  image->imageid != IMG_EMPTY  &&  image->imageid < image_records.get_count() ? image_records[image->imageid] : 0;
+		const uint8 type = !image ? REC_BROKEN : record ? REC_SAME : REC_IMAGE;
+		write( &type, sizeof(type) );
+		write( &key, sizeof(key) );
+
+		if(  type == REC_SAME  ) {
+			// the image was found to be the same as an earlier one
+			const uint32 same = record - 1;
+			write( &same, sizeof(same) );
+		}
+		else if(  type == REC_IMAGE  ) {
+			image_record_t rec;
+			memset( &rec, 0, sizeof(rec) );
+			rec.x = image->x;
+			rec.y = image->y;
+			rec.w = image->w;
+			rec.h = image->h;
+			rec.len = image->len;
+			rec.zoomable = image->zoomable;
+			rec.colour_flags = image->len != 0 ? get_image_colour_flags( image->imageid ) : 0;
+			write( &rec, sizeof(rec) );
+			write( image->data, image->len * sizeof(PIXVAL) );
+			set_image_record( image, written_images++ );
+		}
+	}
+
+	/// @returns true if the pakset checksum was taken from the cache
+	bool read_checksum()
+	{
+		if(  !is_reading()  ) {
+			return false;
+		}
+
+		const uint64 info_hash = get_info_hash();
+		uint8 digest[20];
+		if(  can_read( 1 + sizeof(info_hash) + sizeof(digest) )  &&  *pos == REC_CHECKSUM  &&  memcmp( pos + 1, &info_hash, sizeof(info_hash) ) == 0  ) {
+			memcpy( digest, pos + 1 + sizeof(info_hash), sizeof(digest) );
+			digest_rdwr_t rdwr = { false, digest };
+			pakset_info_t::get_checksum()->rdwr( &rdwr );
+			pos += 1 + sizeof(info_hash) + sizeof(digest);
+			return true;
+		}
+		start_writing();
+		return false;
+	}
+
+	void write_checksum()
+	{
+		if(  !out  ) {
+			return;
+		}
+
+		const uint8 type = REC_CHECKSUM;
+		const uint64 info_hash = get_info_hash();
+		uint8 digest[20];
+		digest_rdwr_t rdwr = { true, digest };
+		pakset_info_t::get_checksum()->rdwr( &rdwr );
+		write( &type, sizeof(type) );
+		write( &info_hash, sizeof(info_hash) );
+		write( digest, sizeof(digest) );
+	}
+
+	void close()
+	{
+		if(  is_reading()  ) {
+			dbg->message( "pak_cache_t::close()", "Took %u images from %s", read_images.get_count(), filename.c_str() );
+			file.close();
+		}
+		if(  out  ) {
+			// to reserve the image table at once next time
+			const uint32 count = get_image_count();
+			if(  fseek( out, header.size(), SEEK_SET ) == 0  ) {
+				write( &count, sizeof(count) );
+			}
+		}
+		if(  out  ) {
+			// only now replace the old one
+			fclose( out );
+			out = NULL;
+			dr_remove( filename.c_str() );
+			if(  dr_rename( (filename + ".tmp").c_str(), filename.c_str() ) == 0  ) {
+				dbg->message( "pak_cache_t::close()", "Wrote pak cache %s", filename.c_str() );
+			}
+		}
+		clear();
+	}
+
+	/// gives up on the cache, without writing a new one
+	void abort()
+	{
+		if(  is_reading()  ) {
+			file.close();
+		}
+		if(  out  ) {
+			fclose( out );
+			out = NULL;
+			dr_remove( (filename + ".tmp").c_str() );
+		}
+		clear();
+	}
+};
+
+
+/// only open while load_pakset() runs
+static pak_cache_t pak_cache;
+
+
+#ifdef MULTI_THREAD
+/// number of pak files that may be opened ahead of the one being decoded
+#define PAK_PREFETCH_WINDOW (32)
+
+/**
+ * Worker threads open the pak files ahead of the main thread, which decodes
+ * and registers them strictly in order.
+ */
+struct pak_prefetch_t
+{
+	pak_file_t *files;
+	uint32 count;
+	uint32 next;     ///< next file to be opened
+	uint32 decoded;  ///< files already decoded by the main thread
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+};
+
+
+static void *pak_prefetch_thread(void *ptr)
+{
+	pak_prefetch_t *const pf = (pak_prefetch_t *)ptr;
+
+	pthread_mutex_lock( &pf->mutex );
+	while(  pf->next < pf->count  ) {
+		if(  pf->next >= pf->decoded + PAK_PREFETCH_WINDOW  ) {
+			// do not use too much memory
+			pthread_cond_wait( &pf->cond, &pf->mutex );
+			continue;
+		}
+		pak_file_t &pak = pf->files[ pf->next++ ];
+		pthread_mutex_unlock( &pf->mutex );
+
+		const bool ok = pak.open();
+
+		pthread_mutex_lock( &pf->mutex );
+		pak.state = ok ? pak_file_t::READY : pak_file_t::FAILED;
+		pthread_cond_broadcast( &pf->cond );
+	}
+	pthread_mutex_unlock( &pf->mutex );
+	return NULL;
+}
+#endif
+
+
 void pakset_manager_t::register_reader(obj_reader_t *reader)
 {
 	if(!registered_readers) {
@@ -51,6 +579,11 @@ const char* pakset_manager_t::get_doubled_warning_message()
 void pakset_manager_t::load_pakset(bool load_addons)
 {
 	dbg->message("pakset_manager_t::load_pakset", "Reading object data from %s...", env_t::pak_dir.c_str());
+	const uint32 start_time = dr_time();
+
+	if(  env_t::pak_cache  ) {
+		pak_cache.open( env_t::pak_dir );
+	}
 
 	if (!load_paks_from_directory( env_t::pak_dir.c_str(), load_addons, translator::translate("Loading paks ...") )) {
 		dbg->fatal("pakset_manager_t::load_pakset", "Failed to load pakset. Please re-download or select another pakset.");
@@ -85,7 +618,13 @@ void pakset_manager_t::load_pakset(bool load_addons)
 		dbg->fatal("pakset_manager_t::load_pakset", "Failed to load pakset. Please re-download or select another pakset.");
 	}
 
-	pakset_info_t::calculate_checksum();
+	if(  !pak_cache.read_checksum()  ) {
+		pakset_info_t::calculate_checksum();
+		pak_cache.write_checksum();
+	}
+	pak_cache.close();
+
+	dbg->message("pakset_manager_t::load_pakset", "Loaded pakset in %u ms", dr_time() - start_time);
 
 	if(  env_t::verbose_debug >= log_t::LEVEL_DEBUG  ) {
 		pakset_info_t::debug();
@@ -111,6 +650,7 @@ bool pakset_manager_t::load_paks_from_directory(const std::string &path, bool lo
 	searchfolder_t find;
 	const searchfolder_t::search_flags_t addon_flags = load_addons ? searchfolder_t::SF_NONE : searchfolder_t::SF_NOADDONS;
 	const sint32 max = find.search(path, "pak", addon_flags | searchfolder_t::SF_PREPEND_PATH, 4);
+	pak_cache.add_files( find );
 	sint32 step = -7;
 
 	for(  sint32 bit = 1;  bit < max;  bit += bit  ) {
@@ -146,17 +686,87 @@ bool pakset_manager_t::load_paks_from_directory(const std::string &path, bool lo
 
 DBG_MESSAGE("pakset_manager_t::load_paks_from_directory", "Reading from '%s'", path.c_str());
 
-	uint n = 0;
+	vector_tpl<pak_file_t> paks(max);
 	for (char* const& pak_filename : find) {
-		if (!load_pak_file(pak_filename)) {
-			dbg->warning("pakset_manager_t::load_paks_from_directory", "Cannot load '%s', some objects might be unavailable!", pak_filename);
+		paks.append( pak_file_t(pak_filename) );
+	}
+
+#ifdef MULTI_THREAD
+	// open the files in parallel, which hides the latency of slow file systems
+	pak_prefetch_t prefetch;
+	prefetch.files = paks.begin();
+	prefetch.count = paks.get_count();
+	prefetch.next = 0;
+	prefetch.decoded = 0;
+	pthread_mutex_init( &prefetch.mutex, NULL );
+	pthread_cond_init( &prefetch.cond, NULL );
+
+	// at least two, since the threads mostly wait for the file system
+	const int num_workers = env_t::num_threads < 2 ? 2 : env_t::num_threads;
+	pthread_t workers[MAX_THREADS];
+	int spawned = 0;
+	while(  spawned < num_workers  &&  pthread_create( &workers[spawned], NULL, pak_prefetch_thread, &prefetch ) == 0  ) {
+		spawned++;
+	}
+	if(  spawned == 0  ) {
+		// then open them all here
+		prefetch.next = prefetch.count;
+	}
+#endif
+
+	// decoding and registering stays in order, so the objects and the pakset checksum do not change
+	for(  uint32 n = 0;  n < paks.get_count();  n++  ) {
+		pak_file_t &pak = paks[n];
+		bool ok;
+#ifdef MULTI_THREAD
+		if(  spawned > 0  ) {
+			pthread_mutex_lock( &prefetch.mutex );
+			while(  pak.state == pak_file_t::PENDING  ) {
+				pthread_cond_wait( &prefetch.cond, &prefetch.mutex );
+			}
+			pthread_mutex_unlock( &prefetch.mutex );
+			ok = pak.state == pak_file_t::READY;
+		}
+		else
+#endif
+		{
+			ok = pak.open();
+		}
+
+		if (ok) {
+			DBG_DEBUG("pakset_manager_t::load_paks_from_directory", "filename='%s'", pak.filename);
+			ok = read_pak(pak.filename, pak.data, pak.size);
+			pak.close();
+		}
+		else {
+			dbg->error("pakset_manager_t::load_paks_from_directory", "Reading '%s' failed!", pak.filename);
+		}
+		if (!ok) {
+			dbg->warning("pakset_manager_t::load_paks_from_directory", "Cannot load '%s', some objects might be unavailable!", pak.filename);
+		}
+
+#ifdef MULTI_THREAD
+		if(  spawned > 0  ) {
+			pthread_mutex_lock( &prefetch.mutex );
+			prefetch.decoded = n+1;
+			pthread_cond_broadcast( &prefetch.cond );
+			pthread_mutex_unlock( &prefetch.mutex );
 		}
+#endif
 
-		if ((n++ & step) == 0 && drawing) {
-			ls.set_progress(n);
+		if ((n & step) == 0 && drawing) {
+			ls.set_progress(n+1);
 		}
 	}
 
+#ifdef MULTI_THREAD
+	for(  int t = 0;  t < spawned;  t++  ) {
+		pthread_join( workers[t], NULL );
+	}
+	pthread_cond_destroy( &prefetch.cond );
+	pthread_mutex_destroy( &prefetch.mutex );
+#endif
+
 	ls.set_progress(max);
 	return find.begin()!=find.end();
 }
@@ -167,58 +777,65 @@ bool pakset_manager_t::load_pak_file(const std::string &filename)
 	// added trace
 	DBG_DEBUG("pakset_manager_t::load_pak_file", "filename='%s'", filename.c_str());
 
-	FILE* const fp = dr_fopen(filename.c_str(), "rb");
-	if (!fp) {
+	pak_file_t pak(filename.c_str());
+	if (!pak.open()) {
 		dbg->error("pakset_manager_t::load_pak_file", "Reading '%s' failed!", filename.c_str());
 		return false;
 	}
 
-	// This is the normal header reading code
-	int c;
-	uint32 n = 0;
+	const bool ok = read_pak(filename.c_str(), pak.data, pak.size);
+	pak.close();
+	return ok;
+}
+
 
-	do {
-		c = fgetc(fp);
-		n ++;
-	} while(c != EOF && c != 0x1a);
+bool pakset_manager_t::read_pak(const char *filename, char *data, size_t size)
+{
+	const char *const end = data + size;
 
-	if(c == EOF) {
-		dbg->error("pakset_manager_t::load_pak_file", "Unexpected end of file after %u bytes while reading '%s'!", n, filename.c_str());
-		fclose(fp);
+	// This is the normal header reading code
+	char *p = (char *)memchr(data, 0x1a, size);
+	if (!p) {
+		dbg->error("pakset_manager_t::read_pak", "Unexpected end of file after %u bytes while reading '%s'!", (uint32)size, filename);
 		return false;
 	}
+	p++;
 
 	// Compiled Version
-	char dummy[4];
-	n = fread(dummy, 4, 1, fp);
-	if (n != 1) {
-		fclose(fp);
+	if (end - p < 4) {
 		return false;
 	}
-
-	char *p = dummy;
 	const uint32 version = decode_uint32(p);
 
-	DBG_DEBUG("pakset_manager_t::load_pak_file", "Read %u blocks, file version is %x", n, version);
+	DBG_DEBUG("pakset_manager_t::read_pak", "Header of %u bytes, file version is %x", (uint32)(p - data), version);
 
 	if(version <= COMPILER_VERSION_CODE) {
-		obj_desc_t *data = NULL;
-		if (!read_nodes(fp, data, 0, version)) {
-			fclose(fp);
+		obj_desc_t *desc = NULL;
+		if (!read_nodes(p, end, desc, 0, version)) {
 			return false;
 		}
 	}
 	else {
-		DBG_DEBUG("pakset_manager_t::load_pak_file", "Version of '%s' is too old, %u instead of %u", filename.c_str(), version, COMPILER_VERSION_CODE );
-		fclose(fp);
+		DBG_DEBUG("pakset_manager_t::read_pak", "Version of '%s' is too old, %u instead of %u", filename, version, COMPILER_VERSION_CODE );
 		return false;
 	}
 
-	fclose(fp);
 	return true;
 }
 
 
+bool pakset_manager_t::read_cached_image(const obj_node_info_t &node, const char *data, image_t *&image)
+{
+	return pak_cache.read_image( node, data, image );
+}
+
+
+void pakset_manager_t::cache_image(const obj_node_info_t &node, const char *data, const image_t *image)
+{
+	pak_cache.write_image( node, data, image );
+}
+
+
 /*
  * Do the last loading procedures
  * Resolve all xrefs
@@ -314,34 +931,33 @@ void pakset_manager_t::warn_if_paks_missing()
 }
 
 
-static bool read_node_info(obj_node_info_t& node, FILE* const f, uint32 const version)
+static bool read_node_info(obj_node_info_t& node, char *&pos, const char *end, uint32 const version)
 {
-	char data[EXT_OBJ_NODE_INFO_SIZE];
-	if (fread(data, OBJ_NODE_INFO_SIZE, 1, f) != 1) {
+	if (end - pos < OBJ_NODE_INFO_SIZE) {
 		return false;
 	}
 
-	char *p = data;
-	node.type      = decode_uint32(p);
-	node.nchildren = decode_uint16(p);
-	node.size      = decode_uint16(p);
+	node.type      = decode_uint32(pos);
+	node.nchildren = decode_uint16(pos);
+	node.size      = decode_uint16(pos);
 
 	// can have larger records
 	if (version != COMPILER_VERSION_CODE_11 && node.size == LARGE_RECORD_SIZE) {
-		if (fread(p, sizeof(data) - OBJ_NODE_INFO_SIZE, 1, f) != 1) {
+		if (end - pos < EXT_OBJ_NODE_INFO_SIZE - OBJ_NODE_INFO_SIZE) {
 			return false;
 		}
-		node.size = decode_uint32(p);
+		node.size = decode_uint32(pos);
 	}
 
-	return true;
+	// the data must be completely inside the file
+	return (size_t)(end - pos) >= node.size;
 }
 
 
-bool pakset_manager_t::read_nodes(FILE *fp, obj_desc_t *&data, int node_depth, uint32 version)
+bool pakset_manager_t::read_nodes(char *&pos, const char *end, obj_desc_t *&data, int node_depth, uint32 version)
 {
 	obj_node_info_t node;
-	if (!read_node_info(node, fp, version)) {
+	if (!read_node_info(node, pos, end, version)) {
 		return false;
 	}
 
@@ -349,7 +965,8 @@ bool pakset_manager_t::read_nodes(FILE *fp, obj_desc_t *&data, int node_depth, u
 
 	if(reader) {
 //dbg->debug("pakset_manager_t::read_nodes", "Reading %.4s-node of length %d with '%s'", reinterpret_cast<const char *>(&node.type), node.size, reader->get_type_name());
-		data = reader->read_node(fp, node);
+		data = reader->read_node(pos, node);
+		pos += node.size;
 
 		if (!data) {
 			return false;
@@ -359,7 +976,7 @@ bool pakset_manager_t::read_nodes(FILE *fp, obj_desc_t *&data, int node_depth, u
 			data->children = new obj_desc_t *[node.nchildren];
 
 			for (int i = 0; i < node.nchildren; i++) {
-				if (!read_nodes(fp, data->children[i], node_depth + 1, version)) {
+				if (!read_nodes(pos, end, data->children[i], node_depth + 1, version)) {
 					// Note: cannot delete siblings of data->children[i], since equal images point to the same desc
 					delete data; // data->children is delete[]'d by the destructor
 					data = NULL;
@@ -377,12 +994,10 @@ bool pakset_manager_t::read_nodes(FILE *fp, obj_desc_t *&data, int node_depth, u
 	else {
 		// no reader found ...
 		dbg->warning("pakset_manager_t::read_nodes", "Skipping unknown %.4s-node\n", reinterpret_cast<const char *>(&node.type));
-		if (fseek(fp, node.size, SEEK_CUR) != 0) {
-			return false;
-		}
+		pos += node.size;
 
 		for(int i = 0; i < node.nchildren; i++) {
-			if (!skip_nodes(fp,version)) {
+			if (!skip_nodes(pos, end, version)) {
 				return false;
 			}
 		}
@@ -394,19 +1009,17 @@ bool pakset_manager_t::read_nodes(FILE *fp, obj_desc_t *&data, int node_depth, u
 }
 
 
-bool pakset_manager_t::skip_nodes(FILE *fp,uint32 version)
+bool pakset_manager_t::skip_nodes(char *&pos, const char *end, uint32 version)
 {
 	obj_node_info_t node;
-	if (!read_node_info(node, fp, version)) {
+	if (!read_node_info(node, pos, end, version)) {
 		return false;
 	}
 
-	if (fseek(fp, node.size, SEEK_CUR) != 0) {
-		return false;
-	}
+	pos += node.size;
 
 	for(int i = 0; i < node.nchildren; i++) {
-		if (!skip_nodes(fp,version)) {
+		if (!skip_nodes(pos, end, version)) {
 			return false;
 		}
 	}
@@ -15,6 +15,8 @@
 
 class obj_desc_t;
 class obj_reader_t;
+class image_t;
+struct obj_node_info_t;
 
 
 /// Missing things during loading:
@@ -49,12 +51,16 @@ class pakset_manager_t
 	static ptrhashtable_tpl<obj_desc_t **, int> fatals;
 
 	/// Read a descriptor node.
-	/// @param fp File to read from
+	/// @param pos Position of the node in the pak file in memory, advanced past the node and its children
+	/// @param end End of the pak file in memory
 	/// @param[out] data If reading is successful, contains descriptor for the object, else NULL.
 	/// @param register_nodes Nesting level for desc-nodes, should normally be 0
 	/// @param version File format version
-	static bool read_nodes(FILE *fp, obj_desc_t *&data, int register_nodes, uint32 version);
-	static bool skip_nodes(FILE *fp, uint32 version);
+	static bool read_nodes(char *&pos, const char *end, obj_desc_t *&data, int register_nodes, uint32 version);
+	static bool skip_nodes(char *&pos, const char *end, uint32 version);
+
+	/// Decodes and registers all objects of a pak file in memory
+	static bool read_pak(const char *filename, char *data, size_t size);
 
 	static std::string doublettes;
 	static std::string overlaid_warning;
@@ -69,6 +75,13 @@ public:
 	/// Only for single files, must take care of all the cleanup/registering matrix themselves
 	static bool load_pak_file(const std::string &filename);
 
+	/// Converted image of an image node from the pak cache (pak_cache in simuconf.tab)
+	/// @returns false if the node is not in the cache, else @p image is the image or NULL for a broken node
+	static bool read_cached_image(const obj_node_info_t &node, const char *data, image_t *&image);
+
+	/// Keeps the image read from an image node (NULL for a broken node) for the next start, if a pak cache is written
+	static void cache_image(const obj_node_info_t &node, const char *data, const image_t *image);
+
 	/// special error handling for double objects
 	static void doubled(const char *what, const char *name);
 
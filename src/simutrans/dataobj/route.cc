@@ -18,6 +18,7 @@
 #include "route.h"
 #include "environment.h"
 
+#include "../utils/profiler.h"
 #include"../utils/simrandom.h"
 
 // define USE_VALGRIND_MEMCHECK to make
@@ -38,33 +39,197 @@
 #endif
 
 
+// N, E, S, W and the diagonals NE, SE, SW, NW
+const sint8 route_t::step_dx[8] = {  0, 1, 0, -1,  1, 1, -1, -1 };
+const sint8 route_t::step_dy[8] = { -1, 0, 1,  0, -1, 1,  1, -1 };
+
+uint32 route_t::next_serial = 0;
+
+
+void route_t::append(koord3d k)
+{
+	if(  count == 0  ) {
+		checkpoint_t cp;
+		cp.pos = k;
+		cp.offset = 0;
+		checkpoints.append( cp );
+	}
+	else {
+		const sint16 dx = k.x - last.x;
+		const sint16 dy = k.y - last.y;
+		const sint16 dz = k.z - last.z;
+		uint8 dir = 8;
+		for(  uint8 d = 0;  d < 8;  d++  ) {
+			if(  step_dx[d] == dx  &&  step_dy[d] == dy  ) {
+				dir = d;
+				break;
+			}
+		}
+		if(  dir < 8  &&  -8 <= dz  &&  dz <= 7  ) {
+			steps.append( (uint8)(dir | ((dz + 8) << 3)) );
+		}
+		else {
+			steps.append( STEP_ESCAPE );
+			steps.append( (uint8)k.x );
+			steps.append( (uint8)((uint16)k.x >> 8) );
+			steps.append( (uint8)k.y );
+			steps.append( (uint8)((uint16)k.y >> 8) );
+			steps.append( (uint8)k.z );
+		}
+
+		if(  (count & (CHECKPOINT_STEPS-1)) == 0  ) {
+			checkpoint_t cp;
+			cp.pos = k;
+			cp.offset = steps.get_count();
+			checkpoints.append( cp );
+		}
+	}
+	last = k;
+	count++;
+	changed();
+}
+
+
+void route_t::clear()
+{
+	steps.clear();
+	checkpoints.clear();
+	count = 0;
+	last = koord3d::invalid;
+	changed();
+}
+
+
+void route_t::truncate(uint32 n)
+{
+	if(  n >= count  ) {
+		return;
+	}
+	if(  n == 0  ) {
+		clear();
+		return;
+	}
+
+	// decode up to the new last tile
+	const uint32 i = n - 1;
+	const checkpoint_t &cp = checkpoints[i >> CHECKPOINT_SHIFT];
+	koord3d pos = cp.pos;
+	const uint8 *p = steps.begin() + cp.offset;
+	for(  uint32 j = i & (CHECKPOINT_STEPS-1);  j > 0;  j--  ) {
+		decode_step( p, pos );
+	}
+
+	const uint32 new_steps = (uint32)(p - steps.begin());
+	while(  steps.get_count() > new_steps  ) {
+		steps.pop_back();
+	}
+	while(  checkpoints.get_count() > (i >> CHECKPOINT_SHIFT) + 1  ) {
+		checkpoints.pop_back();
+	}
+	last = pos;
+	count = n;
+	changed();
+}
+
+
+void route_t::set_tiles(const koord3d_vector_t &tiles)
+{
+	clear();
+	for(  koord3d const& k : tiles  ) {
+		append( k );
+	}
+}
+
+
+void route_t::get_tiles(koord3d_vector_t &tiles) const
+{
+	tiles.clear();
+	if(  count == 0  ) {
+		return;
+	}
+	tiles.reserve( count );
+	koord3d pos = front();
+	const uint8 *p = steps.begin();
+	tiles.append( pos );
+	for(  uint32 i = 1;  i < count;  i++  ) {
+		decode_step( p, pos );
+		tiles.append( pos );
+	}
+}
+
+
+uint32 route_t::index_of(const koord3d &k) const
+{
+	if(  count == 0  ) {
+		return 0xFFFFFFFFu;
+	}
+	koord3d pos = front();
+	const uint8 *p = steps.begin();
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		if(  i > 0  ) {
+			decode_step( p, pos );
+		}
+		if(  pos == k  ) {
+			return i;
+		}
+	}
+	return 0xFFFFFFFFu;
+}
+
+
+ribi_t::ribi route_t::get_ribi(uint32 n) const
+{
+	ribi_t::ribi ribi = ribi_t::none;
+	const koord3d pos = at(n);
+	if(  n > 0  ) {
+		ribi |= ribi_type( at(n-1) - pos );
+	}
+	if(  n+1 < count  ) {
+		ribi |= ribi_type( at(n+1) - pos );
+	}
+	return ribi;
+}
+
+
+void route_t::rotate90( sint16 y_size )
+{
+	koord3d_vector_t tiles;
+	get_tiles( tiles );
+	tiles.rotate90( y_size );
+	set_tiles( tiles );
+}
+
+
 void route_t::append(const route_t *r)
 {
 	assert(r != NULL);
-	const uint32 hops = r->get_count()-1;
-	route.reserve(hops+1+route.get_count());
 
-	while (!route.empty() && back() == r->front()) {
+	while (count > 0 && back() == r->front()) {
 		// skip identical end tiles
-		route.pop_back();
+		truncate( count-1 );
 	}
 	// then append
-	for( unsigned int i=0;  i<=hops;  i++ ) {
-		route.append(r->at(i));
+	koord3d pos = r->front();
+	const uint8 *p = r->steps.begin();
+	append( pos );
+	for(  uint32 i = 1;  i < r->count;  i++  ) {
+		decode_step( p, pos );
+		append( pos );
 	}
 }
 
 
 void route_t::insert(koord3d k)
 {
-	route.insert_at(0,k);
+	koord3d_vector_t tiles;
+	get_tiles( tiles );
+	tiles.insert_at( 0, k );
+	set_tiles( tiles );
 }
 
 
 void route_t::remove_koord_from(uint32 i) {
-	while(  i+1 < get_count()  ) {
-		route.pop_back();
-	}
+	truncate( i+1 );
 }
 
 
@@ -83,7 +248,6 @@ bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 
 	// then try to calculate direct route
 	koord pos = back().get_2d();
-	route.reserve( route.get_count()+koord_distance(pos,ziel)+2 );
 	DBG_MESSAGE("route_t::append_straight_route()","start from (%i,%i) to (%i,%i)",pos.x,pos.y,dest.x,dest.y);
 	while(pos!=ziel) {
 		// shortest way
@@ -96,7 +260,7 @@ bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 		if(!welt->is_within_limits(pos)) {
 			break;
 		}
-		route.append(welt->lookup_kartenboden(pos)->get_pos());
+		append(welt->lookup_kartenboden(pos)->get_pos());
 	}
 	DBG_MESSAGE("route_t::append_straight_route()","to (%i,%i) found.",ziel.x,ziel.y);
 
@@ -107,6 +271,8 @@ bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 
 // node arrays
 route_t::ANode* route_t::nodes=NULL;
+// tiles of the route found by the last search (only one search at a time, see GET_NODE())
+static koord3d_vector_t search_tiles;
 uint32 route_t::MAX_STEP=0;
 #ifdef DEBUG
 bool route_t::node_in_use=false;
@@ -117,6 +283,8 @@ bool route_t::node_in_use=false;
  */
 bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 max_depth )
 {
+	profiler_t::count( profiler_t::CNT_ROUTE_SEARCH );
+
 	bool ok = false;
 
 	// check for existing koordinates
@@ -137,7 +305,7 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 	INT_CHECK("route 347");
 
 	// we clear it here probably twice: does not hurt ...
-	route.clear();
+	clear();
 
 	// first tile is not valid?!?
 	if(  !tdriver->check_next_tile(g)  ) {
@@ -254,12 +422,14 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 	}
 	else {
 		// reached => construct route
-		route.store_at( tmp->count, tmp->gr->get_pos() );
+		search_tiles.clear();
+		search_tiles.store_at( tmp->count, tmp->gr->get_pos() );
 		while(tmp != NULL) {
-			route[ tmp->count ] = tmp->gr->get_pos();
+			search_tiles[ tmp->count ] = tmp->gr->get_pos();
 			tmp = tmp->parent;
 		}
-		ok = !route.empty();
+		set_tiles( search_tiles );
+		ok = !search_tiles.empty();
 	}
 
 	RELEASE_NODE();
@@ -289,6 +459,7 @@ ribi_t::ribi *get_next_dirs(const koord3d& gr_pos, const koord3d& ziel)
 bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_speed, const uint32 max_cost)
 {
 	assert((get_random_mode() & SYNC_STEP_RANDOM) == 0);
+	profiler_t::count( profiler_t::CNT_ROUTE_SEARCH );
 
 	bool ok = false;
 
@@ -299,7 +470,7 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 	}
 
 	// we clear it here probably twice: does not hurt ...
-	route.clear();
+	clear();
 
 	// first tile is not valid?!?
 	if(  !tdriver->check_next_tile(gr)  ) {
@@ -310,6 +481,8 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 	const waytype_t wegtyp = tdriver->get_waytype();
 	const bool is_airplane = tdriver->get_waytype()==air_wt;
 	const uint32 cost_upslope = tdriver->get_cost_upslope();
+	// tiles without such a way can be skipped using the tile summary (0: always look at the grounds)
+	const uint8 way_bit = is_airplane ? 0 : surface_t::get_way_bit(wegtyp);
 
 	/* On water we will try jump point search (jps):
 	 * - If going straight do not turn, only if near an obstacle.
@@ -411,6 +584,13 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 			if(is_airplane) {
 				to = welt->lookup_kartenboden(gr->get_pos().get_2d()+koord(next_ribi[r]));
 			}
+			else if(  way_bit  ) {
+				// no way there and no bridge or tunnel => get_neighbour() would fail anyway
+				const surface_t::tile_summary_t *ts = welt->get_tile_summary(gr->get_pos().get_2d()+koord(next_ribi[r]));
+				if(  ts == NULL  ||  (  (ts->ways & way_bit) == 0  &&  (ts->flags & surface_t::tile_summary_t::MULTIPLE_GROUNDS) == 0  &&  !(wegtyp == water_wt  &&  ts->ground_typ == grund_t::wasser)  )  ) {
+					continue;
+				}
+			}
 
 			// a way goes here, and it is not marked (i.e. in the closed list)
 			if((to  ||  gr->get_neighbour(to, wegtyp, next_ribi[r]))  &&  tdriver->check_next_tile(to)  &&  !marker.is_marked(to)) {
@@ -543,7 +723,8 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 		uint32 best = tmp->g;
 #endif
 		// reached => construct route
-		route.store_at( tmp->count, tmp->gr->get_pos() );
+		search_tiles.clear();
+		search_tiles.store_at( tmp->count, tmp->gr->get_pos() );
 		while(tmp != NULL) {
 #ifdef DEBUG
 			// debug heuristics
@@ -553,12 +734,13 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 					     start.get_str(), ziel.get_fullstr(), tmp->gr->get_pos().get_2d().get_str(), best, tmp->g, tmp->f, dist, tmp->f - tmp->g - dist);
 			}
 #endif
-			route[ tmp->count ] = tmp->gr->get_pos();
+			search_tiles[ tmp->count ] = tmp->gr->get_pos();
 			tmp = tmp->parent;
 		}
 		if (use_jps  &&  tdriver->get_waytype()==water_wt) {
-			postprocess_water_route(welt);
+			postprocess_water_route(welt, search_tiles);
 		}
+		set_tiles( search_tiles );
 		ok = true;
 	}
 
@@ -582,7 +764,7 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
  *      ++
  *       +-->
  */
-void route_t::postprocess_water_route(karte_t *welt)
+void route_t::postprocess_water_route(karte_t *welt, koord3d_vector_t &route)
 {
 	if (route.get_count() < 5) return;
 
@@ -680,7 +862,7 @@ void route_t::postprocess_water_route(karte_t *welt)
  */
 route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_khm, sint32 max_len )
 {
-	route.clear();
+	clear();
 
 	INT_CHECK("route 336");
 
@@ -690,7 +872,7 @@ route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, c
 	bool ok = intern_calc_route(welt, start, ziel, tdriver, max_khm, 0xFFFFFFFFul );
 #ifdef DEBUG_ROUTES
 	if(tdriver->get_waytype()==water_wt) {
-		DBG_DEBUG("route_t::calc_route()", "route from %d,%d to %d,%d with %i steps in %u ms found.", start.x, start.y, ziel.x, ziel.y, route.get_count()-1, dr_time()-ms );
+		DBG_DEBUG("route_t::calc_route()", "route from %d,%d to %d,%d with %i steps in %u ms found.", start.x, start.y, ziel.x, ziel.y, get_count()-1, dr_time()-ms );
 	}
 #endif
 
@@ -699,8 +881,7 @@ route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, c
 	if( !ok ) {
 		DBG_MESSAGE("route_t::calc_route()","No route from %d,%d to %d,%d found",start.x, start.y, ziel.x, ziel.y);
 		// no route found
-		route.reserve(1);
-		route.append(start); // just to be safe
+		append(start); // just to be safe
 		return no_route;
 	}
 	// advance so all convoi fits into a halt (only set for trains and cars)
@@ -711,14 +892,14 @@ route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, c
 		if(  halt.is_bound()  ) {
 
 			// first: find out how many tiles I am already in the station
-			for(  size_t i = route.get_count();  i-- != 0  &&  max_len != 0  &&  halt == haltestelle_t::get_halt(route[i], NULL);  --max_len) {
+			for(  size_t i = get_count();  i-- != 0  &&  max_len != 0  &&  halt == haltestelle_t::get_halt(at(i), NULL);  --max_len) {
 			}
 
 			// and now go forward, if possible
 			if(  max_len>0  ) {
 
-				const uint32 max_n = route.get_count()-1;
-				const koord3d zv = route[max_n] - route[max_n - 1];
+				const uint32 max_n = get_count()-1;
+				const koord3d zv = at(max_n) - at(max_n - 1);
 				const int ribi = ribi_type(zv);
 
 				grund_t *gr = welt->lookup(start);
@@ -733,7 +914,7 @@ route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, c
 					if(  (ribi&go_dir)!=0  ) {
 						break;
 					}
-					route.append(gr->get_pos());
+					append(gr->get_pos());
 					max_len--;
 					way_ribi = tdriver->get_ribi(gr);
 				}
@@ -753,22 +934,59 @@ route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, c
 void route_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t r( file, "route_t" );
-	sint32 max_n = route.get_count()-1;
+	sint32 max_n = get_count()-1;
 
 	file->rdwr_long(max_n);
-	if(file->is_loading()) {
+	if(  file->is_version_atleast(124, 3)  ) {
+		// first tile and the packed steps
+		if(  max_n < 0  ) {
+			if(  file->is_loading()  ) {
+				clear();
+			}
+			return;
+		}
+		koord3d k = file->is_loading() ? koord3d::invalid : front();
+		k.rdwr(file);
+		uint32 n_steps = steps.get_count();
+		file->rdwr_long(n_steps);
+		if(  file->is_loading()  ) {
+			vector_tpl<uint8> packed(n_steps);
+			for(  uint32 i=0;  i<n_steps;  i++  ) {
+				uint8 b = 0;
+				file->rdwr_byte(b);
+				packed.append(b);
+			}
+			// rebuild the checkpoints by decoding
+			clear();
+			append(k);
+			const uint8 *p = packed.begin();
+			for(  sint32 i=1;  i<=max_n;  i++  ) {
+				if(  p >= packed.end()  ||  (*p == STEP_ESCAPE  &&  p + STEP_ESCAPE_SIZE > packed.end())  ) {
+					dbg->error( "route_t::rdwr()", "Route data ends after %d of %d tiles", i, max_n+1 );
+					break;
+				}
+				decode_step(p, k);
+				append(k);
+			}
+		}
+		else {
+			for(  uint32 i=0;  i<n_steps;  i++  ) {
+				file->rdwr_byte(steps[i]);
+			}
+		}
+	}
+	else if(file->is_loading()) {
 		koord3d k;
-		route.clear();
-		route.reserve(max_n+2);
+		clear();
 		for(sint32 i=0;  i<=max_n;  i++ ) {
 			k.rdwr(file);
-			route.append(k);
+			append(k);
 		}
 	}
 	else {
 		// writing
 		for(sint32 i=0; i<=max_n; i++) {
-			route[i].rdwr(file);
+			at(i).rdwr(file);
 		}
 	}
 }
@@ -10,6 +10,7 @@
 #include "../simdebug.h"
 
 #include "../dataobj/koord3d.h"
+#include "../dataobj/ribi.h"
 
 #include "../tpl/vector_tpl.h"
 
@@ -17,6 +18,7 @@
 class karte_t;
 class test_driver_t;
 class grund_t;
+class loadsave_t;
 
 
 /**
@@ -35,9 +37,66 @@ private:
 	 */
 	bool intern_calc_route(karte_t *w, koord3d start, koord3d ziel, test_driver_t *tdriver, const sint32 max_kmh, const uint32 max_cost);
 
-	koord3d_vector_t route;           // The coordinates for the vehicle route
+	/**
+	 * The tiles of the route are stored as the first tile plus one byte per
+	 * step with the direction and the height change. Steps that do not fit
+	 * into a byte (jumps, large height changes) store the full position.
+	 * Every CHECKPOINT_STEPS tiles the position and the offset into steps
+	 * is kept, so at() has to decode less than CHECKPOINT_STEPS steps.
+	 */
+	struct checkpoint_t {
+		koord3d pos;
+		uint32 offset; ///< offset of the step following pos
+	};
+
+	enum { CHECKPOINT_SHIFT = 4, CHECKPOINT_STEPS = 1 << CHECKPOINT_SHIFT };
+
+	/**
+	 * A step is a byte with the direction in bit 0-2 (index into step_dx/step_dy)
+	 * and the height change +8 in bit 3-6, or STEP_ESCAPE followed by x, y (little endian) and z.
+	 */
+	enum { STEP_ESCAPE = 0xFF, STEP_ESCAPE_SIZE = 6 };
+	static const sint8 step_dx[8];
+	static const sint8 step_dy[8];
+
+	vector_tpl<uint8> steps;
+	vector_tpl<checkpoint_t> checkpoints;
+	uint32 count;
+	koord3d last;
+
+	/// see get_serial()
+	uint32 serial;
+	static uint32 next_serial;
+
+	void changed() { serial = ++next_serial; }
+
+	/// advances pos by the step at p
+	static void decode_step(const uint8 *&p, koord3d &pos)
+	{
+		const uint8 b = *p++;
+		if(  b == STEP_ESCAPE  ) {
+			pos.x = (sint16)(p[0] | (p[1] << 8));
+			pos.y = (sint16)(p[2] | (p[3] << 8));
+			pos.z = (sint8)p[4];
+			p += STEP_ESCAPE_SIZE-1;
+		}
+		else {
+			pos.x += step_dx[b & 7];
+			pos.y += step_dy[b & 7];
+			pos.z += (sint8)((b >> 3) - 8);
+		}
+	}
+
+	/// keeps the first n tiles
+	void truncate(uint32 n);
+
+	/// replaces the route by these tiles
+	void set_tiles(const koord3d_vector_t &tiles);
+
+	/// all tiles of the route
+	void get_tiles(koord3d_vector_t &tiles) const;
 
-	void postprocess_water_route(karte_t *welt);
+	static void postprocess_water_route(karte_t *welt, koord3d_vector_t &tiles);
 
 	static inline uint32 calc_distance( const koord3d &p1, const koord3d &target )
 	{
@@ -81,27 +140,87 @@ public:
 	static void RELEASE_NODE() {}
 #endif
 
-	const koord3d_vector_t &get_route() const { return route; }
+	route_t() : count(0), last(koord3d::invalid), serial(0) {}
 
-	void rotate90( sint16 y_size ) { route.rotate90( y_size ); }
+	void rotate90( sint16 y_size );
 
+	bool is_contained(const koord3d &k) const { return index_of(k) != 0xFFFFFFFFu; }
 
-	bool is_contained(const koord3d &k) const { return route.is_contained(k); }
-
-	uint32 index_of(const koord3d &k) const { return (uint32)(route.index_of(k)); }
+	/// @return index of the first tile at @p k, or 0xFFFFFFFF if not contained
+	uint32 index_of(const koord3d &k) const;
 
 	/**
 	 * @return Coordinate at index @p n.
 	 */
-	const koord3d& at(const uint16 n) const { return route[n]; }
+	koord3d at(const uint32 n) const
+	{
+		if(  n >= count  ) {
+			dbg->fatal( "route_t::at()", "index out of bounds: %u not in 0..%d", n, (int)count-1 );
+		}
+		const checkpoint_t &cp = checkpoints[n >> CHECKPOINT_SHIFT];
+		koord3d pos = cp.pos;
+		const uint8 *p = steps.begin() + cp.offset;
+		for(  uint32 i = n & (CHECKPOINT_STEPS-1);  i > 0;  i--  ) {
+			decode_step( p, pos );
+		}
+		return pos;
+	}
+
+	koord3d front() const { return checkpoints[0].pos; }
+
+	koord3d back() const { return last; }
+
+	uint32 get_count() const { return count; }
+
+	bool empty() const { return count<2; }
+
+	/**
+	 * Changes whenever tiles are added or removed, so caches of the route
+	 * can tell whether they are outdated. A copy has the same serial as its
+	 * original until one of them is changed.
+	 */
+	uint32 get_serial() const { return serial; }
 
-	koord3d const& front() const { return route.front(); }
+	/// bytes allocated for the packed steps and the checkpoints
+	size_t get_memory() const { return steps.get_capacity() + checkpoints.get_capacity() * sizeof(checkpoint_t); }
 
-	koord3d const& back() const { return route.back(); }
+	/// directions to the previous and next tile at index @p n
+	ribi_t::ribi get_ribi(uint32 n) const;
+
+	/// decodes the tiles one after the other, much faster than at() for each index
+	class const_iterator
+	{
+		const uint8 *p;
+		koord3d pos;
+		uint32 index;
+		uint32 count;
+	public:
+		const_iterator(const uint8 *p_, koord3d pos_, uint32 index_, uint32 count_) : p(p_), pos(pos_), index(index_), count(count_) {}
+		koord3d operator*() const { return pos; }
+		const_iterator &operator++()
+		{
+			if(  ++index < count  ) {
+				decode_step( p, pos );
+			}
+			return *this;
+		}
+		bool operator!=(const const_iterator &o) const { return index != o.index; }
+	};
 
-	uint32 get_count() const { return route.get_count(); }
+	const_iterator begin() const { return const_iterator( steps.begin(), count ? front() : koord3d::invalid, 0, count ); }
 
-	bool empty() const { return route.get_count()<2; }
+	/// iterator starting at index @p n < get_count()
+	const_iterator iterator_at(uint32 n) const
+	{
+		const checkpoint_t &cp = checkpoints[n >> CHECKPOINT_SHIFT];
+		koord3d pos = cp.pos;
+		const uint8 *p = steps.begin() + cp.offset;
+		for(  uint32 i = n & (CHECKPOINT_STEPS-1);  i > 0;  i--  ) {
+			decode_step( p, pos );
+		}
+		return const_iterator( p, pos, n, count );
+	}
+	const_iterator end() const { return const_iterator( NULL, koord3d::invalid, count, count ); }
 
 	/**
 	 * Appends the other route to ours.
@@ -116,12 +235,12 @@ public:
 	/**
 	 * Appends position @p k.
 	 */
-	inline void append(koord3d k) { route.append(k); }
+	void append(koord3d k);
 
 	/**
 	 * removes all tiles from the route
 	 */
-	void clear() { route.clear(); }
+	void clear();
 
 	/**
 	 * Removes all tiles at indices >@p i.
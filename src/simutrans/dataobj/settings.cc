@@ -1023,7 +1023,12 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	env_t::max_acceleration            = contents.get_int_clamped( "fast_forward",                   env_t::max_acceleration,          0, 0x7FFF );
 	env_t::fps                         = contents.get_int_clamped( "frames_per_second",              env_t::fps,                       env_t::min_fps, env_t::max_fps );
 	env_t::ff_fps                      = contents.get_int_clamped( "fast_forward_frames_per_second", env_t::ff_fps,                    env_t::min_fps, env_t::max_fps );
+	env_t::fast_forward_unthrottled    = contents.get_int( "fast_forward_unthrottled", env_t::fast_forward_unthrottled ) != 0;
+	env_t::fast_forward_time_limit     = contents.get_int_clamped( "fast_forward_time_limit",        env_t::fast_forward_time_limit,   0, INT_MAX );
 	env_t::num_threads                 = contents.get_int_clamped( "threads",                        env_t::num_threads,               1, min(dr_get_max_threads(), MAX_THREADS) );
+	env_t::pak_cache                   = contents.get_int( "pak_cache", env_t::pak_cache ) != 0;
+	env_t::image_cache_budget          = contents.get_int_clamped( "image_cache_budget",             env_t::image_cache_budget,        0, 4095 );
+	env_t::far_traffic_interval        = contents.get_int_clamped( "far_traffic_interval", env_t::far_traffic_interval, 1, 16 );
 	env_t::simple_drawing_default      = contents.get_int_clamped( "simple_drawing_tile_size",       env_t::simple_drawing_default,    2, 256 );
 
 	env_t::simple_drawing_fast_forward = contents.get_int( "simple_drawing_fast_forward", env_t::simple_drawing_fast_forward ) != 0;
@@ -12,7 +12,6 @@
 #include "../obj_node_info.h"
 #include "building_reader.h"
 #include "../../network/pakset_info.h"
-#include "../../tpl/array_tpl.h"
 
 
 /**
@@ -31,13 +30,9 @@ struct old_btyp
 	};
 };
 
-obj_desc_t * tile_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * tile_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	// old versions of PAK files have no version stamp.
 	// But we know, the highest bit was always cleared.
@@ -217,13 +212,9 @@ bool building_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t * building_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * building_reader_t::read_node(char *data, obj_node_info_t &node)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char * p = desc_buf.begin();
+	char * p = data;
 
 	// old versions of PAK files have no version stamp.
 	// But we know, the highest bit was always cleared.
@@ -12,7 +12,6 @@
 #include "../factory_desc.h"
 #include "../xref_desc.h"
 #include "../../network/pakset_info.h"
-#include "../../tpl/array_tpl.h"
 
 #include "factory_reader.h"
 
@@ -39,13 +38,9 @@ uint16 rescale_probability(const uint16 p)
 }
 
 
-obj_desc_t *factory_field_class_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_field_class_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	uint16 v = decode_uint16(p);
 	field_class_desc_t *desc = new field_class_desc_t();
@@ -72,13 +67,9 @@ obj_desc_t *factory_field_class_reader_t::read_node(FILE *fp, obj_node_info_t &n
 }
 
 
-obj_desc_t *factory_field_group_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_field_group_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	uint16 v = decode_uint16(p);
 	field_group_desc_t *desc = new field_group_desc_t();
@@ -166,13 +157,9 @@ void factory_field_group_reader_t::register_obj(obj_desc_t *&data)
 
 
 
-obj_desc_t *factory_smoke_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_smoke_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	sint16 x = decode_sint16(p);
 	sint16 y = decode_sint16(p);
@@ -192,13 +179,9 @@ obj_desc_t *factory_smoke_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 }
 
 
-obj_desc_t *factory_supplier_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_supplier_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 
 	// old versions of PAK files have no version stamp.
@@ -230,13 +213,9 @@ obj_desc_t *factory_supplier_reader_t::read_node(FILE *fp, obj_node_info_t &node
 }
 
 
-obj_desc_t *factory_product_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_product_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	// old versions of PAK files have no version stamp.
 	// But we know, the higher most bit was always cleared.
@@ -268,13 +247,9 @@ obj_desc_t *factory_product_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 }
 
 
-obj_desc_t *factory_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *factory_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	// old versions of PAK files have no version stamp.
 	// But we know, the higher most bit was always cleared.
@@ -22,7 +22,7 @@ class factory_field_class_reader_t : public obj_reader_t
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -39,7 +39,7 @@ protected:
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -49,7 +49,7 @@ class factory_smoke_reader_t : public obj_reader_t
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t* read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t* read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -59,7 +59,7 @@ class factory_supplier_reader_t : public obj_reader_t
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -69,7 +69,7 @@ class factory_product_reader_t : public obj_reader_t
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
@@ -86,7 +86,7 @@ protected:
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 };
 
 
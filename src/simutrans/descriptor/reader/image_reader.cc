@@ -13,10 +13,10 @@
 #include "../image.h"
 #include "image_reader.h"
 #include "../obj_node_info.h"
+#include "../../dataobj/pakset_manager.h"
 
 #include <zlib.h>
 #include "../../tpl/inthashtable_tpl.h"
-#include "../../tpl/array_tpl.h"
 
 
 // if without graphics backend, do not copy any pixel
@@ -26,18 +26,33 @@
 #define skip_reading_pixels_if_no_graphics goto adjust_image
 #endif
 
-obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t *image_reader_t::read_node(char *data, obj_node_info_t &node)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
+#if COLOUR_DEPTH != 0
+	image_t *cached;
+	if(  pakset_manager_t::read_cached_image( node, data, cached )  ) {
+		// already converted and registered
+		return cached;
 	}
-	char *p = desc_buf.begin()+6;
+#endif
+
+	image_t *desc = read_image( data, node );
+
+#if COLOUR_DEPTH != 0
+	pakset_manager_t::cache_image( node, data, desc );
+#endif
+	return desc;
+}
+
+
+image_t *image_reader_t::read_image(char *data, obj_node_info_t &node)
+{
+	char *p = data+6;
 
 	// always zero in old version, since length was always less than 65535
 	// because a node could not hold more data
 	uint8 version = decode_uint8(p);
-	p = desc_buf.begin();
+	p = data;
 
 #if COLOUR_DEPTH != 0
 	image_t *desc = new image_t();
@@ -60,7 +75,7 @@ obj_desc_t *image_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		//DBG_DEBUG("image_t::read_node()","x,y=%d,%d  w,h=%d,%d, len=%i",desc->x,desc->y,desc->w,desc->h, desc->len);
 
 		uint16* dest = desc->data;
-		p = desc_buf.begin()+12;
+		p = data+12;
 
 		if (desc->h > 0) {
 			for (uint i = 0; i < desc->len; i++) {
@@ -19,9 +19,12 @@ class image_reader_t : public obj_reader_t
 
 public:
 	/// @copydoc obj_reader_t::read_node
-	obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) OVERRIDE;
+	obj_desc_t *read_node(char *data, obj_node_info_t &node) OVERRIDE;
 
 private:
+	/// Decodes and registers the image of a node, returns an identical image loaded before instead of a new one
+	image_t *read_image(char *data, obj_node_info_t &node);
+
 	bool image_has_valid_data(image_t *img) const;
 };
 
@@ -10,16 +10,11 @@
 
 #include "imagelist_reader.h"
 #include "../obj_node_info.h"
-#include "../../tpl/array_tpl.h"
 
 
-obj_desc_t * imagelist_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * imagelist_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	image_list_t *desc = new image_list_t();
 	desc->count = decode_uint16(p);
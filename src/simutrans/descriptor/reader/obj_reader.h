@@ -80,9 +80,10 @@ public:
 	virtual ~obj_reader_t() {}
 
 public:
-	/// Read a descriptor from @p fp. Does version check and compatibility transformations.
+	/// Decode a descriptor from the @p node.size bytes at @p data, which point into the pak file in memory.
+	/// Does version check and compatibility transformations.
 	/// @returns The descriptor on success, or NULL on failure
-	virtual obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) = 0;
+	virtual obj_desc_t *read_node(char *data, obj_node_info_t &node) = 0;
 
 	/// Register descriptor so the object described by the descriptor can be built in-game.
 	virtual void register_obj(obj_desc_t *&/*desc*/) {}
@@ -15,7 +15,6 @@
 
 #include "../../simdebug.h"
 #include "../../network/pakset_info.h"
-#include "../../tpl/array_tpl.h"
 
 
 void roadsign_reader_t::register_obj(obj_desc_t *&data)
@@ -36,13 +35,9 @@ bool roadsign_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t * roadsign_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * roadsign_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	const uint16 v = decode_uint16(p);
 	const int version = v & 0x8000 ? v & 0x7FFF : 0;
@@ -41,7 +41,7 @@ bool skin_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t* skin_reader_t::read_node(FILE*, obj_node_info_t& info)
+obj_desc_t* skin_reader_t::read_node(char*, obj_node_info_t& info)
 {
 	return obj_reader_t::read_node<skin_desc_t>(info);
 }
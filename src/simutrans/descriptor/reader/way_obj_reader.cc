@@ -13,7 +13,6 @@
 #include "way_obj_reader.h"
 #include "../obj_node_info.h"
 #include "../../network/pakset_info.h"
-#include "../../tpl/array_tpl.h"
 
 
 void way_obj_reader_t::register_obj(obj_desc_t *&data)
@@ -33,13 +32,9 @@ bool way_obj_reader_t::successfully_loaded() const
 }
 
 
-obj_desc_t * way_obj_reader_t::read_node(FILE *fp, obj_node_info_t &node)
+obj_desc_t * way_obj_reader_t::read_node(char *data, obj_node_info_t &)
 {
-	array_tpl<char> desc_buf(node.size);
-	if (fread(desc_buf.begin(), node.size, 1, fp) != 1) {
-		return NULL;
-	}
-	char *p = desc_buf.begin();
+	char *p = data;
 
 	// old versions of PAK files have no version stamp.
 	// But we know, the higher most bit was always cleared.
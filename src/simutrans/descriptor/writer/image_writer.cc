@@ -23,20 +23,43 @@
 #endif
 
 
-struct dimension
-{
-	int xmin;
-	int xmax;
-	int ymin;
-	int ymax;
-};
+// number of decoded image files kept besides the current one
+#define MAX_CACHED_PNGS (8)
+
+// the encoded blocks are dropped when they use more memory
+#define MAX_BLOCK_CACHE_BYTES (64u<<20)
 
 
 std::string image_writer_t::last_img_file;
 
 raw_image_t image_writer_t::input_img;
+uint64 image_writer_t::input_hash = 0;
 int image_writer_t::img_size = 64;
 
+std::vector<image_writer_t::cached_png_t *> image_writer_t::png_cache;
+std::map<image_writer_t::block_key_t, image_writer_t::encoded_block_t> image_writer_t::block_cache;
+size_t image_writer_t::block_cache_bytes = 0;
+
+
+// FNV-1a over size, format and pixels, identical image files share their encoded blocks
+static uint64 hash_image(const raw_image_t &img)
+{
+	uint64 hash = 0xCBF29CE484222325ull;
+	const uint32 head[3] = { img.get_width(), img.get_height(), img.get_format() };
+	const uint8 *p = (const uint8 *)head;
+	for(  size_t i = 0;  i < sizeof(head);  i++  ) {
+		hash = (hash ^ p[i]) * 0x100000001B3ull;
+	}
+	if(  img.get_width() > 0  &&  img.get_height() > 0  ) {
+		p = img.access_pixel(0, 0);
+		const size_t size = (size_t)img.get_width() * img.get_height() * (img.get_bpp() / 8);
+		for(  size_t i = 0;  i < size;  i++  ) {
+			hash = (hash ^ p[i]) * 0x100000001B3ull;
+		}
+	}
+	return hash;
+}
+
 
 uint32 image_writer_t::block_getpix(int x, int y)
 {
@@ -257,16 +280,94 @@ uint16 *image_writer_t::encode_image(int x, int y, dimension* dim, int* len)
 }
 
 
+const image_writer_t::encoded_block_t &image_writer_t::get_block(int col, int row)
+{
+	block_key_t key;
+	key.hash = input_hash;
+	key.col = col;
+	key.row = row;
+	key.size = img_size;
+
+	std::map<block_key_t, encoded_block_t>::const_iterator i = block_cache.find(key);
+	if(  i != block_cache.end()  ) {
+		return i->second;
+	}
+
+	if(  block_cache_bytes > MAX_BLOCK_CACHE_BYTES  ) {
+		block_cache.clear();
+		block_cache_bytes = 0;
+	}
+
+	encoded_block_t &block = block_cache[key];
+
+	// Temp. read image and determine drawing area.
+	uint32 *image_data = new uint32[img_size * img_size];
+	for (int x = 0; x < img_size; x++) {
+		for (int y = 0; y < img_size; y++) {
+			image_data[x + y * img_size] = block_getpix(x + col, y + row);
+		}
+	}
+	init_dim(image_data, &block.dim, img_size);
+	delete [] image_data;
+
+	if(  block.dim.ymax - block.dim.ymin + 1 > 0  ) {
+		int len;
+		uint16 *pixdata = encode_image(col, row, &block.dim, &len);
+		block.data.assign(pixdata, pixdata + len);
+		delete [] pixdata;
+	}
+	block_cache_bytes += sizeof(encoded_block_t) + block.data.size() * sizeof(uint16);
+	return block;
+}
+
+
 bool image_writer_t::block_load(const char *fname)
 {
 	// The last image file is cached
 	// Note that this method accepts any file name if the content has a supported format,
 	// even though makeobj only supports image file names with a ".png" suffix.
 	// See image_writer_t::write_obj for details.
+	root_writer_t::add_input(fname);
 	if(  last_img_file == fname  ) {
 		return true;
 	}
-	else if (load_image_from_file(fname)) {
+
+	// then the other recently used files
+	for(  size_t i = 0;  i < png_cache.size();  i++  ) {
+		cached_png_t *const c = png_cache[i];
+		if(  c->file == fname  ) {
+			swap( input_img, c->img );
+			std::swap( input_hash, c->hash );
+			c->file.swap( last_img_file );
+			png_cache.erase( png_cache.begin() + i );
+			if(  c->file.empty()  ) {
+				delete c;
+			}
+			else {
+				png_cache.insert( png_cache.begin(), c );
+			}
+			return true;
+		}
+	}
+
+	// keep the current one for later
+	if(  !last_img_file.empty()  ) {
+		cached_png_t *c;
+		if(  png_cache.size() < MAX_CACHED_PNGS  ) {
+			c = new cached_png_t;
+		}
+		else {
+			c = png_cache.back();
+			png_cache.pop_back();
+		}
+		swap( input_img, c->img );
+		c->hash = input_hash;
+		c->file = last_img_file;
+		png_cache.insert( png_cache.begin(), c );
+		last_img_file = "";
+	}
+
+	if (load_image_from_file(fname)) {
 		if ((input_img.get_width()%img_size != 0) || (input_img.get_height()%img_size != 0)) {
 			dbg->error("image_writer_t::block_load", "Cannot load image file '%s': "
 				"Size not divisible by %d.", fname, img_size);
@@ -275,6 +376,7 @@ bool image_writer_t::block_load(const char *fname)
 		}
 
 		last_img_file = fname;
+		input_hash = hash_image( input_img );
 		return true;
 	}
 
@@ -349,7 +451,7 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 {
 	image_t image;
 	dimension dim;
-	uint16 *pixdata = NULL;
+	const uint16 *pixdata = NULL;
 
 	MEMZERO(image);
 
@@ -424,27 +526,15 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 		row *= img_size;
 		col *= img_size;
 
-		// Temp. read image and determine drawing area.
-		uint32 *image_data = new uint32[img_size * img_size];
-		for (int x = 0; x < img_size; x++) {
-			for (int y = 0; y < img_size; y++) {
-				image_data[x + y * img_size] = block_getpix(x + col, y + row);
-			}
-		}
-		init_dim(image_data, &dim, img_size);
-		delete [] image_data;
+		const encoded_block_t &block = get_block(col, row);
+		dim = block.dim;
 
 		image.x += dim.xmin;
 		image.y += dim.ymin;
 		image.w = dim.xmax - dim.xmin + 1;
 		image.h = dim.ymax - dim.ymin + 1;
-		image.len = 0;
-
-		if (image.h > 0) {
-			int len;
-			pixdata = encode_image(col, row, &dim, &len);
-			image.len = len;
-		}
+		image.len = block.data.size();
+		pixdata = image.len ? &block.data[0] : NULL;
 
 		dbg->debug( "", "image[%3u] =%-30s %-20s %5u %5u %5u %5u %5u %6u %4s", index, an_imagekey.c_str(), imagekey.c_str(), col, row, image.x, image.y, image.w, image.h, (image.zoomable) ? "yes" : "no" );
 	}
@@ -469,7 +559,6 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 	if (image.len) {
 		// only called, if there is something to store
 		node.write_data_at(outfp, pixdata, 12, image.len * sizeof(PIXVAL));
-		delete [] pixdata;
 	}
 #elif IMG_VERSION2
 	// version 1 or 2
@@ -487,7 +576,6 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 	if (image.len) {
 		// only called, if there is something to store
 		node.write_data_at(outfp, pixdata, 10, image.len * sizeof(PIXVAL));
-		delete [] pixdata;
 	}
 #else
 	// version 3
@@ -505,7 +593,6 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 	if (image.len) {
 		// only called, if there is something to store
 		node.write_data_at(outfp, pixdata, 10, image.len * sizeof(uint16));
-		delete [] pixdata;
 	}
 #endif
 
@@ -8,6 +8,8 @@
 
 
 #include <string>
+#include <vector>
+#include <map>
 #include <stdio.h>
 #include "obj_writer.h"
 #include "../objversion.h"
@@ -15,7 +17,15 @@
 
 
 class obj_node_t;
-struct dimension;
+
+
+struct dimension
+{
+	int xmin;
+	int xmax;
+	int ymin;
+	int ymax;
+};
 
 
 class image_writer_t : public obj_writer_t
@@ -25,8 +35,36 @@ private:
 
 	static std::string last_img_file;
 	static raw_image_t input_img;
+	static uint64 input_hash; // content hash of input_img
 	static int img_size; // default 64
 
+	/// recently decoded image files other than input_img, most recently used first
+	struct cached_png_t
+	{
+		std::string file;
+		raw_image_t img;
+		uint64 hash;
+	};
+	static std::vector<cached_png_t *> png_cache;
+
+	/// encoded image blocks by content hash of the image file, position and block size
+	struct block_key_t
+	{
+		uint64 hash;
+		int col, row, size;
+
+		bool operator<(const block_key_t &k) const {
+			return hash != k.hash ? hash < k.hash : col != k.col ? col < k.col : row != k.row ? row < k.row : size < k.size;
+		}
+	};
+	struct encoded_block_t
+	{
+		dimension dim;
+		std::vector<uint16> data;
+	};
+	static std::map<block_key_t, encoded_block_t> block_cache;
+	static size_t block_cache_bytes;
+
 	image_writer_t() { register_writer(false); }
 
 	static uint32 block_getpix(int x, int y);
@@ -51,6 +89,9 @@ private:
 	/// Encodes an image into a sprite data structure, considers
 	/// special colors.
 	static uint16 *encode_image(int x, int y, dimension* dim, int* len);
+
+	/// Encodes the block at @p col, @p row of input_img or takes it from block_cache
+	static const encoded_block_t &get_block(int col, int row);
 };
 
 #endif
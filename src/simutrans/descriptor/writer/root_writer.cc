@@ -5,16 +5,28 @@
 
 #include <string>
 #include <stdlib.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 #include "../../dataobj/tabfile.h"
 #include "../../utils/searchfolder.h"
 #include "../obj_desc.h"
 #include "obj_node.h"
 #include "obj_writer.h"
+#include "obj_pak_exception.h"
 #include "root_writer.h"
 
 using std::string;
 
 string root_writer_t::inpath;
+int root_writer_t::jobs = 1;
+bool root_writer_t::incremental = false;
+std::set<string> root_writer_t::inputs;
+std::vector<string> root_writer_t::outputs;
 
 void root_writer_t::write_header(FILE* fp)
 {
@@ -43,7 +55,36 @@ void root_writer_t::write(const char* filename, int argc, char* argv[])
 		printf("writing individual files to %s\n", filename);
 		separate = true;
 	}
-	else {
+
+	// collect all dat files first
+	std::vector<dat_file_t> dats;
+	for(  int i=0;  i==0  ||  i<argc;  i++  ) {
+		const char* arg = (i < argc) ? argv[i] : "./";
+		dat_file_t dat;
+
+		dat.inpath = arg;
+		string::size_type n = dat.inpath.rfind('/');
+
+		if(n!=string::npos) {
+			dat.inpath = dat.inpath.substr(0, n + 1);
+		}
+		else {
+			dat.inpath = "";
+		}
+
+		find.search(arg, "dat");
+		for(const char* const& i : find) {
+			dat.name = i;
+			dats.push_back(dat);
+		}
+	}
+
+	if (jobs > 1 || incremental) {
+		write_parallel(filename, file, separate, dats);
+		return;
+	}
+
+	if (!separate) {
 		outfp = fopen(file.c_str(), "wb");
 
 		if (!outfp) {
@@ -58,68 +99,335 @@ void root_writer_t::write(const char* filename, int argc, char* argv[])
 		node = new obj_node_t(this, 0, NULL);
 	}
 
-	for(  int i=0;  i==0  ||  i<argc;  i++  ) {
-		const char* arg = (i < argc) ? argv[i] : "./";
+	for(dat_file_t const& dat : dats) {
+		write_dat(outfp, node, filename, dat);
+	}
 
-		find.search(arg, "dat");
-		for(const char* const& i : find) {
-			tabfile_t infile;
+	if (!separate) {
+		node->write(outfp);
+		delete node;
+		fclose(outfp);
+	}
+}
 
-			if (infile.open(i)) {
-				tabfileobj_t obj;
 
-				if (debuglevel >= log_t::LEVEL_WARN) {
-					printf("   Reading file %s\n", i);
-				}
+void root_writer_t::write_dat(FILE* outfp, obj_node_t* node, const char* dest, const dat_file_t &dat)
+{
+	const bool separate = (outfp == NULL);
+	tabfile_t infile;
 
-				inpath = arg;
-				string::size_type n = inpath.rfind('/');
+	if (!infile.open(dat.name.c_str())) {
+		dbg->warning( "Write pak", "Cannot read %s", dat.name.c_str());
+		return;
+	}
 
-				if(n!=string::npos) {
-					inpath = inpath.substr(0, n + 1);
-				}
-				else {
-					inpath = "";
-				}
+	tabfileobj_t obj;
 
-				while(infile.read(obj)) {
-					if(separate) {
-						string name(filename);
+	if (debuglevel >= log_t::LEVEL_WARN) {
+		printf("   Reading file %s\n", dat.name.c_str());
+	}
 
-						name = name + obj.get("obj") + "." + obj.get("name") + ".pak";
+	inpath = dat.inpath;
 
-						outfp = fopen(name.c_str(), "wb");
-						if (!outfp) {
-							dbg->fatal( "Write pak", "Cannot create destination file %s", filename );
-						}
+	while(infile.read(obj)) {
+		if(separate) {
+			string name(dest);
 
-						if (debuglevel >= log_t::LEVEL_WARN) {
-							printf("   Writing file %s\n", name.c_str());
-						}
+			name = name + obj.get("obj") + "." + obj.get("name") + ".pak";
 
-						write_header(outfp);
-						node = new obj_node_t(this, 0, NULL);
-					}
-					obj_writer_t::write(outfp, *node, obj);
-					obj.unused( "#;-/" );
+			outfp = fopen(name.c_str(), "wb");
+			if (!outfp) {
+				dbg->fatal( "Write pak", "Cannot create destination file %s", dest );
+			}
 
-					if(separate) {
-						node->write(outfp);
-						delete node;
-						fclose(outfp);
-					}
+			if (debuglevel >= log_t::LEVEL_WARN) {
+				printf("   Writing file %s\n", name.c_str());
+			}
+
+			outputs.push_back(name);
+			write_header(outfp);
+			node = new obj_node_t(this, 0, NULL);
+		}
+		obj_writer_t::write(outfp, *node, obj);
+		obj.unused( "#;-/" );
+
+		if(separate) {
+			node->write(outfp);
+			delete node;
+			fclose(outfp);
+		}
+	}
+}
+
+
+static bool skip_header(FILE* const f);
+
+
+// size and modification time, false if the file does not exist
+static bool get_file_stamp(const char* name, long long &size, long long &mtime)
+{
+	struct stat st;
+	if (stat(name, &st) != 0) {
+		return false;
+	}
+	size = (long long)st.st_size;
+	mtime = (long long)st.st_mtime;
+	return true;
+}
+
+
+static string get_dep_header(const root_writer_t::dat_file_t &dat)
+{
+	char buf[64];
+	sprintf(buf, "makeobj %d %d\n", COMPILER_VERSION_CODE, obj_writer_t::get_img_size());
+	return buf + dat.inpath + "\t" + dat.name + "\n";
+}
+
+
+bool root_writer_t::is_up_to_date(const dat_file_t &dat, const string &dep)
+{
+	FILE* fp = fopen(dep.c_str(), "r");
+	if (!fp) {
+		return false;
+	}
+
+	string text;
+	char buf[4096];
+	while (fgets(buf, sizeof(buf), fp)) {
+		text += buf;
+	}
+	fclose(fp);
+
+	const string header = get_dep_header(dat);
+	if (text.compare(0, header.size(), header) != 0) {
+		return false;
+	}
+
+	// then one line "in <size> <time> <name>" or "out <name>" per file
+	string::size_type pos = header.size();
+	while (pos < text.size()) {
+		string::size_type eol = text.find('\n', pos);
+		if (eol == string::npos) {
+			return false;
+		}
+		const string line = text.substr(pos, eol - pos);
+		pos = eol + 1;
+
+		long long size, mtime, old_size, old_mtime;
+		int name_pos = 0;
+		if (sscanf(line.c_str(), "in %lld %lld %n", &old_size, &old_mtime, &name_pos) == 2 && name_pos > 0) {
+			if (!get_file_stamp(line.c_str() + name_pos, size, mtime) || size != old_size || mtime != old_mtime) {
+				return false;
+			}
+		}
+		else if (line.compare(0, 4, "out ") == 0) {
+			if (!get_file_stamp(line.c_str() + 4, size, mtime)) {
+				return false;
+			}
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void root_writer_t::write_dep(const dat_file_t &dat, const string &dep)
+{
+	FILE* fp = fopen(dep.c_str(), "w");
+	if (!fp) {
+		dbg->warning( "Write pak", "Cannot create %s", dep.c_str());
+		return;
+	}
+
+	fputs(get_dep_header(dat).c_str(), fp);
+	for(string const& name : inputs) {
+		long long size, mtime;
+		if (get_file_stamp(name.c_str(), size, mtime)) {
+			fprintf(fp, "in %lld %lld %s\n", size, mtime, name.c_str());
+		}
+		else {
+			// e.g. found case insensitive, check always
+			fprintf(fp, "in -1 -1 %s\n", name.c_str());
+		}
+	}
+	for(string const& name : outputs) {
+		fprintf(fp, "out %s\n", name.c_str());
+	}
+	fclose(fp);
+}
+
+
+bool root_writer_t::write_part(const char* dest, const dat_file_t &dat, const string &part, const string &dep)
+{
+	inputs.clear();
+	outputs.clear();
+	inputs.insert(dat.name);
+
+	FILE* outfp = NULL;
+	try {
+		if (dest) {
+			write_dat(NULL, NULL, dest, dat);
+		}
+		else {
+			outfp = fopen(part.c_str(), "wb");
+			if (!outfp) {
+				dbg->fatal( "Write pak", "Cannot create file %s", part.c_str() );
+			}
+			write_header(outfp);
+
+			obj_node_t node(this, 0, NULL);
+			write_dat(outfp, &node, NULL, dat);
+			node.write(outfp);
+			fclose(outfp);
+			outputs.push_back(part);
+		}
+	}
+	catch (const obj_pak_exception_t& e) {
+		dbg->error( e.get_class(), e.get_info() );
+		if (outfp) {
+			fclose(outfp);
+			remove(part.c_str());
+		}
+		remove(dep.c_str());
+		return false;
+	}
+
+	if (incremental) {
+		write_dep(dat, dep);
+	}
+	return true;
+}
+
+
+void root_writer_t::write_parallel(const char* dest, const string &file, bool separate, const std::vector<dat_file_t> &dats)
+{
+	// the compiled objects of each dat file go to a part file, named after the dat file
+	string base;
+	if (incremental) {
+		base = file + (separate ? "makeobj.cache/" : ".cache/");
+#ifdef _WIN32
+		_mkdir(base.c_str());
+#else
+		mkdir(base.c_str(), 0777);
+#endif
+	}
+	else {
+		base = file + ".";
+	}
+
+	std::vector<string> parts, deps;
+	std::vector<size_t> todo;
+	for(  size_t i = 0;  i < dats.size();  i++  ) {
+		// FNV-1a
+		uint64 hash = 0xCBF29CE484222325ull;
+		const string key = dats[i].inpath + "\t" + dats[i].name;
+		for(  size_t j = 0;  j < key.size();  j++  ) {
+			hash = (hash ^ (uint8)key[j]) * 0x100000001B3ull;
+		}
+		char buf[32];
+		sprintf(buf, "%016llx", (unsigned long long)hash);
+
+		parts.push_back(base + buf + (incremental ? ".pak" : ".tmp"));
+		deps.push_back(base + buf + ".dep");
+
+		if (incremental && is_up_to_date(dats[i], deps[i])) {
+			if (debuglevel >= log_t::LEVEL_MSG) {
+				printf("   Unchanged file %s\n", dats[i].name.c_str());
+			}
+		}
+		else {
+			todo.push_back(i);
+		}
+	}
+
+	if (debuglevel >= log_t::LEVEL_WARN) {
+		printf("Compiling %d of %d dat files\n", (int)todo.size(), (int)dats.size());
+	}
+
+	const char* separate_dest = separate ? dest : NULL;
+	bool ok = true;
+#ifndef _WIN32
+	if (jobs > 1 && todo.size() > 1) {
+		// each process compiles every jobs-th file, so it keeps its own image caches
+		const size_t workers = (size_t)jobs < todo.size() ? (size_t)jobs : todo.size();
+		fflush(NULL);
+		for(  size_t w = 0;  w < workers;  w++  ) {
+			const pid_t pid = fork();
+			if (pid == 0) {
+				bool good = true;
+				for(  size_t k = w;  k < todo.size();  k += workers  ) {
+					good &= write_part(separate_dest, dats[todo[k]], parts[todo[k]], deps[todo[k]]);
 				}
+				fflush(NULL);
+				exit(good ? 0 : 1);
 			}
-			else {
-				dbg->warning( "Write pak", "Cannot read %s", i);
+			if (pid < 0) {
+				dbg->fatal( "Write pak", "Cannot start process %d", (int)w );
+			}
+		}
+		for(  size_t w = 0;  w < workers;  w++  ) {
+			int status;
+			if (wait(&status) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+				ok = false;
 			}
 		}
 	}
+	else
+#endif
+	{
+		for(size_t const k : todo) {
+			ok &= write_part(separate_dest, dats[k], parts[k], deps[k]);
+		}
+	}
+
+	if (!ok) {
+		throw obj_pak_exception_t("root_writer_t", "not all dat files could be compiled");
+	}
+
 	if (!separate) {
-		node->write(outfp);
-		delete node;
+		// now merge the parts in the order of the dat files
+		FILE* outfp = fopen(file.c_str(), "wb");
+		if (!outfp) {
+			dbg->fatal( "Write pak", "Cannot create destination file %s", dest );
+		}
+
+		if (debuglevel >= log_t::LEVEL_WARN) {
+			printf("Writing file %s\n", dest);
+		}
+		write_header(outfp);
+
+		const long start = ftell(outfp); // remember position for adding children
+		obj_node_info_t root;
+		root.nchildren = 0; // we will change this later
+		root.size = 0;
+		root.type = obj_root;
+		write_obj_node_info_t(outfp, root);
+
+		for(string const& part : parts) {
+			FILE* infp = fopen(part.c_str(), "rb");
+			uint32 version;
+			if (!infp || !skip_header(infp) || fread(&version, sizeof(version), 1, infp) != 1) {
+				dbg->fatal( "Write pak", "Cannot read %s", part.c_str() );
+			}
+			obj_node_info_t info;
+			obj_node_t::read_node( infp, info );
+			root.nchildren += info.nchildren;
+			copy_nodes(outfp, infp, info);
+			fclose(infp);
+		}
+
+		fseek(outfp, start, SEEK_SET);
+		write_obj_node_info_t(outfp, root);
 		fclose(outfp);
 	}
+
+	if (!incremental) {
+		for(string const& part : parts) {
+			remove(part.c_str());
+		}
+	}
 }
 
 
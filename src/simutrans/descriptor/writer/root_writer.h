@@ -8,6 +8,8 @@
 
 
 #include <string>
+#include <vector>
+#include <set>
 #include <cstdio>
 
 #include "obj_writer.h"
@@ -19,13 +21,44 @@ struct obj_node_info_t;
 
 class root_writer_t : public obj_writer_t
 {
+public:
+	/// a dat file and the path its image names are relative to
+	struct dat_file_t
+	{
+		std::string name;
+		std::string inpath;
+	};
+
 private:
 	static root_writer_t the_instance;
 
 	static std::string inpath;
 
+	/// number of processes compiling dat files in parallel
+	static int jobs;
+
+	/// reuse the compiled objects of unchanged dat files from the last run
+	static bool incremental;
+
+	/// files read and written for the current dat file (for the incremental mode)
+	static std::set<std::string> inputs;
+	static std::vector<std::string> outputs;
+
 	root_writer_t() { register_writer(false); }
 
+	/// compiles all objects of one dat file into @p outfp or, if outfp is NULL, into single files in @p dest
+	void write_dat(FILE* outfp, obj_node_t* node, const char* dest, const dat_file_t &dat);
+
+	/// compiles one dat file into @p part (or single files) and records its inputs in @p dep
+	bool write_part(const char* dest, const dat_file_t &dat, const std::string &part, const std::string &dep);
+
+	/// true if the inputs and outputs listed in @p dep are unchanged
+	static bool is_up_to_date(const dat_file_t &dat, const std::string &dep);
+	static void write_dep(const dat_file_t &dat, const std::string &dep);
+
+	/// compiles the dat files with several processes and/or incrementally, then merges the results
+	void write_parallel(const char* dest, const std::string &file, bool separate, const std::vector<dat_file_t> &dats);
+
 	void copy_nodes(FILE* outfp, FILE* infp, obj_node_info_t& info);
 	void write_header(FILE* fp);
 	void write_obj_node_info_t(FILE* outfp, const obj_node_info_t &root);
@@ -35,6 +68,12 @@ public:
 
 	static root_writer_t* instance() { return &the_instance; }
 
+	static void set_jobs(int n) { jobs = n; }
+	static void set_incremental(bool on) { incremental = on; }
+
+	/// records a file read while compiling the current dat file
+	static void add_input(const char* name) { inputs.insert(name); }
+
 	obj_type get_type() const OVERRIDE { return obj_root; }
 	const char *get_type_name() const OVERRIDE { return "root"; }
 
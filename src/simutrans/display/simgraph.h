@@ -135,6 +135,16 @@ bool display_load_font(const char *fname, bool reload = false);
 image_id get_image_count();
 void register_image(class image_t *);
 
+/// register_image() for an image whose player and transparent colours are known, see get_image_colour_flags()
+void register_image(class image_t *, uint8 colour_flags);
+uint8 get_image_colour_flags(image_id image);
+
+/// makes room for this many images, so the image table is not enlarged again and again while loading
+void display_reserve_images(image_id count);
+
+/// memory of the original images, of their zoomed and recoloured copies, and number of copies freed for the image_cache_budget
+void display_get_image_memory(size_t &base_bytes, size_t &cache_bytes, uint32 &freed);
+
 // delete all images above a certain number ...
 void display_free_all_images_above( image_id above );
 
@@ -105,6 +105,20 @@ void register_image(image_t* image)
 	image->imageid = 1;
 }
 
+void register_image(image_t* image, uint8)
+{
+	image->imageid = 1;
+}
+
+uint8 get_image_colour_flags(image_id)
+{
+	return 0;
+}
+
+void display_reserve_images(image_id)
+{
+}
+
 bool display_snapshot(const scr_rect &)
 {
 	return false;
@@ -408,6 +422,13 @@ image_id get_image_count()
 	return 0;
 }
 
+void display_get_image_memory(size_t &base_bytes, size_t &cache_bytes, uint32 &freed)
+{
+	base_bytes = 0;
+	cache_bytes = 0;
+	freed = 0;
+}
+
 #ifdef MULTI_THREAD
 void add_poly_clip(int, int, int, int, int  CLIP_NUM_DEF_NOUSE)
 {
@@ -22,8 +22,10 @@
 #include "../dataobj/translator.h"
 #include "../utils/unicode.h"
 #include "../simticker.h"
+#include "../utils/profiler.h"
 #include "../utils/simstring.h"
 #include "../utils/unicode.h"
+#include "../tpl/vector_tpl.h"
 #include "../io/raw_image.h"
 
 #include "../gui/simwin.h"
@@ -352,6 +354,8 @@ struct imd {
 	sint16 base_h; // height
 
 	PIXVAL* base_data; // original image data
+
+	uint32 last_used; // image_frame of the last drawing, for freeing the least recently used caches
 };
 
 // Flags for recoding
@@ -391,6 +395,19 @@ static image_id anz_images = 0;
  */
 static image_id alloc_images = 0;
 
+/*
+ * Image cache statistics and the frame counter for the least recently used images
+ */
+static uint32 image_frame = 0;
+static size_t image_base_bytes = 0;
+static size_t image_cache_bytes = 0;
+static uint32 image_cache_freed = 0;
+
+// check the cache size only every this many frames
+#define IMAGE_CACHE_CHECK_FRAMES (16)
+// never free caches of images drawn within this many frames
+#define IMAGE_CACHE_MIN_AGE (64)
+
 
 /*
  * Output framebuffer
@@ -941,11 +958,14 @@ void display_mark_img_dirty(image_id image, scr_coord_val xp, scr_coord_val yp)
  */
 static void rezoom()
 {
+	uint32 count = 0;
 	for(  image_id n = 0;  n < anz_images;  n++  ) {
 		if(  (images[n].recode_flags & FLAG_ZOOMABLE) != 0  &&  images[n].base_h > 0  ) {
 			images[n].recode_flags |= FLAG_REZOOM;
+			count++;
 		}
 	}
+	profiler_t::count( profiler_t::CNT_IMAGES_REZOOMED, count );
 }
 
 
@@ -1154,6 +1174,27 @@ PIXVAL inline zoomin_pixel(uint8 *p, uint8* pab, uint8 *prl, uint8* pdia)
 }
 
 
+/**
+ * Length of the original image data in PIXVAL
+ */
+static uint32 get_image_base_len(const image_id n)
+{
+	sint16 h = images[n].base_h;
+	PIXVAL *sp = images[n].base_data;
+
+	while(  h-- > 0  ) {
+		do {
+			// clear run + colored run + next clear run
+			sp++;
+			sp += (*sp)&(~TRANSPARENT_RUN); // MSVC crashes on (*sp)&(~TRANSPARENT_RUN) + 1 !!!
+			sp ++;
+		} while(  *sp  );
+		sp++;
+	}
+	return (uint32)(size_t)(sp - images[n].base_data);
+}
+
+
 /**
  * Convert base image data to actual image size
  * Uses averages of all sampled points to get the "real" value
@@ -1194,20 +1235,7 @@ static void rezoom_img(const image_id n)
 			images[n].w = images[n].base_w;
 			images[n].y = images[n].base_y;
 			images[n].h = images[n].base_h;
-			// recalculate length
-			sint16 h = images[n].base_h;
-			PIXVAL *sp = images[n].base_data;
-
-			while(  h-- > 0  ) {
-				do {
-					// clear run + colored run + next clear run
-					sp++;
-					sp += (*sp)&(~TRANSPARENT_RUN); // MSVC crashes on (*sp)&(~TRANSPARENT_RUN) + 1 !!!
-					sp ++;
-				} while(  *sp  );
-				sp++;
-			}
-			images[n].len = (uint32)(size_t)(sp - images[n].base_data);
+			images[n].len = get_image_base_len( n );
 			images[n].recode_flags &= ~FLAG_REZOOM;
 #ifdef MULTI_THREAD
 			pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
@@ -1639,6 +1667,94 @@ static void rezoom_img(const image_id n)
 }
 
 
+/**
+ * Memory used by the zoomed and recoloured copies of an image
+ */
+static size_t get_image_cache_bytes(const image_id n)
+{
+	uint32 copies = images[n].zoom_data != NULL;
+	for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
+		copies += images[n].data[i] != NULL;
+	}
+	return (size_t)copies * images[n].len * sizeof(PIXVAL);
+}
+
+
+/**
+ * Frees the zoomed and recoloured copies of an image, they are recreated
+ * from the original data on the next draw. Images fitted to a fixed size
+ * (display_fit_img_to_width) keep their zoomed data.
+ */
+static void free_image_cache(const image_id n)
+{
+	for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
+		if(  images[n].data[i] != NULL  ) {
+			free( images[n].data[i] );
+			images[n].data[i] = NULL;
+		}
+	}
+	images[n].player_flags = 0xFFFF;
+	if(  images[n].zoom_data != NULL  &&  (images[n].recode_flags & FLAG_ZOOMABLE)  ) {
+		free( images[n].zoom_data );
+		images[n].zoom_data = NULL;
+		images[n].recode_flags |= FLAG_REZOOM;
+	}
+}
+
+
+/**
+ * Updates the cache statistics and, if the copies exceed env_t::image_cache_budget,
+ * frees the least recently drawn ones down to 3/4 of the budget.
+ * Must not be called while images are drawn.
+ */
+static void check_image_cache()
+{
+	size_t bytes = 0;
+	for(  image_id n = 0;  n < anz_images;  n++  ) {
+		bytes += get_image_cache_bytes( n );
+	}
+	image_cache_bytes = bytes;
+
+	const size_t budget = (size_t)env_t::image_cache_budget << 20;
+	if(  budget == 0  ||  bytes <= budget  ) {
+		return;
+	}
+
+	vector_tpl<image_id> lru;
+	for(  image_id n = 0;  n < anz_images;  n++  ) {
+		if(  image_frame - images[n].last_used >= IMAGE_CACHE_MIN_AGE  &&  get_image_cache_bytes( n ) > 0  ) {
+			lru.append( n );
+		}
+	}
+	std::sort( lru.begin(), lru.end(), [](image_id a, image_id b) {
+		return image_frame - images[a].last_used > image_frame - images[b].last_used;
+	} );
+
+	const size_t target = budget - budget / 4;
+	uint32 freed = 0;
+	for(  image_id n : lru  ) {
+		if(  bytes <= target  ) {
+			break;
+		}
+		const size_t before = get_image_cache_bytes( n );
+		free_image_cache( n );
+		bytes -= before - get_image_cache_bytes( n );
+		freed++;
+	}
+	image_cache_bytes = bytes;
+	image_cache_freed += freed;
+	profiler_t::count( profiler_t::CNT_IMAGES_FREED, freed );
+}
+
+
+void display_get_image_memory(size_t &base_bytes, size_t &cache_bytes, uint32 &freed)
+{
+	base_bytes = image_base_bytes;
+	cache_bytes = image_cache_bytes;
+	freed = image_cache_freed;
+}
+
+
 // force a certain size on a image (for rescaling tool images)
 void display_fit_img_to_width( const image_id n, sint16 new_w )
 {
@@ -1792,7 +1908,57 @@ void display_set_player_color_scheme(const int player, const uint8 col1, const u
 
 
 
+void display_reserve_images(image_id count)
+{
+	if(  count > alloc_images  ) {
+		images = REALLOC(images, imd, count);
+		alloc_images = count;
+	}
+}
+
+
+uint8 get_image_colour_flags(image_id image)
+{
+	return image < anz_images ? images[image].recode_flags & (FLAG_HAS_PLAYER_COLOR | FLAG_HAS_TRANSPARENT_COLOR) : 0;
+}
+
+
 void register_image(image_t *image_in)
+{
+	uint8 colour_flags = 0;
+
+	// find out if there are really player colors
+	if(  image_in->len > 0  ) {
+		for(  PIXVAL *src = image_in->data, y = 0;  y < image_in->h;  ++y  ) {
+			uint16 runlen;
+
+			// decode line
+			runlen = *src++;
+			do {
+				// clear run .. nothing to do
+				runlen = *src++;
+				if(  runlen & TRANSPARENT_RUN  ) {
+					colour_flags |= FLAG_HAS_TRANSPARENT_COLOR;
+					runlen &= ~TRANSPARENT_RUN;
+				}
+				// no this many color pixel
+				while(  runlen--  ) {
+					// get rgb components
+					PIXVAL s = *src++;
+					if(  s>=0x8000  &&  s<0x8010  ) {
+						colour_flags |= FLAG_HAS_PLAYER_COLOR;
+					}
+				}
+				runlen = *src++;
+			} while(  runlen!=0  ); // end of row: runlen == 0
+		}
+	}
+
+	register_image( image_in, colour_flags );
+}
+
+
+void register_image(image_t *image_in, uint8 colour_flags)
 {
 	struct imd *image;
 
@@ -1826,43 +1992,19 @@ void register_image(image_t *image_in)
 	image->y = image_in->y;
 	image->h = image_in->h;
 
-	image->recode_flags = FLAG_REZOOM;
+	image->recode_flags = FLAG_REZOOM | colour_flags;
 	if(  image_in->zoomable  ) {
 		image->recode_flags |= FLAG_ZOOMABLE;
 	}
 	image->player_flags = 0xFFFF; // recode all player colors
 
-	// find out if there are really player colors
-	for(  PIXVAL *src = image_in->data, y = 0;  y < image_in->h;  ++y  ) {
-		uint16 runlen;
-
-		// decode line
-		runlen = *src++;
-		do {
-			// clear run .. nothing to do
-			runlen = *src++;
-			if(  runlen & TRANSPARENT_RUN  ) {
-				image->recode_flags |= FLAG_HAS_TRANSPARENT_COLOR;
-				runlen &= ~TRANSPARENT_RUN;
-			}
-			// no this many color pixel
-			while(  runlen--  ) {
-				// get rgb components
-				PIXVAL s = *src++;
-				if(  s>=0x8000  &&  s<0x8010  ) {
-					image->recode_flags |= FLAG_HAS_PLAYER_COLOR;
-				}
-			}
-			runlen = *src++;
-		} while(  runlen!=0  ); // end of row: runlen == 0
-	}
-
 	for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
 		image->data[i] = NULL;
 	}
 
 	image->zoom_data = NULL;
 	image->len = image_in->len;
+	image->last_used = image_frame;
 
 	image->base_x = image_in->x;
 	image->base_w = image_in->w;
@@ -1871,9 +2013,8 @@ void register_image(image_t *image_in)
 
 	// since we do not recode them, we can work with the original data
 	image->base_data = image_in->data;
-
-	// now find out, it contains player colors
-
+	// same length as subtracted in display_free_all_images_above()
+	image_base_bytes += get_image_base_len( image_in->imageid ) * sizeof(PIXVAL);
 }
 
 
@@ -1891,6 +2032,7 @@ void display_free_all_images_above( image_id above )
 				free( images[anz_images].data[i] );
 			}
 		}
+		image_base_bytes -= get_image_base_len( anz_images ) * sizeof(PIXVAL);
 	}
 }
 
@@ -2228,6 +2370,8 @@ void display_img_aux(const image_id n, scr_coord_val xp, scr_coord_val yp, const
 		// need to go to nightmode and or re-zoomed?
 		PIXVAL *sp;
 
+		images[n].last_used = image_frame;
+
 		if(  use_player > 0  ) {
 			// player colour images are rezoomed/recoloured in display_color_img
 			sp = images[n].data[use_player];
@@ -2557,6 +2701,7 @@ void display_color_img(const image_id n, scr_coord_val xp, scr_coord_val yp, sin
 	if(  n < anz_images  ) {
 		// do we have to use a player nr?
 		const sint8 player_nr = (images[n].recode_flags & FLAG_HAS_PLAYER_COLOR) * player_nr_raw;
+		images[n].last_used = image_frame;
 		// first: size check
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
@@ -2984,6 +3129,7 @@ void display_rezoomed_img_blend(const image_id n, scr_coord_val xp, scr_coord_va
 {
 	if(  n < anz_images  ) {
 		// need to go to nightmode and or rezoomed?
+		images[n].last_used = image_frame;
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
 			recode_img( n, 0 );
@@ -3055,6 +3201,7 @@ void display_rezoomed_img_alpha(const image_id n, const image_id alpha_n, const
 {
 	if(  n < anz_images  &&  alpha_n < anz_images  ) {
 		// need to go to nightmode and or rezoomed?
+		images[n].last_used = image_frame;
 		if(  (images[n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( n );
 			recode_img( n, 0 );
@@ -3062,6 +3209,7 @@ void display_rezoomed_img_alpha(const image_id n, const image_id alpha_n, const
 		else if(  (images[n].player_flags & 1)  ) {
 			recode_img( n, 0 );
 		}
+		images[alpha_n].last_used = image_frame;
 		if(  (images[alpha_n].recode_flags & FLAG_REZOOM)  ) {
 			rezoom_img( alpha_n );
 		}
@@ -4299,6 +4447,10 @@ static inline uint32 get_lowest_set_bit(uint32 val)
  */
 void display_flush_buffer()
 {
+	if(  (++image_frame % IMAGE_CACHE_CHECK_FRAMES) == 0  ) {
+		check_image_cache();
+	}
+
 #ifdef USE_SOFTPOINTER
 	ex_ord_update_mx_my();
 
@@ -21,6 +21,7 @@
 #include "../ground/wasser.h"
 #include "../dataobj/environment.h"
 #include "../obj/zeiger.h"
+#include "../utils/profiler.h"
 #include "../utils/simrandom.h"
 
 uint16 win_get_statusbar_height(); // simwin.h
@@ -94,6 +95,7 @@ static bool can_multithreading = true;
 
 void main_view_t::display(bool force_dirty)
 {
+	PROFILE_SCOPE(SEC_DISPLAY);
 	const uint32 rs = get_random_seed();
 
 #if COLOUR_DEPTH != 0
@@ -281,12 +283,11 @@ void main_view_t::display(bool force_dirty)
 			const sint16 xpos = x * (IMG_SIZE / 2) + const_x_off;
 
 			if(  xpos+IMG_SIZE>0  ) {
-				const planquadrat_t *plan=welt->access(i,j);
-				if(plan  &&  plan->get_kartenboden()) {
-					const grund_t *gr = plan->get_kartenboden();
-					sint16 yypos = ypos - tile_raster_scale_y( min(gr->get_hoehe(),hmax_ground)*TILE_HEIGHT_STEP, IMG_SIZE);
+				const surface_t::tile_summary_t *ts = welt->get_tile_summary(koord(i,j));
+				if(ts  &&  ts->ground_typ) {
+					sint16 yypos = ypos - tile_raster_scale_y( min(ts->hoehe,hmax_ground)*TILE_HEIGHT_STEP, IMG_SIZE);
 					if(  yypos-IMG_SIZE < clip_rr.get_bottom()  &&  yypos+IMG_SIZE>=clip_rr.y  ) {
-						plan->display_overlay( xpos, yypos );
+						welt->access_nocheck(i,j)->display_overlay( xpos, yypos );
 						plotted = true;
 					}
 				}
@@ -399,9 +400,12 @@ void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max
 
 			if(  xpos + IMG_SIZE > lt.x  ) {
 				const koord pos(i, j);
-				if(  grund_t* const kb = welt->lookup_kartenboden(pos)  ) {
-					const sint16 yypos = ypos - tile_raster_scale_y( min( kb->get_hoehe(), hmax_ground ) * TILE_HEIGHT_STEP, IMG_SIZE );
+				// culling uses the tile summary, the ground is only touched when it is drawn
+				const surface_t::tile_summary_t *ts = welt->get_tile_summary(pos);
+				if(  ts  &&  ts->ground_typ  ) {
+					const sint16 yypos = ypos - tile_raster_scale_y( min( ts->hoehe, hmax_ground ) * TILE_HEIGHT_STEP, IMG_SIZE );
 					if(  yypos - IMG_SIZE < lt.y + wh.y  &&  yypos + IMG_SIZE > lt.y  ) {
+						grund_t* const kb = welt->lookup_kartenboden_nocheck(pos);
 #ifdef MULTI_THREAD
 						bool force_show_grid = false;
 						if(  env_t::hide_under_cursor  ) {
@@ -436,7 +440,7 @@ void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max
 					}
 					// not on screen? We still might need to plot the border ...
 					else if(  env_t::draw_earth_border  &&  (pos.x-welt->get_size().x+1 == 0  ||  pos.y-welt->get_size().y+1 == 0)  ) {
-						kb->display_border( xpos, yypos, IMG_SIZE  CLIP_NUM_PAR);
+						welt->lookup_kartenboden_nocheck(pos)->display_border( xpos, yypos, IMG_SIZE  CLIP_NUM_PAR);
 					}
 				}
 				else {
@@ -574,6 +574,8 @@ void grund_t::take_obj_from(grund_t* other_gr)
 		flags |= has_way2;
 		other_gr->clear_flag(has_way2);
 	}
+	update_tile_summary();
+	other_gr->update_tile_summary();
 }
 
 
@@ -671,6 +673,7 @@ void grund_t::set_halt(halthandle_t halt)
 		flags &= ~is_halt_flag;
 		flags |= dirty;
 	}
+	update_tile_summary();
 }
 
 
@@ -681,6 +684,14 @@ halthandle_t grund_t::get_halt() const
 }
 
 
+void grund_t::update_tile_summary() const
+{
+	if(  flags & is_kartenboden  ) {
+		welt->update_tile_summary( this );
+	}
+}
+
+
 // ----------------------- image calculation stuff from here ------------------
 
 
@@ -753,7 +764,7 @@ static inline uint8 get_back_image_from_diff(sint8 h1, sint8 h2)
 void grund_t::mark_image_dirty() const
 {
 	// see obj_t::mark_image_dirty
-	if(imageid!=IMG_EMPTY) {
+	if(imageid!=IMG_EMPTY  &&  !welt->is_parallel_image_change()) {
 		const scr_coord scr_pos = welt->get_viewport()->get_screen_coord(koord3d(pos.get_2d(),get_disp_height()));
 		display_mark_img_dirty( imageid, scr_pos.x, scr_pos.y );
 	}
@@ -1913,6 +1924,7 @@ sint64 grund_t::neuen_weg_bauen(weg_t *weg, ribi_t::ribi ribi, player_t *player)
 
 		// may result in a crossing, but the wegebauer will recalc all images anyway
 		weg->calc_image();
+		update_tile_summary();
 	}
 	return cost;
 }
@@ -1963,6 +1975,7 @@ sint32 grund_t::weg_entfernen(waytype_t wegtyp, bool ribi_rem)
 		else {
 			flags &= ~has_way1;
 		}
+		update_tile_summary();
 
 		calc_image();
 		minimap_t::get_instance()->calc_map_pixel(get_pos().get_2d());
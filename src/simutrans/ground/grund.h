@@ -232,6 +232,9 @@ protected:
 	// this is the real image calculation, called for the actual ground image
 	virtual void calc_image_internal(const bool calc_only_snowline_change) = 0;
 
+	/// copies height, slope, ways and halt to the tile summary of the world (only for the ground level)
+	void update_tile_summary() const;
+
 public:
 	enum typ {
 		boden = 1,
@@ -272,14 +275,21 @@ public:
 	/**
 	* Updates snowline dependent grund_t (and derivatives) - none are season dependent
 	* Updates season and or snowline dependent objects
+	* @param defer_tree_events leave trees which plant or die for check_season_tree_events()
+	* @return true if trees were left
 	*/
-	void check_season_snowline(const bool season_change, const bool snowline_change)
+	bool check_season_snowline(const bool season_change, const bool snowline_change, const bool defer_tree_events = false)
 	{
 		if(  snowline_change  ) {
 			calc_image_internal( snowline_change );
 		}
 
-		objlist.check_season( season_change  &&  !snowline_change );
+		return objlist.check_season( season_change  &&  !snowline_change, defer_tree_events );
+	}
+
+	void check_season_tree_events(const bool season_change, const bool snowline_change)
+	{
+		objlist.check_season_tree_events( season_change  &&  !snowline_change );
 	}
 
 	/**
@@ -418,11 +428,23 @@ public:
 	*/
 	inline const koord3d& get_pos() const { return pos; }
 
-	inline void set_pos(koord3d newpos) { pos = newpos;}
+	inline void set_pos(koord3d newpos)
+	{
+		pos = newpos;
+		if(  flags & is_kartenboden  ) {
+			update_tile_summary();
+		}
+	}
 
 	// slope are now maintained locally
 	slope_t::type get_grund_hang() const { return slope; }
-	void set_grund_hang(slope_t::type sl) { slope = sl; }
+	void set_grund_hang(slope_t::type sl)
+	{
+		slope = sl;
+		if(  flags & is_kartenboden  ) {
+			update_tile_summary();
+		}
+	}
 
 	/**
 	 * some ground tiles may be part of halts.
@@ -462,7 +484,13 @@ public:
 		}
 	}
 
-	void set_hoehe(sint8 h) { pos.z = h;}
+	void set_hoehe(sint8 h)
+	{
+		pos.z = h;
+		if(  flags & is_kartenboden  ) {
+			update_tile_summary();
+		}
+	}
 
 	// Helper functions for underground modes
 	//
@@ -603,6 +631,7 @@ public:
 	obj_t * obj_bei(uint8 n) const { return objlist.bei(n); }
 	uint8  obj_count() const { return objlist.get_top()-offsets[flags/has_way1]; }
 	uint8 get_top() const {return objlist.get_top();}
+	size_t get_objlist_memory() const { return objlist.get_memory(); }
 
 	// moves all object from the old to the new grund_t
 	void take_obj_from( grund_t *gr);
@@ -166,7 +166,7 @@ citylist_frame_t::citylist_frame_t() :
 	chart.set_min_size(scr_size(0, 8*LINESPACE));
 
 	for (int i = 0; i<karte_t::MAX_WORLD_COST; i++) {
-		sint16 curve = chart.add_curve(color_idx_to_rgb(hist_type_color[i]), welt->get_finance_history_year(), karte_t::MAX_WORLD_COST, i, MAX_WORLD_HISTORY_YEARS, hist_type_type[i], false, true, (i==1) ? 1 : 0 );
+		sint16 curve = chart.add_curve(color_idx_to_rgb(hist_type_color[i]), welt->get_finance_history_year(), i, hist_type_type[i], false, true, (i==1) ? 1 : 0 );
 		// add button
 		buttons[i] = container_year.new_component<button_t>();
 		buttons[i]->init(button_t::box_state_automatic | button_t::flexible, hist_type[i]);
@@ -182,7 +182,7 @@ citylist_frame_t::citylist_frame_t() :
 	mchart.set_background(SYSCOL_CHART_BACKGROUND);
 	mchart.set_min_size(scr_size(0, 8*LINESPACE));
 	for (int i = 0; i<karte_t::MAX_WORLD_COST; i++) {
-		sint16 curve = mchart.add_curve(color_idx_to_rgb(hist_type_color[i]), welt->get_finance_history_month(), karte_t::MAX_WORLD_COST, i, MAX_WORLD_HISTORY_MONTHS, hist_type_type[i], false, true, (i==1) ? 1 : 0 );
+		sint16 curve = mchart.add_curve(color_idx_to_rgb(hist_type_color[i]), welt->get_finance_history_month(), i, hist_type_type[i], false, true, (i==1) ? 1 : 0 );
 
 		// add button
 		container_month.add_component(buttons[i]);
@@ -198,7 +198,7 @@ citylist_frame_t::citylist_frame_t() :
 void citylist_frame_t::update_label()
 {
 	citizens.buf().append( translator::translate("Total inhabitants:") );
-	citizens.buf().append( welt->get_finance_history_month()[0], 0 );
+	citizens.buf().append( welt->get_finance_history_month(0, karte_t::WORLD_CITIZENS), 0 );
 	citizens.update();
 }
 
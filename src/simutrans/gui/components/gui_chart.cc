@@ -75,6 +75,7 @@ uint32 gui_chart_t::add_curve(PIXVAL color, const sint64 *values, int size, int
 	}
 	new_curve.precision = precision;
 	new_curve.convert = proc;
+	new_curve.head = NULL;
 	curves.append(new_curve);
 	return curves.get_count()-1;
 }
@@ -191,7 +192,7 @@ void gui_chart_t::draw(scr_coord offset)
 			// for each curve iterate through all elements and display curve
 			for (int i=0;i<c.elements;i++) {
 
-				tmp = c.values[i*c.size+c.offset];
+				tmp = get_value( c, i );
 				// convert value where necessary
 				if(  c.convert  ) {
 					tmp = c.convert(tmp);
@@ -261,7 +262,7 @@ void gui_chart_t::calc_gui_chart_values(sint64 *baseline, double *scale, char *c
 	for(curve_t const& c : curves) {
 		if(  c.show  ) {
 			for(  int i=0;  i<c.elements;  i++  ) {
-				tmp = c.values[i*c.size+c.offset];
+				tmp = get_value( c, i );
 				// convert value where necessary
 				if(  c.convert  ) {
 					tmp = c.convert(tmp);
@@ -10,6 +10,7 @@
 #include "../../simtypes.h"
 #include "gui_component.h"
 #include "../../tpl/slist_tpl.h"
+#include "../../tpl/history_tpl.h"
 
 
 /**
@@ -60,6 +61,19 @@ public:
 	 */
 	uint32 add_curve(PIXVAL color, const sint64 *values, int size, int offset, int elements, int type, bool show, bool show_value, int precision, convert_proc proc=NULL);
 
+	/**
+	 * Adds a curve of one statistic of a history
+	 * @param history  must exist as long as the curve is shown
+	 * @param stat     statistic to show
+	 */
+	template<int PERIODS, int STATS>
+	uint32 add_curve(PIXVAL color, const history_tpl<sint64, PERIODS, STATS> &history, int stat, int type, bool show, bool show_value, int precision, convert_proc proc=NULL)
+	{
+		const uint32 id = add_curve( color, history.get_stat_values(stat), 1, 0, PERIODS, type, show, show_value, precision, proc );
+		curves.back().head = history.get_head();
+		return id;
+	}
+
 	void remove_curves() { curves.clear(); }
 
 	/**
@@ -107,8 +121,20 @@ private:
 		const char* suffix;
 		int precision;        // how many numbers ...
 		convert_proc convert; // procedure for converting supplied values before use
+		const uint8 *head;    // for a history: index of the current period in values
 	};
 
+	static sint64 get_value(const curve_t &c, int i)
+	{
+		if(  c.head  ) {
+			i += *c.head;
+			if(  i >= c.elements  ) {
+				i -= c.elements;
+			}
+		}
+		return c.values[i*c.size+c.offset];
+	}
+
 	slist_tpl <curve_t> curves;
 
 	int x_elements, y_elements;
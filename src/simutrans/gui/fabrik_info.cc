@@ -332,8 +332,8 @@ void fabrik_info_t::update_components()
 		all_suppliers.set_margin(scr_size(0,0), scr_size(0,D_V_SPACE));
 		all_suppliers.add_component(&highlight_suppliers);
 
-		for(koord k : fab->get_suppliers() ) {
-			if(  const fabrik_t *src = fabrik_t::get_fab(k)  ) {
+		for(const fabrik_t *src : fab->get_supplier_fabs() ) {
+			if(  src  ) {
 				all_suppliers.new_component<gui_factory_connection_t>(fab, src->get_pos().get_2d(), true);
 			}
 		}
@@ -175,7 +175,7 @@ void factory_chart_t::set_factory(const fabrik_t *_factory)
 			for (uint32 g = 0; g < input_count; ++g) {
 				goods_cont.new_component<gui_label_t>(input[g].get_typ()->get_name());
 				for (int s = 0; s < MAX_FAB_GOODS_STAT; ++s) {
-					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + (s * 3) / 2), input[g].get_stats(), MAX_FAB_GOODS_STAT, s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
+					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + (s * 3) / 2), input[g].get_stats(), s, false, false, true, 0, goods_convert[s]);
 
 					button_t* b = goods_cont.new_component<button_t>();
 					b->init(button_t::box_state_automatic | button_t::flexible, input_type[s]);
@@ -200,7 +200,7 @@ void factory_chart_t::set_factory(const fabrik_t *_factory)
 			for (uint32 g = 0; g < output_count; ++g) {
 				goods_cont.new_component<gui_label_t>(output[g].get_typ()->get_name());
 				for (int s = 0; s < 3; ++s) {
-					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + s * 2), output[g].get_stats(), MAX_FAB_GOODS_STAT, s, MAX_MONTH, false, false, true, 0, goods_convert[s]);
+					uint16 curve = goods_chart.add_curve(color_idx_to_rgb(goods_color[count % MAX_GOODS_COLOR] + s * 2), output[g].get_stats(), s, false, false, true, 0, goods_convert[s]);
 
 					button_t* b = goods_cont.new_component<button_t>();
 					b->init(button_t::box_state_automatic | button_t::flexible, output_type[s]);
@@ -235,7 +235,7 @@ void factory_chart_t::set_factory(const fabrik_t *_factory)
 			else if (prod_cell_button[cell] < MAX_FAB_STAT) {
 				uint8 s = prod_cell_button[cell];
 				// add curve
-				uint16 curve = prod_chart.add_curve( color_idx_to_rgb(prod_color[s]), factory->get_stats(), MAX_FAB_STAT, s, MAX_MONTH, (2<=s  &&  s<=4) ? gui_chart_t::PERCENT : gui_chart_t::STANDARD, false, true, 0, prod_convert[s] );
+				uint16 curve = prod_chart.add_curve( color_idx_to_rgb(prod_color[s]), factory->get_stats(), s, (2<=s  &&  s<=4) ? gui_chart_t::PERCENT : gui_chart_t::STANDARD, false, true, 0, prod_convert[s] );
 				// only show buttons, if the is something to do ...
 				if(
 					(s==FAB_BOOST_ELECTRIC  &&  (factory->get_desc()->is_electricity_producer()  ||  factory->get_desc()->get_electric_boost()==0))  ||
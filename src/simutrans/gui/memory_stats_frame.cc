@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "memory_stats_frame.h"
+#include "components/gui_divider.h"
+
+#include "../world/simworld.h"
+#include "../dataobj/translator.h"
+
+
+memory_stats_frame_t::memory_stats_frame_t() :
+	gui_frame_t( translator::translate("Memory usage") )
+{
+	set_table_layout(2,0);
+	set_alignment(ALIGN_TOP);
+
+	add_table(1,0);
+	{
+		add_table(3,0);
+		{
+			new_component<gui_empty_t>();
+			new_component<gui_label_t>("count", SYSCOL_TEXT, gui_label_t::right);
+			new_component<gui_label_t>("KB", SYSCOL_TEXT, gui_label_t::right);
+			for(  int c = 0;  c < memory_stats_t::MAX_CATEGORIES;  c++  ) {
+				new_component<gui_label_t>( memory_stats_t::get_category_name( (memory_stats_t::category_t)c ) );
+				for(  int i = 0;  i < 2;  i++  ) {
+					lb_category[c][i].set_align( gui_label_t::right );
+					add_component( &lb_category[c][i] );
+				}
+			}
+
+			new_component<gui_label_t>("total");
+			new_component<gui_empty_t>();
+			lb_total.set_align( gui_label_t::right );
+			add_component( &lb_total );
+
+			new_component<gui_label_t>("per tile [bytes]");
+			new_component<gui_empty_t>();
+			lb_per_tile.set_align( gui_label_t::right );
+			add_component( &lb_per_tile );
+		}
+		end_table();
+
+		new_component<gui_divider_t>();
+
+		// the pools hold memory that is already counted above
+		add_table(2,0);
+		{
+			for(  int p = 0;  p < memory_stats_t::MAX_POOLS;  p++  ) {
+				new_component<gui_label_t>( memory_stats_t::get_pool_name( (memory_stats_t::pool_t)p ) );
+				lb_pool[p].set_align( gui_label_t::right );
+				add_component( &lb_pool[p] );
+			}
+		}
+		end_table();
+
+		new_component<gui_divider_t>();
+
+		add_table(2,1);
+		{
+			bt_refresh.init( button_t::roundbox, "Refresh" );
+			bt_refresh.add_listener( this );
+			add_component( &bt_refresh );
+
+			bt_log.init( button_t::roundbox, "Write to log" );
+			bt_log.add_listener( this );
+			add_component( &bt_log );
+		}
+		end_table();
+	}
+	end_table();
+
+	add_table(3,0);
+	{
+		new_component<gui_empty_t>();
+		new_component<gui_label_t>("count", SYSCOL_TEXT, gui_label_t::right);
+		new_component<gui_label_t>("KB", SYSCOL_TEXT, gui_label_t::right);
+		for(  int t = 0;  t < memory_stats_t::MAX_OBJ_TYPES;  t++  ) {
+			if(  const char *name = memory_stats_t::get_obj_type_name( t )  ) {
+				new_component<gui_label_t>( name );
+				for(  int i = 0;  i < 2;  i++  ) {
+					lb_obj_type[t][i].set_align( gui_label_t::right );
+					add_component( &lb_obj_type[t][i] );
+				}
+			}
+		}
+	}
+	end_table();
+
+	update_labels();
+
+	reset_min_windowsize();
+	set_windowsize(get_min_windowsize());
+}
+
+
+void memory_stats_frame_t::update_labels()
+{
+	memory_stats_t::census_t census;
+	memory_stats_t::collect( welt, census );
+
+	for(  int c = 0;  c < memory_stats_t::MAX_CATEGORIES;  c++  ) {
+		lb_category[c][0].buf().printf( "%u", census.category[c].count );
+		lb_category[c][1].buf().printf( "%llu", (unsigned long long)(census.category[c].bytes >> 10) );
+		lb_category[c][0].update();
+		lb_category[c][1].update();
+	}
+
+	const uint64 total = census.get_total_bytes();
+	lb_total.buf().printf( "%llu", (unsigned long long)(total >> 10) );
+	lb_total.update();
+	lb_per_tile.buf().printf( "%llu", (unsigned long long)(census.tiles ? total / census.tiles : 0) );
+	lb_per_tile.update();
+
+	for(  int p = 0;  p < memory_stats_t::MAX_POOLS;  p++  ) {
+		lb_pool[p].buf().printf( "%llu KB", (unsigned long long)(census.pool_bytes[p] >> 10) );
+		lb_pool[p].update();
+	}
+
+	for(  int t = 0;  t < memory_stats_t::MAX_OBJ_TYPES;  t++  ) {
+		lb_obj_type[t][0].buf().printf( "%u", census.obj_type[t].count );
+		lb_obj_type[t][1].buf().printf( "%llu", (unsigned long long)(census.obj_type[t].bytes >> 10) );
+		lb_obj_type[t][0].update();
+		lb_obj_type[t][1].update();
+	}
+}
+
+
+bool memory_stats_frame_t::action_triggered( gui_action_creator_t *comp, value_t )
+{
+	if(  comp == &bt_refresh  ) {
+		update_labels();
+	}
+	else if(  comp == &bt_log  ) {
+		memory_stats_t::log_summary( welt );
+	}
+	return true;
+}
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef GUI_MEMORY_STATS_FRAME_H
+#define GUI_MEMORY_STATS_FRAME_H
+
+
+#include "gui_frame.h"
+#include "components/action_listener.h"
+#include "components/gui_button.h"
+#include "components/gui_label.h"
+#include "../utils/memory_stats.h"
+
+
+/**
+ * Shows the memory used per category and per object type, as counted by
+ * memory_stats_t. The census walks the whole map, so it is only taken
+ * when the window opens and on refresh.
+ */
+class memory_stats_frame_t : public gui_frame_t, private action_listener_t
+{
+	gui_label_buf_t lb_category[memory_stats_t::MAX_CATEGORIES][2];
+	gui_label_buf_t lb_total, lb_per_tile;
+	gui_label_buf_t lb_pool[memory_stats_t::MAX_POOLS];
+	gui_label_buf_t lb_obj_type[memory_stats_t::MAX_OBJ_TYPES][2];
+
+	button_t bt_refresh, bt_log;
+
+	void update_labels();
+
+public:
+	memory_stats_frame_t();
+
+	bool action_triggered(gui_action_creator_t*, value_t) OVERRIDE;
+};
+
+#endif
@@ -53,6 +53,19 @@ static sint32 max_service = 1;
 
 static sint32 max_building_level = 0;
 
+// full recalculations are done in bands of this many pixel rows
+#define MAP_BAND_ROWS (8)
+
+// maps of this many other modes are kept
+#define MAX_MAP_LAYERS (3)
+
+// changed tiles of kept maps are noted in blocks of 1<<DIRTY_BLOCK_BITS tiles
+#define DIRTY_BLOCK_BITS (4)
+
+// only pixel rows in this range are changed by the current thread
+static thread_local sint32 clip_rows_min = 0;
+static thread_local sint32 clip_rows_max = 0x7FFF;
+
 minimap_t * minimap_t::single_instance = NULL;
 karte_ptr_t minimap_t::world;
 minimap_t::MAP_DISPLAY_MODE minimap_t::mode = MAP_TOWN;
@@ -607,7 +620,7 @@ PIXVAL minimap_t::calc_severity_color_log(sint32 amount, sint32 max_value)
 
 void minimap_t::set_map_color_clip( sint16 x, sint16 y, PIXVAL color )
 {
-	if(  0<=x  &&  (uint16)x < map_data->get_width()  &&  0<=y  &&  (uint16)y < map_data->get_height()  ) {
+	if(  0<=x  &&  (uint16)x < map_data->get_width()  &&  clip_rows_min<=y  &&  y < clip_rows_max  &&  (uint16)y < map_data->get_height()  ) {
 		map_data->at( x, y ) = color;
 	}
 }
@@ -649,7 +662,7 @@ void minimap_t::set_map_color(koord k_, const PIXVAL color)
 	}
 	else {
 		for(  sint32 x = max(0,c.x);  x < zoom_in+c.x  &&  (uint32)x < map_data->get_width();  x++  ) {
-			for(  sint32 y = max(0,c.y);  y < zoom_in+c.y  &&  (uint32)y < map_data->get_height();  y++  ) {
+			for(  sint32 y = max(clip_rows_min,c.y);  y < zoom_in+c.y  &&  y < clip_rows_max  &&  (uint32)y < map_data->get_height();  y++  ) {
 				map_data->at(x, y) = color;
 			}
 		}
@@ -959,9 +972,23 @@ void minimap_t::calc_map_pixel(const koord k)
 {
 	// no pixels visible, so noting to calculate
 	if(!is_visible) {
+		// but changes are not tracked anymore
+		if(  map_valid  ||  !layers.empty()  ) {
+			invalidate_layers();
+			map_valid = false;
+		}
 		return;
 	}
 
+	if(  !layers.empty()  ) {
+		mark_layers_dirty(k);
+	}
+	calc_tile_pixel(k);
+}
+
+
+void minimap_t::calc_tile_pixel(const koord k)
+{
 	// always use to uppermost ground
 	const planquadrat_t *plan=world->access(k);
 	if(plan==NULL  ||  plan->get_boden_count()==0) {
@@ -1068,7 +1095,127 @@ void minimap_t::calc_map_size()
 }
 
 
+bool minimap_t::layer_key_t::operator==(const layer_key_t &other) const
+{
+	return mode == other.mode  &&  off == other.off  &&  size == other.size  &&
+		zoom_in == other.zoom_in  &&  zoom_out == other.zoom_out  &&  isometric == other.isometric  &&
+		underground_mode == other.underground_mode  &&  underground_level == other.underground_level;
+}
+
+
+minimap_t::layer_key_t minimap_t::get_layer_key() const
+{
+	layer_key_t key;
+	// only the modes, which change the pixels and not just the overlays
+	key.mode = mode & (~MAP_MODE_FLAGS | MAP_CLIMATES | MAP_HIDE_CONTOUR | MAP_PAX_DEST);
+	key.off = new_off;
+	key.size = new_size;
+	key.zoom_in = zoom_in;
+	key.zoom_out = zoom_out;
+	key.isometric = isometric;
+	key.underground_mode = grund_t::underground_mode;
+	key.underground_level = grund_t::underground_level;
+	return key;
+}
+
+
+void minimap_t::invalidate_layers()
+{
+	for(layer_t *layer : layers) {
+		delete layer;
+	}
+	layers.clear();
+}
+
+
+void minimap_t::mark_layers_dirty(koord k)
+{
+	if(  !world->is_within_limits(k)  ) {
+		return;
+	}
+	for(layer_t *layer : layers) {
+		uint8 &dirty = layer->dirty->at( k.x >> DIRTY_BLOCK_BITS, k.y >> DIRTY_BLOCK_BITS );
+		if(  !dirty  ) {
+			dirty = 1;
+			layer->dirty_count++;
+		}
+	}
+}
+
+
+void minimap_t::update_map()
+{
+	const layer_key_t key = get_layer_key();
+
+	if(  map_data  &&  map_valid  &&  !(key == map_key)  &&  (map_key.mode & MAP_PAX_DEST) == 0  ) {
+		// keep the current map to switch back to it later
+		layer_t *layer = new layer_t;
+		layer->key = map_key;
+		layer->data = map_data;
+		layer->dirty = new array2d_tpl<uint8>( (world->get_size().x >> DIRTY_BLOCK_BITS) + 1, (world->get_size().y >> DIRTY_BLOCK_BITS) + 1 );
+		layer->dirty->init( 0 );
+		layer->dirty_count = 0;
+		layers.insert_at( 0, layer );
+		if(  layers.get_count() > MAX_MAP_LAYERS  ) {
+			delete layers.pop_back();
+		}
+		map_data = NULL;
+		map_valid = false;
+	}
+
+	for(  uint32 i = 0;  i < layers.get_count();  i++  ) {
+		layer_t *layer = layers[i];
+		if(  !(layer->key == key)  ) {
+			continue;
+		}
+		layers.remove_at( i );
+
+		const uint32 blocks = layer->dirty->get_width() * layer->dirty->get_height();
+		if(  layer->dirty_count * 4 > blocks  ) {
+			// too much changed, faster to start over
+			delete layer;
+			break;
+		}
+
+		delete map_data;
+		map_data = layer->data;
+		layer->data = NULL;
+		cur_off = new_off;
+		cur_size = new_size;
+		needs_redraw = false;
+		is_visible = true;
+		map_key = key;
+		map_valid = true;
+
+		// update only the changed blocks
+		for(  uint32 by = 0;  by < layer->dirty->get_height();  by++  ) {
+			for(  uint32 bx = 0;  bx < layer->dirty->get_width();  bx++  ) {
+				if(  layer->dirty->at( bx, by )  ) {
+					koord k;
+					for(  k.y = by << DIRTY_BLOCK_BITS;  k.y < (sint16)((by + 1) << DIRTY_BLOCK_BITS);  k.y++  ) {
+						for(  k.x = bx << DIRTY_BLOCK_BITS;  k.x < (sint16)((bx + 1) << DIRTY_BLOCK_BITS);  k.x++  ) {
+							calc_tile_pixel( k );
+						}
+					}
+				}
+			}
+		}
+		delete layer;
+		return;
+	}
+
+	compute_map();
+}
+
+
 void minimap_t::calc_map()
+{
+	invalidate_layers();
+	compute_map();
+}
+
+
+void minimap_t::compute_map()
 {
 	// only use bitmap size like screen size
 	scr_size minimap_size ( min( get_size().w, new_size.w ), min( get_size().h, new_size.h ) );
@@ -1081,36 +1228,83 @@ void minimap_t::calc_map()
 	cur_size = new_size;
 	needs_redraw = false;
 	is_visible = true;
+	map_key = get_layer_key();
+	map_valid = true;
+
+	if(isometric) {
+		map_data->init( color_idx_to_rgb(COL_BLACK) );
+	}
+
+	switch(  mode & ~MAP_MODE_FLAGS  ) {
+		case MAP_FREIGHT:
+		case MAP_TRAFFIC:
+		case MAP_LEVEL:
+			// the colors depend on the maximum found so far
+			calc_map_rows( 0, map_data->get_height() );
+			break;
+
+		default:
+			// each band changes only its own rows
+			world->index_loop( [](uint32 band) { single_instance->calc_map_rows( band*MAP_BAND_ROWS, (band+1)*MAP_BAND_ROWS ); },
+				(map_data->get_height() + MAP_BAND_ROWS - 1) / MAP_BAND_ROWS );
+			break;
+	}
+}
+
+
+void minimap_t::calc_map_rows(sint32 y_min, sint32 y_max)
+{
+	y_max = min( y_max, (sint32)map_data->get_height() );
+	clip_rows_min = y_min;
+	clip_rows_max = y_max;
 
-	// redraw the map
 	if(  !isometric  ) {
 		koord k;
 		koord start_off = koord( (cur_off.x*zoom_out)/zoom_in, (cur_off.y*zoom_out)/zoom_in );
 		koord end_off = start_off+koord( ( map_data->get_width()*zoom_out)/zoom_in+1, ( map_data->get_height()*zoom_out)/zoom_in+1 );
 		for(  k.y=start_off.y;  k.y<end_off.y;  k.y+=zoom_out  ) {
+			const sint32 y = ((sint32)k.y * zoom_in) / zoom_out - cur_off.y;
+			if(  y + zoom_in <= y_min  ) {
+				continue;
+			}
+			if(  y >= y_max  ) {
+				break;
+			}
 			for(  k.x=start_off.x;  k.x<end_off.x;  k.x+=zoom_out  ) {
-				calc_map_pixel(k);
+				calc_tile_pixel(k);
 			}
 		}
 	}
 	else {
-		// always the whole map ...
-		if(isometric) {
-			map_data->init( color_idx_to_rgb(COL_BLACK) );
-		}
+		// same size as in set_map_color()
+		const sint32 xw = zoom_out>=2 ? 1 : 2*zoom_in;
+		const sint32 mid_y = ((xw+1) / 5) + (xw / 18);
+		const sint32 size_x = world->get_size().x;
+		const sint32 size_y = world->get_size().y;
+		// only tiles, which can reach these rows (x+y) and the visible columns (x-y), with some margin for rounding
+		const sint32 sum_min = (2 * (y_min + cur_off.y - 2*mid_y) * zoom_out) / zoom_in - 2;
+		const sint32 sum_max = (2 * (y_max + cur_off.y) * zoom_out) / zoom_in + 2;
+		const sint32 diff_min = ((cur_off.x - xw) * zoom_out) / zoom_in - size_y - 2;
+		const sint32 diff_max = ((cur_off.x + (sint32)map_data->get_width()) * zoom_out) / zoom_in - size_y + 2;
 		koord k;
-		for(  k.y=0;  k.y < world->get_size().y;  k.y++  ) {
-			for(  k.x=0;  k.x < world->get_size().x;  k.x++  ) {
-				calc_map_pixel(k);
+		for(  k.y=0;  k.y < size_y;  k.y++  ) {
+			const sint32 x_min = max( 0, max( sum_min - k.y, diff_min + k.y ) );
+			const sint32 x_max = min( size_x - 1, min( sum_max - k.y, diff_max + k.y ) );
+			for(  k.x=x_min;  k.x <= x_max;  k.x++  ) {
+				calc_tile_pixel(k);
 			}
 		}
 	}
+
+	clip_rows_min = 0;
+	clip_rows_max = 0x7FFF;
 }
 
 
 minimap_t::minimap_t()
 {
 	map_data = NULL;
+	map_valid = false;
 	zoom_in = 1;
 	zoom_out = 1;
 	isometric = false;
@@ -1126,6 +1320,7 @@ minimap_t::minimap_t()
 
 minimap_t::~minimap_t()
 {
+	invalidate_layers();
 	delete map_data;
 }
 
@@ -1141,8 +1336,10 @@ minimap_t *minimap_t::get_instance()
 
 void minimap_t::init()
 {
+	invalidate_layers();
 	delete map_data;
 	map_data = NULL;
+	map_valid = false;
 	needs_redraw = true;
 	is_visible = false;
 
@@ -1161,9 +1358,35 @@ void minimap_t::set_display_mode(MAP_DISPLAY_MODE new_mode)
 }
 
 
+// true for modes showing statistics, which are only recalculated with the new month
+static bool is_monthly_mode(uint32 mode)
+{
+	switch(  mode & ~minimap_t::MAP_MODE_FLAGS  ) {
+		case minimap_t::PLAIN:
+		case minimap_t::MAP_TRACKS:
+		case minimap_t::MAX_SPEEDLIMIT:
+			return false;
+		default:
+			return true;
+	}
+}
+
+
 void minimap_t::new_month()
 {
-	needs_redraw = true;
+	// the other maps are updated tile by tile anyway
+	if(  is_monthly_mode( mode )  ) {
+		needs_redraw = true;
+	}
+	for(  uint32 i = 0;  i < layers.get_count();  ) {
+		if(  is_monthly_mode( layers[i]->key.mode )  ) {
+			delete layers[i];
+			layers.remove_at( i );
+		}
+		else {
+			i++;
+		}
+	}
 }
 
 
@@ -1222,8 +1445,10 @@ const fabrik_t* minimap_t::draw_factory_connections(const fabrik_t* const fab, b
 		PIXVAL color = supplier_link ? color_idx_to_rgb(COL_RED) : color_idx_to_rgb(COL_WHITE);
 		scr_coord fabpos = map_to_screen_coord( fab->get_pos().get_2d() ) + pos;
 		const vector_tpl<koord>& consumer = supplier_link ? fab->get_suppliers() : fab->get_consumer();
-		for(koord lieferziel : consumer) {
-			const fabrik_t * fab2 = fabrik_t::get_fab(lieferziel);
+		const vector_tpl<fabrik_t *>& consumer_fabs = supplier_link ? fab->get_supplier_fabs() : fab->get_consumer_fabs();
+		for(  uint32 i = 0;  i < consumer.get_count();  i++  ) {
+			const koord lieferziel = consumer[i];
+			const fabrik_t * fab2 = consumer_fabs[i];
 			if (fab2) {
 				const scr_coord end = map_to_screen_coord( lieferziel ) + pos;
 				display_direct_line_rgb(fabpos.x, fabpos.y, end.x, end.y, color);
@@ -1293,7 +1518,7 @@ void minimap_t::draw(scr_coord pos)
 	}
 
 	if(  needs_redraw  ||  cur_off!=new_off  ||  cur_size!=new_size  ) {
-		calc_map();
+		update_map();
 		needs_redraw = false;
 	}
 
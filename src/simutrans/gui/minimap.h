@@ -78,6 +78,57 @@ private:
 	/// the terrain map
 	array2d_tpl<PIXVAL> *map_data;
 
+	/// everything the pixels of map_data depend on
+	struct layer_key_t
+	{
+		uint32 mode;
+		scr_coord off;
+		scr_size size;
+		sint16 zoom_in, zoom_out;
+		bool isometric;
+		uint8 underground_mode;
+		sint8 underground_level;
+
+		bool operator==(const layer_key_t &other) const;
+	};
+
+	/// a map computed earlier for another mode, with the changed parts of the world
+	struct layer_t
+	{
+		layer_key_t key;
+		array2d_tpl<PIXVAL> *data;
+		array2d_tpl<uint8> *dirty; ///< one entry per block of tiles
+		uint32 dirty_count;
+
+		~layer_t() { delete data; delete dirty; }
+	};
+
+	/// the most recently shown maps first
+	vector_tpl<layer_t *> layers;
+
+	/// key of map_data, only valid if map_valid
+	layer_key_t map_key;
+	bool map_valid;
+
+	layer_key_t get_layer_key() const;
+
+	void invalidate_layers();
+
+	/// notes a changed tile in all kept layers
+	void mark_layers_dirty(koord k);
+
+	/// shows the map for the current mode and size, from a kept layer if possible
+	void update_map();
+
+	/// recalculates the whole visible map (in parallel if possible)
+	void compute_map();
+
+	/// recalculates the pixel rows y_min up to y_max of the map
+	void calc_map_rows(sint32 y_min, sint32 y_max);
+
+	/// calc_map_pixel() without tracking the change
+	void calc_tile_pixel(const koord k);
+
 	void set_map_color_clip( sint16 x, sint16 y, PIXVAL color );
 
 	/// all stuff connected with schedule display
@@ -211,6 +262,7 @@ public:
 	// true for 
 	bool calc_map_pixel(const grund_t *gr);
 
+	/// recalculates the visible map and discards the layers of other modes
 	void calc_map();
 
 	/// calculates the current size of the map (but do not change anything else)
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <string>
+
+#include "profiler_frame.h"
+#include "components/gui_divider.h"
+
+#include "../simhalt.h"
+#include "../display/simgraph.h"
+#include "../dataobj/environment.h"
+#include "../dataobj/translator.h"
+
+
+profiler_frame_t::profiler_frame_t() :
+	gui_frame_t( translator::translate("Profiler") )
+{
+	set_table_layout(1,0);
+
+	add_table(5,0);
+	{
+		new_component<gui_empty_t>();
+		new_component<gui_label_t>("last step [us]", SYSCOL_TEXT, gui_label_t::right);
+		new_component<gui_label_t>("avg step [us]", SYSCOL_TEXT, gui_label_t::right);
+		new_component<gui_label_t>("max step [us]", SYSCOL_TEXT, gui_label_t::right);
+		new_component<gui_label_t>("avg frame [us]", SYSCOL_TEXT, gui_label_t::right);
+		for(  int s = 0;  s < profiler_t::MAX_SECTIONS;  s++  ) {
+			new_component<gui_label_t>( profiler_t::get_section_name( (profiler_t::section_t)s ) );
+			for(  int i = 0;  i < 4;  i++  ) {
+				lb_time[s][i].set_align( gui_label_t::right );
+				add_component( &lb_time[s][i] );
+			}
+		}
+	}
+	end_table();
+
+	new_component<gui_divider_t>();
+
+	add_table(3,0);
+	{
+		new_component<gui_empty_t>();
+		new_component<gui_label_t>("last step", SYSCOL_TEXT, gui_label_t::right);
+		new_component<gui_label_t>("avg step", SYSCOL_TEXT, gui_label_t::right);
+		for(  int c = 0;  c < profiler_t::MAX_COUNTERS;  c++  ) {
+			new_component<gui_label_t>( profiler_t::get_counter_name( (profiler_t::counter_t)c ) );
+			for(  int i = 0;  i < 2;  i++  ) {
+				lb_count[c][i].set_align( gui_label_t::right );
+				add_component( &lb_count[c][i] );
+			}
+		}
+	}
+	end_table();
+
+	new_component<gui_divider_t>();
+
+	add_table(2,2);
+	{
+		new_component<gui_label_t>("stale freight queue");
+		lb_stale.set_align( gui_label_t::right );
+		add_component( &lb_stale );
+
+		new_component<gui_label_t>("image memory");
+		lb_images.set_align( gui_label_t::right );
+		add_component( &lb_images );
+	}
+	end_table();
+
+	new_component<gui_divider_t>();
+
+	add_table(3,1);
+	{
+		bt_csv.init( button_t::roundbox, "Export CSV" );
+		bt_csv.add_listener( this );
+		add_component( &bt_csv );
+
+		bt_trace.init( button_t::square_state, "Record trace" );
+		bt_trace.pressed = profiler_t::is_tracing();
+		bt_trace.add_listener( this );
+		add_component( &bt_trace );
+
+		bt_trace_dump.init( button_t::roundbox, "Export trace" );
+		bt_trace_dump.add_listener( this );
+		add_component( &bt_trace_dump );
+	}
+	end_table();
+
+	update_labels();
+
+	reset_min_windowsize();
+	set_windowsize(get_min_windowsize());
+}
+
+
+void profiler_frame_t::update_labels()
+{
+	const bool has_step = profiler_t::get_sample_count( profiler_t::STEPS ) > 0;
+	for(  int s = 0;  s < profiler_t::MAX_SECTIONS;  s++  ) {
+		const profiler_t::section_t sec = (profiler_t::section_t)s;
+		uint32 avg, max, frame_avg, frame_max;
+		profiler_t::get_time_stats( profiler_t::STEPS, sec, avg, max );
+		profiler_t::get_time_stats( profiler_t::FRAMES, sec, frame_avg, frame_max );
+
+		lb_time[s][0].buf().printf( "%u", has_step ? profiler_t::get_sample( profiler_t::STEPS, 0 ).time_us[s] : 0 );
+		lb_time[s][1].buf().printf( "%u", avg );
+		lb_time[s][2].buf().printf( "%u", max );
+		lb_time[s][3].buf().printf( "%u", frame_avg );
+		for(  int i = 0;  i < 4;  i++  ) {
+			lb_time[s][i].update();
+		}
+	}
+	for(  int c = 0;  c < profiler_t::MAX_COUNTERS;  c++  ) {
+		const profiler_t::counter_t cnt = (profiler_t::counter_t)c;
+		lb_count[c][0].buf().printf( "%u", has_step ? profiler_t::get_sample( profiler_t::STEPS, 0 ).count[c] : 0 );
+		lb_count[c][1].buf().printf( "%u", profiler_t::get_average_count( profiler_t::STEPS, cnt ) );
+		lb_count[c][0].update();
+		lb_count[c][1].update();
+	}
+	lb_stale.buf().printf( "%u, oldest %u steps", haltestelle_t::get_stale_freight_count(), haltestelle_t::get_stale_freight_latency() );
+	lb_stale.update();
+
+	size_t base_bytes, cache_bytes;
+	uint32 freed;
+	display_get_image_memory( base_bytes, cache_bytes, freed );
+	lb_images.buf().printf( "%u KB, copies %u KB, %u freed", (unsigned)(base_bytes >> 10), (unsigned)(cache_bytes >> 10), freed );
+	lb_images.update();
+}
+
+
+void profiler_frame_t::draw(scr_coord pos, scr_size size)
+{
+	update_labels();
+	bt_trace.pressed = profiler_t::is_tracing();
+	gui_frame_t::draw(pos, size);
+}
+
+
+bool profiler_frame_t::action_triggered( gui_action_creator_t *comp, value_t )
+{
+	if(  comp == &bt_csv  ) {
+		profiler_t::dump_csv( (std::string(env_t::user_dir) + "profile.csv").c_str() );
+	}
+	else if(  comp == &bt_trace  ) {
+		profiler_t::set_tracing( !profiler_t::is_tracing() );
+	}
+	else if(  comp == &bt_trace_dump  ) {
+		profiler_t::dump_trace( (std::string(env_t::user_dir) + "profile_trace.json").c_str() );
+	}
+	return true;
+}
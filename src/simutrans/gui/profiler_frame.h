@@ -0,0 +1,40 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef GUI_PROFILER_FRAME_H
+#define GUI_PROFILER_FRAME_H
+
+
+#include "gui_frame.h"
+#include "components/action_listener.h"
+#include "components/gui_button.h"
+#include "components/gui_label.h"
+#include "../utils/profiler.h"
+
+
+/**
+ * Shows the timings of the main simulation phases and the hot path counters
+ * collected by profiler_t, and exports them to files.
+ */
+class profiler_frame_t : public gui_frame_t, private action_listener_t
+{
+	gui_label_buf_t lb_time[profiler_t::MAX_SECTIONS][4];
+	gui_label_buf_t lb_count[profiler_t::MAX_COUNTERS][2];
+	gui_label_buf_t lb_stale;
+	gui_label_buf_t lb_images;
+
+	button_t bt_csv, bt_trace, bt_trace_dump;
+
+	void update_labels();
+
+public:
+	profiler_frame_t();
+
+	void draw(scr_coord pos, scr_size size) OVERRIDE;
+
+	bool action_triggered(gui_action_creator_t*, value_t) OVERRIDE;
+};
+
+#endif
@@ -124,6 +124,8 @@ enum magic_numbers {
 	magic_pakinstall,
 	magic_chatframe,
 	magic_player_ranking,
+	magic_profiler,
+	magic_memory_stats,
 	magic_max
 };
 
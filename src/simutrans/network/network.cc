@@ -29,6 +29,7 @@
 
 #ifndef NETTOOL
 #include "../dataobj/environment.h"
+#include "../utils/profiler.h"
 #endif
 
 #include "../utils/simstring.h"
@@ -538,6 +539,16 @@ network_command_t* network_get_received_command()
 }
 
 
+uint32 network_get_buffered_packets()
+{
+	uint32 packets = received_command_queue.get_count();
+	for(  uint32 i = 0;  i < socket_list_t::get_count();  i++  ) {
+		packets += socket_list_t::get_client(i).get_buffered_packets();
+	}
+	return packets;
+}
+
+
 /* do appropriate action for network games:
  * - server: accept connection to a new client
  * - all: receive commands and puts them to the received_command_queue
@@ -768,6 +779,9 @@ bool network_send_data( SOCKET dest, const char *buf, const uint16 size, uint16
 			return false;
 		}
 		count += sent;
+#ifndef NETTOOL
+		profiler_t::count( profiler_t::CNT_BYTES_SENT, sent );
+#endif
 		DBG_DEBUG4("network_send_data", "Sent %d bytes to socket[%d]; size=%d, left=%d", count, dest, size, size-count );
 	}
 
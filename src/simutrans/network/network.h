@@ -89,6 +89,12 @@ bool network_init_server( int port, const vector_tpl<std::string> &listen_addrs
  */
 network_command_t* network_get_received_command();
 
+/**
+ * number of packets held in memory: received commands not yet processed,
+ * packets being received and packets waiting in the send queues
+ */
+uint32 network_get_buffered_packets();
+
 /**
  * do appropriate action for network games:
  * - server: accept connection to a new client
@@ -25,6 +25,7 @@
 #include "../utils/simrandom.h"
 #include "../utils/cbuffer.h"
 #include "../utils/csv.h"
+#include "../utils/memory_stats.h"
 #include "../display/viewport.h"
 #include "../script/script.h" // callback for calls to tools
 
@@ -1470,6 +1471,22 @@ bool nwc_service_t::execute(karte_t *welt)
 			break;
 		}
 
+		case SRVC_GET_MEMORY_STATS: {
+			memory_stats_t::census_t census;
+			memory_stats_t::collect(welt, census);
+			cbuffer_t buf;
+			memory_stats_t::print(census, buf);
+
+			nwc_service_t nws;
+			nws.flag = flag;
+			nws.text = strdup(buf);
+			if (strlen(nws.text) > MAX_PACKET_LEN - 256) {
+				nws.text[MAX_PACKET_LEN - 256] = 0;
+			}
+			nws.send(packet->get_sender());
+			break;
+		}
+
 		default: ;
 	}
 	return true; // to delete
@@ -94,6 +94,9 @@ public:
 
 	void send_queue_append(packet_t *p);
 
+	/// number of packets being received or waiting to be sent
+	uint32 get_buffered_packets() const { return send_queue.get_count() + (packet ? 1 : 0); }
+
 	/**
 	 * rdwr client information to packet
 	 */
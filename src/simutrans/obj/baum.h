@@ -121,6 +121,13 @@ public:
 	/// @returns age of the tree in months, between 0 and 4095
 	uint16 get_age() const;
 
+	/// @returns true if check_season() will plant new trees or remove this tree
+	bool has_season_event() const
+	{
+		const uint16 age = get_age();
+		return (age >= SPAWN_PERIOD_START  &&  age < SPAWN_PERIOD_START + SPAWN_PERIOD_LENGTH)  ||  age >= AGE_LIMIT;
+	}
+
 private:
 	/// calculate offsets for new trees
 	void calc_off(slope_t::type slope, sint8 x=-128, sint8 y=-128);
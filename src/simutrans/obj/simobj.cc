@@ -299,7 +299,7 @@ void obj_t::display_after(int xpos, int ypos, bool) const
  */
 void obj_t::mark_image_dirty(image_id image, sint16 yoff) const
 {
-	if(  image != IMG_EMPTY  ) {
+	if(  image != IMG_EMPTY  &&  !welt->is_parallel_image_change()  ) {
 		const sint16 rasterweite = get_tile_raster_width();
 		int xpos=0, ypos=0;
 		if(  is_moving()  ) {
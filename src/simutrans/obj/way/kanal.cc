@@ -21,14 +21,14 @@ const way_desc_t *kanal_t::default_kanal=NULL;
 
 
 
-kanal_t::kanal_t(loadsave_t *file) :  weg_t()
+kanal_t::kanal_t(loadsave_t *file) :  weg_t(water_wt)
 {
 	rdwr(file);
 }
 
 
 
-kanal_t::kanal_t() : weg_t()
+kanal_t::kanal_t() : weg_t(water_wt)
 {
 	set_desc(default_kanal);
 }
@@ -18,7 +18,7 @@ class maglev_t : public schiene_t
 public:
 	static const way_desc_t *default_maglev;
 
-	maglev_t() : schiene_t() { set_desc(default_maglev); }
+	maglev_t() : schiene_t(maglev_wt) { set_desc(default_maglev); }
 
 	/**
 	 * File loading constructor.
@@ -13,7 +13,7 @@ const way_desc_t *monorail_t::default_monorail=NULL;
 
 
 
-monorail_t::monorail_t(loadsave_t *file) : schiene_t()
+monorail_t::monorail_t(loadsave_t *file) : schiene_t(monorail_wt)
 {
 	rdwr(file);
 }
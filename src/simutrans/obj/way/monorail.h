@@ -20,7 +20,7 @@ class monorail_t : public schiene_t
 public:
 	static const way_desc_t *default_monorail;
 
-	monorail_t() : schiene_t() { set_desc(default_monorail); }
+	monorail_t() : schiene_t(monorail_wt) { set_desc(default_monorail); }
 
 	/**
 	 * File loading constructor.
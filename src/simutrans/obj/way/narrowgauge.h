@@ -18,7 +18,7 @@ class narrowgauge_t : public schiene_t
 public:
 	static const way_desc_t *default_narrowgauge;
 
-	narrowgauge_t() : schiene_t() { set_desc(default_narrowgauge); }
+	narrowgauge_t() : schiene_t(narrowgauge_wt) { set_desc(default_narrowgauge); }
 
 	/**
 	 * File loading constructor.
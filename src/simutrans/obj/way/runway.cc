@@ -18,13 +18,13 @@
 const way_desc_t *runway_t::default_runway=NULL;
 
 
-runway_t::runway_t() : schiene_t()
+runway_t::runway_t() : schiene_t(air_wt)
 {
 	set_desc(default_runway);
 }
 
 
-runway_t::runway_t(loadsave_t *file) : schiene_t()
+runway_t::runway_t(loadsave_t *file) : schiene_t(air_wt)
 {
 	rdwr(file);
 }
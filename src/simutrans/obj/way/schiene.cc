@@ -21,11 +21,13 @@
 
 const way_desc_t *schiene_t::default_schiene=NULL;
 bool schiene_t::show_reservations = false;
+uint32 schiene_t::network_serial = 0;
 
 
-schiene_t::schiene_t() : weg_t()
+schiene_t::schiene_t(waytype_t wt) : weg_t(wt)
 {
 	reserved = convoihandle_t();
+	network_serial++;
 
 	if (schiene_t::default_schiene) {
 		set_desc(schiene_t::default_schiene);
@@ -36,13 +38,20 @@ schiene_t::schiene_t() : weg_t()
 }
 
 
-schiene_t::schiene_t(loadsave_t *file) : weg_t()
+schiene_t::schiene_t(loadsave_t *file, waytype_t wt) : weg_t(wt)
 {
 	reserved = convoihandle_t();
+	network_serial++;
 	rdwr(file);
 }
 
 
+schiene_t::~schiene_t()
+{
+	network_serial++;
+}
+
+
 void schiene_t::cleanup(player_t *)
 {
 	// removes reservation
@@ -25,17 +25,29 @@ protected:
 	*/
 	convoihandle_t reserved;
 
+	/// changes whenever a track is built or removed
+	static uint32 network_serial;
+
 public:
 	static const way_desc_t *default_schiene;
 
 	static bool show_reservations;
 
+	/**
+	 * Tracks remembered together with this serial are still there (at the same
+	 * address) as long as the serial is unchanged.
+	 */
+	static uint32 get_network_serial() { return network_serial; }
+
 	/**
 	* File loading constructor.
 	*/
-	schiene_t(loadsave_t *file);
+	schiene_t(loadsave_t *file, waytype_t wt = track_wt);
+
+	/// @param wt waytype of the derived class (monorail, maglev ...)
+	schiene_t(waytype_t wt = track_wt);
 
-	schiene_t();
+	~schiene_t();
 
 	waytype_t get_waytype() const OVERRIDE {return track_wt;}
 
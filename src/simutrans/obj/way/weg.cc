@@ -32,8 +32,6 @@
 #include "../../descriptor/way_desc.h"
 #include "../../descriptor/roadsign_desc.h"
 
-#include "../../tpl/slist_tpl.h"
-
 #ifdef MULTI_THREAD
 #include "../../utils/simthread.h"
 static pthread_mutex_t weg_calc_image_mutex;
@@ -42,17 +40,107 @@ static recursive_mutex_maker_t weg_cim_maker(weg_calc_image_mutex);
 
 /**
  * Alle instantiierten Wege
+ * Ways of the same partition are stored contiguously, partition p occupies
+ * the indices partition_start[p] up to partition_start[p+1]-1.
  */
-slist_tpl <weg_t *> alle_wege;
+static vector_tpl<weg_t *> alle_wege;
+static uint32 partition_start[MAX_WAY_PARTITIONS+1];
+
+vector_tpl<weg_t::statistics_t> weg_t::all_statistics;
 
 uint16 weg_t::cityroad_speed = 50;
 
 /**
  * Get list of all ways
  */
-const slist_tpl <weg_t*> &weg_t::get_alle_wege()
+weg_t::range_t weg_t::get_alle_wege()
+{
+	return range_t( alle_wege.begin(), alle_wege.end() );
+}
+
+
+weg_t::range_t weg_t::get_wege(waytype_t wt)
 {
-	return alle_wege;
+	const uint8 p = get_registry_partition( wt );
+	return range_t( alle_wege.begin() + partition_start[p], alle_wege.begin() + partition_start[p+1] );
+}
+
+
+size_t weg_t::get_registry_memory()
+{
+	return alle_wege.get_capacity() * sizeof(weg_t *) + all_statistics.get_capacity() * sizeof(statistics_t);
+}
+
+
+uint8 weg_t::get_registry_partition(waytype_t wt)
+{
+	switch(wt) {
+		case road_wt:        return 0;
+		case tram_wt:
+		case track_wt:       return 1;
+		case water_wt:       return 2;
+		case monorail_wt:    return 3;
+		case maglev_wt:      return 4;
+		case narrowgauge_wt: return 5;
+		case air_wt:         return 6;
+		default:
+			dbg->fatal( "weg_t::get_registry_partition()", "Invalid waytype %d", wt );
+	}
+}
+
+
+void weg_t::move_registry_entry(uint32 from, uint32 to)
+{
+	if(  from != to  ) {
+		alle_wege[to] = alle_wege[from];
+		all_statistics[to] = all_statistics[from];
+		alle_wege[to]->registry_index = to;
+	}
+}
+
+
+/**
+ * Appends the way to its partition: the first way of each following
+ * partition moves to the end of that partition to make room, so adding
+ * and removing needs at most MAX_WAY_PARTITIONS moves.
+ */
+void weg_t::register_way(waytype_t wt)
+{
+	registry_partition = get_registry_partition( wt );
+
+	uint32 hole = alle_wege.get_count();
+	alle_wege.append( NULL );
+	all_statistics.append( statistics_t() );
+	for(  uint8 q = MAX_WAY_PARTITIONS-1;  q > registry_partition;  q--  ) {
+		move_registry_entry( partition_start[q], hole );
+		hole = partition_start[q];
+		partition_start[q]++;
+	}
+	partition_start[MAX_WAY_PARTITIONS]++;
+
+	alle_wege[hole] = this;
+	registry_index = hole;
+}
+
+
+void weg_t::unregister_way()
+{
+	assert( alle_wege[registry_index] == this );
+
+	// the last way of each partition fills the hole in front of it
+	uint32 hole = registry_index;
+	for(  uint8 q = registry_partition;  q < MAX_WAY_PARTITIONS;  q++  ) {
+		const uint32 last = partition_start[q+1] - 1;
+		move_registry_entry( last, hole );
+		hole = last;
+		if(  q > registry_partition  ) {
+			partition_start[q]--;
+		}
+	}
+	partition_start[MAX_WAY_PARTITIONS]--;
+
+	alle_wege.pop_back();
+	all_statistics.pop_back();
 }
 
 
@@ -60,8 +148,8 @@ void weg_t::set_cityroad_speedlimit(uint16 new_limit)
 {
 	if (cityroad_speed != new_limit) {
 		cityroad_speed = new_limit;
-		for(weg_t *w : alle_wege) {
-			if(  w->hat_gehweg()  &&  w->get_waytype() == road_wt  ) {
+		for(weg_t *w : get_wege(road_wt)) {
+			if(  w->hat_gehweg()  ) {
 				if (const way_desc_t* desc = w->get_desc()) {
 					w->set_max_speed(max(desc->get_topspeed(), cityroad_speed));
 				}
@@ -148,9 +236,10 @@ void weg_t::set_desc(const way_desc_t *b)
  */
 void weg_t::init_statistics()
 {
+	statistics_t &statistics = all_statistics[registry_index];
 	for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
 		for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
-			statistics[month][type] = 0;
+			statistics.stat[month][type] = 0;
 		}
 	}
 }
@@ -159,13 +248,13 @@ void weg_t::init_statistics()
 /**
  * Initializes all member variables
  */
-void weg_t::init()
+void weg_t::init(waytype_t wt)
 {
 	ribi = ribi_maske = ribi_t::none;
 	max_speed = 450;
 	desc = 0;
+	register_way(wt);
 	init_statistics();
-	alle_wege.insert(this);
 	flags = 0;
 	image = IMG_EMPTY;
 	foreground_image = IMG_EMPTY;
@@ -174,7 +263,7 @@ void weg_t::init()
 
 weg_t::~weg_t()
 {
-	alle_wege.remove(this);
+	unregister_way();
 	player_t *player=get_owner();
 	if(player) {
 		player_t::add_maintenance( player,  -desc->get_maintenance(), desc->get_finance_waytype() );
@@ -214,12 +303,13 @@ void weg_t::rdwr(loadsave_t *file)
 		}
 	}
 
+	statistics_t &statistics = all_statistics[registry_index];
 	for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
 		for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
-			sint32 w = statistics[month][type];
+			sint32 w = statistics.stat[month][type];
 			file->rdwr_long(w);
-			statistics[month][type] = (sint16)w;
-			// DBG_DEBUG("weg_t::rdwr()", "statistics[%d][%d]=%d", month, type, statistics[month][type]);
+			statistics.stat[month][type] = (sint16)w;
+			// DBG_DEBUG("weg_t::rdwr()", "statistics[%d][%d]=%d", month, type, statistics.stat[month][type]);
 		}
 	}
 }
@@ -245,13 +335,13 @@ void weg_t::info(cbuffer_t & buf) const
 	}
 
 #if 1
-	buf.printf(translator::translate("convoi passed last\nmonth %i\n"), statistics[1][1]);
+	buf.printf(translator::translate("convoi passed last\nmonth %i\n"), get_statistics(WAY_STAT_CONVOIS));
 #else
 	// Debug - output stats
 	buf.append("\n");
 	for (int type=0; type<MAX_WAY_STATISTICS; type++) {
 		for (int month=0; month<MAX_WAY_STAT_MONTHS; month++) {
-			buf.printf("%d ", statistics[month][type]);
+			buf.printf("%d ", (int)get_stat(month, type));
 		}
 	buf.append("\n");
 	}
@@ -548,13 +638,15 @@ void weg_t::check_diagonal()
 /**
  * new month
  */
-void weg_t::new_month()
+void weg_t::new_month_all()
 {
-	for (int type=0; type<MAX_WAY_STATISTICS; type++) {
-		for (int month=MAX_WAY_STAT_MONTHS-1; month>0; month--) {
-			statistics[month][type] = statistics[month-1][type];
+	for(  statistics_t &statistics : all_statistics  ) {
+		for (int type=0; type<MAX_WAY_STATISTICS; type++) {
+			for (int month=MAX_WAY_STAT_MONTHS-1; month>0; month--) {
+				statistics.stat[month][type] = statistics.stat[month-1][type];
+			}
+			statistics.stat[0][type] = 0;
 		}
-		statistics[0][type] = 0;
 	}
 }
 
@@ -12,12 +12,12 @@
 #include "../../obj/simobj.h"
 #include "../../descriptor/way_desc.h"
 #include "../../dataobj/koord3d.h"
+#include "../../tpl/vector_tpl.h"
 
 
 class karte_t;
 class way_desc_t;
 class cbuffer_t;
-template <class T> class slist_tpl;
 
 
 // maximum number of months to store information
@@ -32,6 +32,9 @@ enum way_statistics {
 	WAY_STAT_MAX
 };
 
+// number of partitions of the way registry, ways of one waytype are stored contiguously
+#define MAX_WAY_PARTITIONS 7
+
 
 /**
  * Ways is the base class for all traffic routes. (roads, track, runway etc.)
@@ -44,10 +47,34 @@ enum way_statistics {
 class weg_t : public obj_no_info_t
 {
 public:
+	/**
+	 * A contiguous part of the way registry.
+	 * Only valid until the next way is built or removed.
+	 */
+	class range_t
+	{
+		weg_t *const *first;
+		weg_t *const *last;
+	public:
+		range_t(weg_t *const *f, weg_t *const *l) : first(f), last(l) {}
+		weg_t *const *begin() const { return first; }
+		weg_t *const *end() const { return last; }
+		uint32 get_count() const { return (uint32)(last - first); }
+	};
+
 	/**
 	* Get list of all ways
 	*/
-	static const slist_tpl <weg_t *> & get_alle_wege();
+	static range_t get_alle_wege();
+
+	/**
+	 * Get list of all ways of this waytype
+	 * (tram_wt returns all tracks, since trams are tracks with a tram desc)
+	 */
+	static range_t get_wege(waytype_t wt);
+
+	/// bytes allocated for the registry and the statistics of all ways
+	static size_t get_registry_memory();
 
 	enum {
 		HAS_SIDEWALK   = 1 << 0, // only roads
@@ -67,7 +94,18 @@ private:
 	* MAX_WAY_STAT_MONTHS: [0] = actual value; [1] = last month value
 	* MAX_WAY_STATISTICS: see #define at top of file
 	*/
-	sint16 statistics[MAX_WAY_STAT_MONTHS][MAX_WAY_STATISTICS];
+	struct statistics_t {
+		sint16 stat[MAX_WAY_STAT_MONTHS][MAX_WAY_STATISTICS];
+	};
+
+	/**
+	* statistics of all ways, in the same order as the registry
+	* so the monthly update is a single pass over a flat array
+	*/
+	static vector_tpl<statistics_t> all_statistics;
+
+	/// position in the way registry and in all_statistics
+	uint32 registry_index;
 
 	static uint16 cityroad_speed;
 
@@ -92,6 +130,9 @@ private:
 	*/
 	uint8 flags;
 
+	/// registry partition, fixed at construction
+	uint8 registry_partition;
+
 	/**
 	* max speed; could not be taken for desc, since other object may modify the speed
 	*/
@@ -103,7 +144,12 @@ private:
 	/**
 	* Initializes all member variables
 	*/
-	void init();
+	void init(waytype_t wt);
+
+	static uint8 get_registry_partition(waytype_t wt);
+	static void move_registry_entry(uint32 from, uint32 to);
+	void register_way(waytype_t wt);
+	void unregister_way();
 
 	/**
 	* initializes statistic array
@@ -113,8 +159,8 @@ private:
 protected:
 
 public:
-	weg_t(loadsave_t*) : obj_no_info_t() { init(); }
-	weg_t() : obj_no_info_t() { init(); }
+	/// @param wt the waytype is needed already here, since get_waytype() is not available in the constructor
+	explicit weg_t(waytype_t wt) : obj_no_info_t() { init(wt); }
 
 	virtual ~weg_t();
 
@@ -235,19 +281,20 @@ public:
 	/**
 	* book statistics - is called very often and therefore inline
 	*/
-	void book(int amount, way_statistics type) { statistics[0][type] += amount; }
+	void book(int amount, way_statistics type) { all_statistics[registry_index].stat[0][type] += amount; }
 
 	/**
 	* return statistics value
 	* always returns last month's value
 	*/
-	int get_statistics(int type) const { return statistics[1][type]; }
+	int get_statistics(int type) const { return all_statistics[registry_index].stat[1][type]; }
+
+	sint64 get_stat(int month, int stat_type) const { assert(stat_type<WAY_STAT_MAX  &&  0<=month  &&  month<MAX_WAY_STAT_MONTHS); return all_statistics[registry_index].stat[month][stat_type]; }
 
-	sint64 get_stat(int month, int stat_type) const { assert(stat_type<WAY_STAT_MAX  &&  0<=month  &&  month<MAX_WAY_STAT_MONTHS); return statistics[month][stat_type]; }
 	/**
-	* new month
+	* new month: rolls the statistics of all ways
 	*/
-	void new_month();
+	static void new_month_all();
 
 	void check_diagonal();
 
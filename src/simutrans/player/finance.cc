@@ -26,38 +26,20 @@ finance_t::finance_t(player_t * _player, karte_t * _world) :
 	starting_money = account_balance;
 	account_overdrawn = 0;
 
+	com_year.clear();
+	com_month.clear();
 	for (int year=0; year<MAX_PLAYER_HISTORY_YEARS; year++) {
-		for (int cost_type=0; cost_type<ATC_MAX; cost_type++) {
-			com_year[year][cost_type] = 0;
-			if ((cost_type == ATC_CASH) || (cost_type == ATC_NETWEALTH)) {
-				com_year[year][cost_type] = starting_money;
-			}
-		}
+		com_year.at(year, ATC_CASH) = starting_money;
+		com_year.at(year, ATC_NETWEALTH) = starting_money;
 	}
-
 	for (int month=0; month<MAX_PLAYER_HISTORY_MONTHS; month++) {
-		for (int cost_type=0; cost_type<ATC_MAX; cost_type++) {
-			com_month[month][cost_type] = 0;
-			if ((cost_type == ATC_CASH) || (cost_type == ATC_NETWEALTH)) {
-				com_month[month][cost_type] = starting_money;
-			}
-		}
+		com_month.at(month, ATC_CASH) = starting_money;
+		com_month.at(month, ATC_NETWEALTH) = starting_money;
 	}
 
 	for (int transport_type=0; transport_type<TT_MAX; ++transport_type){
-		for (int year=0; year<MAX_PLAYER_HISTORY_YEARS; year++) {
-			for (int cost_type=0; cost_type<ATV_MAX; cost_type++) {
-				veh_year[transport_type][year][cost_type] = 0;
-			}
-		}
-	}
-
-	for (int transport_type=0; transport_type<TT_MAX; ++transport_type){
-		for (int month=0; month<MAX_PLAYER_HISTORY_MONTHS; month++) {
-			for (int cost_type=0; cost_type<ATV_MAX; cost_type++) {
-				veh_month[transport_type][month][cost_type] = 0;
-			}
-		}
+		veh_year[transport_type].clear();
+		veh_month[transport_type].clear();
 	}
 
 	for(int i=0; i<TT_MAX; ++i){
@@ -78,89 +60,89 @@ void finance_t::calc_finance_history()
 		sint64 revenue, mrevenue;
 		revenue = mrevenue = 0;
 		for(int i=0; i<ATV_REVENUE_TRANSPORT; ++i){
-			mrevenue += veh_month[tt][0][i];
-			revenue  += veh_year[ tt][0][i];
+			mrevenue += veh_month[tt].at(0, i);
+			revenue  += veh_year[ tt].at(0, i);
 		}
-		veh_month[tt][0][ATV_REVENUE_TRANSPORT] = mrevenue;
-		veh_year[ tt][0][ATV_REVENUE_TRANSPORT] = revenue;
+		veh_month[tt].at(0, ATV_REVENUE_TRANSPORT) = mrevenue;
+		veh_year[ tt].at(0, ATV_REVENUE_TRANSPORT) = revenue;
 
 		// ATV_REVENUE = ATV_REVENUE_TRANSPORT + ATV_TOLL_RECEIVED
-		veh_month[tt][0][ATV_REVENUE] = veh_month[tt][0][ATV_REVENUE_TRANSPORT] + veh_month[tt][0][ATV_TOLL_RECEIVED];
-		veh_year[tt][0][ATV_REVENUE] = veh_year[tt][0][ATV_REVENUE_TRANSPORT] + veh_year[tt][0][ATV_TOLL_RECEIVED];
+		veh_month[tt].at(0, ATV_REVENUE) = veh_month[tt].at(0, ATV_REVENUE_TRANSPORT) + veh_month[tt].at(0, ATV_TOLL_RECEIVED);
+		veh_year[tt].at(0, ATV_REVENUE) = veh_year[tt].at(0, ATV_REVENUE_TRANSPORT) + veh_year[tt].at(0, ATV_TOLL_RECEIVED);
 
 		// ATC_EXPENDITURE = ATC_RUNNIG_COST + ATC_VEH_MAINTENENCE + ATC_INF_MAINTENENCE + ATC_TOLL_PAYED;
 		sint64 expenditure, mexpenditure;
 		expenditure = mexpenditure = 0;
 		for(int i=ATV_RUNNING_COST; i<ATV_EXPENDITURE; ++i){
-			mexpenditure += veh_month[tt][0][i];
-			expenditure  += veh_year[ tt][0][i];
+			mexpenditure += veh_month[tt].at(0, i);
+			expenditure  += veh_year[ tt].at(0, i);
 		}
-		veh_month[tt][0][ATV_EXPENDITURE] = mexpenditure;
-		veh_year[ tt][0][ATV_EXPENDITURE] = expenditure;
-		veh_month[tt][0][ATV_OPERATING_PROFIT] = veh_month[tt][0][ATV_REVENUE] + mexpenditure;
-		veh_year[ tt][0][ATV_OPERATING_PROFIT] = veh_year[ tt][0][ATV_REVENUE] +  expenditure;
+		veh_month[tt].at(0, ATV_EXPENDITURE) = mexpenditure;
+		veh_year[ tt].at(0, ATV_EXPENDITURE) = expenditure;
+		veh_month[tt].at(0, ATV_OPERATING_PROFIT) = veh_month[tt].at(0, ATV_REVENUE) + mexpenditure;
+		veh_year[ tt].at(0, ATV_OPERATING_PROFIT) = veh_year[ tt].at(0, ATV_REVENUE) +  expenditure;
 
 		// PROFIT = OPERATING_PROFIT + NEW_VEHICLES + construction costs
 		sint64 profit, mprofit;
 		profit = mprofit = 0;
 		for(int i=ATV_OPERATING_PROFIT; i<ATV_PROFIT; ++i){
-			mprofit += veh_month[tt][0][i];
-			profit  += veh_year[ tt][0][i];
+			mprofit += veh_month[tt].at(0, i);
+			profit  += veh_year[ tt].at(0, i);
 		}
-		veh_month[tt][0][ATV_PROFIT] = mprofit;
-		veh_year[ tt][0][ATV_PROFIT] =  profit;
+		veh_month[tt].at(0, ATV_PROFIT) = mprofit;
+		veh_year[ tt].at(0, ATV_PROFIT) =  profit;
 
-		veh_month[tt][0][ATV_WAY_TOLL] = veh_month[tt][0][ATV_TOLL_RECEIVED] + veh_month[tt][0][ATV_TOLL_PAID];
-		veh_year[ tt][0][ATV_WAY_TOLL] = veh_year[tt][0][ATV_TOLL_RECEIVED] + veh_year[tt][0][ATV_TOLL_PAID];
+		veh_month[tt].at(0, ATV_WAY_TOLL) = veh_month[tt].at(0, ATV_TOLL_RECEIVED) + veh_month[tt].at(0, ATV_TOLL_PAID);
+		veh_year[ tt].at(0, ATV_WAY_TOLL) = veh_year[tt].at(0, ATV_TOLL_RECEIVED) + veh_year[tt].at(0, ATV_TOLL_PAID);
 
-		veh_month[tt][0][ATV_PROFIT_MARGIN] = calc_margin(veh_month[tt][0][ATV_OPERATING_PROFIT], veh_month[tt][0][ATV_REVENUE]);
-		veh_year[tt][0][ATV_PROFIT_MARGIN] = calc_margin(veh_year[tt][0][ATV_OPERATING_PROFIT], veh_year[tt][0][ATV_REVENUE]);
+		veh_month[tt].at(0, ATV_PROFIT_MARGIN) = calc_margin(veh_month[tt].at(0, ATV_OPERATING_PROFIT), veh_month[tt].at(0, ATV_REVENUE));
+		veh_year[tt].at(0, ATV_PROFIT_MARGIN) = calc_margin(veh_year[tt].at(0, ATV_OPERATING_PROFIT), veh_year[tt].at(0, ATV_REVENUE));
 
 		sint64 transported = 0, mtransported = 0;
 		for(int i=ATV_TRANSPORTED_PASSENGER; i<ATV_TRANSPORTED; ++i){
-			mtransported += veh_month[tt][0][i];
-			transported  += veh_year[ tt][0][i];
+			mtransported += veh_month[tt].at(0, i);
+			transported  += veh_year[ tt].at(0, i);
 		}
-		veh_month[tt][0][ATV_TRANSPORTED] = mtransported;
-		veh_year[ tt][0][ATV_TRANSPORTED] =  transported;
+		veh_month[tt].at(0, ATV_TRANSPORTED) = mtransported;
+		veh_year[ tt].at(0, ATV_TRANSPORTED) =  transported;
 
 		sint64 delivered = 0, mdelivered = 0;
 		for(int i=ATV_DELIVERED_PASSENGER; i<ATV_DELIVERED; ++i){
-			mdelivered += veh_month[tt][0][i];
-			delivered  += veh_year[ tt][0][i];
+			mdelivered += veh_month[tt].at(0, i);
+			delivered  += veh_year[ tt].at(0, i);
 		}
-		veh_month[tt][0][ATV_DELIVERED] = mdelivered;
-		veh_year[ tt][0][ATV_DELIVERED] =  delivered;
+		veh_month[tt].at(0, ATV_DELIVERED) = mdelivered;
+		veh_year[ tt].at(0, ATV_DELIVERED) =  delivered;
 	}
 
 	// sum up statistic for all transport types
 	for( int j=0; j< ATV_MAX; ++j ) {
-		veh_month[TT_ALL][0][j] =0;
+		veh_month[TT_ALL].at(0, j) =0;
 		for( int tt=1; tt<TT_MAX; ++tt ) {
 			// do not add powerline revenue to vehicles revenue
 			if ( ( tt != TT_POWERLINE ) || ( j >= ATV_REVENUE )) {
-				veh_month[TT_ALL][0][j] += veh_month[tt][0][j];
+				veh_month[TT_ALL].at(0, j) += veh_month[tt].at(0, j);
 			}
 		}
 	}
 	for( int j=0; j< ATV_MAX; ++j ) {
-		veh_year[TT_ALL][0][j] =0;
+		veh_year[TT_ALL].at(0, j) =0;
 		for( int tt=1; tt<TT_MAX; ++tt ) {
 			// do not add powerline revenue to vehicles revenue
 			if ( ( tt != TT_POWERLINE ) || ( j >= ATV_REVENUE )) {
-				veh_year[TT_ALL][0][j] += veh_year[tt][0][j];
+				veh_year[TT_ALL].at(0, j) += veh_year[tt].at(0, j);
 			}
 		}
 	}
 	// recalc margin for TT_ALL
-	veh_month[TT_ALL][0][ATV_PROFIT_MARGIN] = calc_margin(veh_month[TT_ALL][0][ATV_OPERATING_PROFIT], veh_month[TT_ALL][0][ATV_REVENUE]);
-	veh_year[TT_ALL][0][ATV_PROFIT_MARGIN] = calc_margin(veh_year[TT_ALL][0][ATV_OPERATING_PROFIT], veh_year[TT_ALL][0][ATV_REVENUE]);
+	veh_month[TT_ALL].at(0, ATV_PROFIT_MARGIN) = calc_margin(veh_month[TT_ALL].at(0, ATV_OPERATING_PROFIT), veh_month[TT_ALL].at(0, ATV_REVENUE));
+	veh_year[TT_ALL].at(0, ATV_PROFIT_MARGIN) = calc_margin(veh_year[TT_ALL].at(0, ATV_OPERATING_PROFIT), veh_year[TT_ALL].at(0, ATV_REVENUE));
 
 	// undistinguishable by type of transport
-	com_month[0][ATC_CASH] = account_balance;
-	com_year [0][ATC_CASH] = account_balance;
-	com_month[0][ATC_NETWEALTH] = veh_month[TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] + account_balance;
-	com_year [0][ATC_NETWEALTH] = veh_year[TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] + account_balance;
+	com_month.at(0, ATC_CASH) = account_balance;
+	com_year.at(0, ATC_CASH) = account_balance;
+	com_month.at(0, ATC_NETWEALTH) = veh_month[TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) + account_balance;
+	com_year.at(0, ATC_NETWEALTH) = veh_year[TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) + account_balance;
 }
 
 
@@ -182,9 +164,9 @@ bool finance_t::is_bancrupted() const
 {
 	return (
 		get_netwealth() <=0  &&
-		veh_year[TT_ALL][0][ATV_INFRASTRUCTURE_MAINTENANCE] == 0  &&
+		veh_year[TT_ALL].at(0, ATV_INFRASTRUCTURE_MAINTENANCE) == 0  &&
 		maintenance[TT_ALL] == 0  &&
-		com_year[0][ATC_ALL_CONVOIS] == 0
+		com_year.at(0, ATC_ALL_CONVOIS) == 0
 	);
 }
 
@@ -200,8 +182,8 @@ void finance_t::new_month()
 
 	// subtract maintenance
 	for(int i=0; i<TT_MAX; ++i){
-		veh_month[i][0][ATV_INFRASTRUCTURE_MAINTENANCE] -= get_maintenance_with_bits((transport_type)i);
-		veh_year [i][0][ATV_INFRASTRUCTURE_MAINTENANCE] -= get_maintenance_with_bits((transport_type)i);
+		veh_month[i].at(0, ATV_INFRASTRUCTURE_MAINTENANCE) -= get_maintenance_with_bits((transport_type)i);
+		veh_year[i].at(0, ATV_INFRASTRUCTURE_MAINTENANCE) -= get_maintenance_with_bits((transport_type)i);
 	}
 }
 
@@ -248,7 +230,7 @@ void finance_t::rdwr(loadsave_t *file)
 	for(int year = 0;  year < max_years ; ++year ) {
 		for( int cost_type = 0; cost_type < max_atc ;  ++cost_type  ) {
 			if( ( year < MAX_PLAYER_HISTORY_YEARS ) && ( cost_type < ATC_MAX ) ) {
-				file->rdwr_longlong( com_year[year][cost_type] );
+				file->rdwr_longlong( com_year.at(year, cost_type) );
 			} else {
 				file->rdwr_longlong( dummy );
 			}
@@ -257,7 +239,7 @@ void finance_t::rdwr(loadsave_t *file)
 	for(int month = 0; month < max_months; ++month) {
 		for( int cost_type = 0; cost_type < max_atc;  ++cost_type ) {
 			if( ( month < MAX_PLAYER_HISTORY_MONTHS ) && ( cost_type < ATC_MAX ) ) {
-				file->rdwr_longlong( com_month[month][cost_type] );
+				file->rdwr_longlong( com_month.at(month, cost_type) );
 			} else {
 				file->rdwr_longlong( dummy );
 			}
@@ -267,7 +249,7 @@ void finance_t::rdwr(loadsave_t *file)
 		for( int year = 0;  year < max_years;  ++year ) {
 			for( int cost_type = 0; cost_type < max_atv;  ++cost_type  ) {
 				if( ( tt < TT_MAX ) && ( year < MAX_PLAYER_HISTORY_YEARS ) && ( cost_type < ATV_MAX ) ) {
-					file->rdwr_longlong( veh_year[tt][year][cost_type] );
+					file->rdwr_longlong( veh_year[tt].at(year, cost_type) );
 				} else {
 					file->rdwr_longlong( dummy );
 				}
@@ -278,7 +260,7 @@ void finance_t::rdwr(loadsave_t *file)
 		for( int month = 0; month < max_months; ++month ) {
 			for( int cost_type = 0; cost_type < max_atv;  ++cost_type  ) {
 				if( ( tt < TT_MAX ) && ( month < MAX_PLAYER_HISTORY_MONTHS ) && ( cost_type < ATV_MAX ) ) {
-					file->rdwr_longlong( veh_month[tt][month][cost_type] );
+					file->rdwr_longlong( veh_month[tt].at(month, cost_type) );
 				} else {
 					file->rdwr_longlong( dummy );
 				}
@@ -290,54 +272,26 @@ void finance_t::rdwr(loadsave_t *file)
 
 void finance_t::roll_history_month()
 {
-	// undistinguishable
-	for (int i=MAX_PLAYER_HISTORY_MONTHS-1; i>0; i--) {
-		for(int accounting_type=0; accounting_type<ATC_MAX; ++accounting_type){
-			com_month[i][accounting_type] = com_month[i-1][accounting_type];
-		}
-	}
-	for(int i=0; i<ATC_MAX; ++i){
-		if(i != ATC_ALL_CONVOIS  &&  i != ATC_SCENARIO_COMPLETED){
-			com_month[0][i] = 0;
-		}
-	}
+	// undistinguishable, the number of convois and the scenario state carry over
+	com_month.advance();
+	com_month.at(0, ATC_ALL_CONVOIS) = com_month.at(1, ATC_ALL_CONVOIS);
+	com_month.at(0, ATC_SCENARIO_COMPLETED) = com_month.at(1, ATC_SCENARIO_COMPLETED);
 	// vehicles
 	for(int tt=0; tt<TT_MAX; ++tt){
-		for (int i=MAX_PLAYER_HISTORY_MONTHS-1; i>0; i--) {
-			for(int accounting_type=0; accounting_type<ATV_MAX; ++accounting_type){
-				veh_month[tt][i][accounting_type] = veh_month[tt][i-1][accounting_type];
-			}
-		}
-		for(int accounting_type=0; accounting_type<ATV_MAX; ++accounting_type){
-			veh_month[tt][0][accounting_type] = 0;
-		}
+		veh_month[tt].advance();
 	}
 }
 
 
 void finance_t::roll_history_year()
 {
-	// undistinguishable
-	for (int i=MAX_PLAYER_HISTORY_YEARS-1; i>0; i--) {
-		for(int accounting_type=0; accounting_type<ATC_MAX; ++accounting_type){
-			com_year[i][accounting_type] = com_year[i-1][accounting_type];
-		}
-	}
-	for(int i=0; i<ATC_MAX; ++i){
-		if(i != ATC_ALL_CONVOIS  &&  i != ATC_SCENARIO_COMPLETED){
-			com_year[0][i] = 0;
-		}
-	}
+	// undistinguishable, the number of convois and the scenario state carry over
+	com_year.advance();
+	com_year.at(0, ATC_ALL_CONVOIS) = com_year.at(1, ATC_ALL_CONVOIS);
+	com_year.at(0, ATC_SCENARIO_COMPLETED) = com_year.at(1, ATC_SCENARIO_COMPLETED);
 	// vehicles
 	for(int tt=0; tt<TT_MAX; ++tt){
-		for (int i=MAX_PLAYER_HISTORY_YEARS-1; i>0; i--) {
-			for(int accounting_type=0; accounting_type<ATV_MAX; ++accounting_type){
-				veh_year[tt][i][accounting_type] = veh_year[tt][i-1][accounting_type];
-			}
-		}
-		for(int accounting_type=0; accounting_type<ATV_MAX; ++accounting_type){
-			veh_year[tt][0][accounting_type] = 0;
-		}
+		veh_year[tt].advance();
 	}
 }
 
@@ -345,22 +299,22 @@ void finance_t::roll_history_year()
 void finance_t::set_assets(const sint64 (&assets)[TT_MAX])
 {
 	for(int i=0; i < TT_MAX; ++i){
-		veh_year[i][0][ATV_NON_FINANCIAL_ASSETS] = veh_month[i][0][ATV_NON_FINANCIAL_ASSETS] = assets[i];
+		veh_year[i].at(0, ATV_NON_FINANCIAL_ASSETS) = veh_month[i].at(0, ATV_NON_FINANCIAL_ASSETS) = assets[i];
 	}
-	com_year[0][ATC_NETWEALTH] = com_month[0][ATC_NETWEALTH] = veh_month[TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] + account_balance;
+	com_year.at(0, ATC_NETWEALTH) = com_month.at(0, ATC_NETWEALTH) = veh_month[TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) + account_balance;
 }
 
 
 void finance_t::update_assets(sint64 const delta, const waytype_t wt)
 {
 	transport_type tt = translate_waytype_to_tt(wt);
-	veh_year[ tt][0][ATV_NON_FINANCIAL_ASSETS] += delta;
-	veh_month[tt][0][ATV_NON_FINANCIAL_ASSETS] += delta;
-	veh_year[ TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] += delta;
-	veh_month[TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] += delta;
+	veh_year[ tt].at(0, ATV_NON_FINANCIAL_ASSETS) += delta;
+	veh_month[tt].at(0, ATV_NON_FINANCIAL_ASSETS) += delta;
+	veh_year[ TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) += delta;
+	veh_month[TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) += delta;
 
-	com_year[ 0][ATC_NETWEALTH] += delta;
-	com_month[0][ATC_NETWEALTH] += delta;
+	com_year.at( 0, ATC_NETWEALTH) += delta;
+	com_month.at(0, ATC_NETWEALTH) += delta;
 }
 
 
@@ -432,25 +386,25 @@ void finance_t::export_to_cost_month(sint64 finance_history_month[][OLD_MAX_PLAY
 {
 	calc_finance_history();
 	for(int i=0; i<OLD_MAX_PLAYER_HISTORY_MONTHS; ++i){
-		finance_history_month[i][COST_CONSTRUCTION] = veh_month[TT_ALL][i][ATV_CONSTRUCTION_COST];
-		finance_history_month[i][COST_VEHICLE_RUN]  = veh_month[TT_ALL][i][ATV_RUNNING_COST] + veh_month[TT_ALL][i][ATV_VEHICLE_MAINTENANCE];
-		finance_history_month[i][COST_NEW_VEHICLE]  = veh_month[TT_ALL][i][ATV_NEW_VEHICLE];
-		finance_history_month[i][COST_INCOME]       = veh_month[TT_ALL][i][ATV_REVENUE_TRANSPORT];
-		finance_history_month[i][COST_MAINTENANCE]  = veh_month[TT_ALL][i][ATV_INFRASTRUCTURE_MAINTENANCE];
-		finance_history_month[i][COST_ASSETS]       = veh_month[TT_ALL][i][ATV_NON_FINANCIAL_ASSETS];
-		finance_history_month[i][COST_CASH]         = com_month[i][ATC_CASH];
-		finance_history_month[i][COST_NETWEALTH]    = com_month[i][ATC_NETWEALTH];
-		finance_history_month[i][COST_PROFIT]       = veh_month[TT_ALL][i][ATV_PROFIT];
-		finance_history_month[i][COST_OPERATING_PROFIT] = veh_month[TT_ALL][i][ATV_OPERATING_PROFIT];
-		finance_history_month[i][COST_MARGIN]           = veh_month[TT_ALL][i][ATV_PROFIT_MARGIN];
-		finance_history_month[i][COST_ALL_TRANSPORTED]  = veh_month[TT_ALL][i][ATV_TRANSPORTED];
-		finance_history_month[i][COST_POWERLINES]       = veh_month[TT_POWERLINE][i][ATV_REVENUE];
-		finance_history_month[i][COST_TRANSPORTED_PAS]  = veh_month[TT_ALL][i][ATV_DELIVERED_PASSENGER];
-		finance_history_month[i][COST_TRANSPORTED_MAIL] = veh_month[TT_ALL][i][ATV_DELIVERED_MAIL];
-		finance_history_month[i][COST_TRANSPORTED_GOOD] = veh_month[TT_ALL][i][ATV_DELIVERED_PASSENGER];
-		finance_history_month[i][COST_ALL_CONVOIS]      = com_month[i][ATC_ALL_CONVOIS];
-		finance_history_month[i][COST_SCENARIO_COMPLETED] = com_month[i][ATC_SCENARIO_COMPLETED];
-		finance_history_month[i][COST_WAY_TOLLS]        = veh_month[TT_ALL][i][ATV_WAY_TOLL];
+		finance_history_month[i][COST_CONSTRUCTION] = veh_month[TT_ALL].at(i, ATV_CONSTRUCTION_COST);
+		finance_history_month[i][COST_VEHICLE_RUN]  = veh_month[TT_ALL].at(i, ATV_RUNNING_COST) + veh_month[TT_ALL].at(i, ATV_VEHICLE_MAINTENANCE);
+		finance_history_month[i][COST_NEW_VEHICLE]  = veh_month[TT_ALL].at(i, ATV_NEW_VEHICLE);
+		finance_history_month[i][COST_INCOME]       = veh_month[TT_ALL].at(i, ATV_REVENUE_TRANSPORT);
+		finance_history_month[i][COST_MAINTENANCE]  = veh_month[TT_ALL].at(i, ATV_INFRASTRUCTURE_MAINTENANCE);
+		finance_history_month[i][COST_ASSETS]       = veh_month[TT_ALL].at(i, ATV_NON_FINANCIAL_ASSETS);
+		finance_history_month[i][COST_CASH]         = com_month.at(i, ATC_CASH);
+		finance_history_month[i][COST_NETWEALTH]    = com_month.at(i, ATC_NETWEALTH);
+		finance_history_month[i][COST_PROFIT]       = veh_month[TT_ALL].at(i, ATV_PROFIT);
+		finance_history_month[i][COST_OPERATING_PROFIT] = veh_month[TT_ALL].at(i, ATV_OPERATING_PROFIT);
+		finance_history_month[i][COST_MARGIN]           = veh_month[TT_ALL].at(i, ATV_PROFIT_MARGIN);
+		finance_history_month[i][COST_ALL_TRANSPORTED]  = veh_month[TT_ALL].at(i, ATV_TRANSPORTED);
+		finance_history_month[i][COST_POWERLINES]       = veh_month[TT_POWERLINE].at(i, ATV_REVENUE);
+		finance_history_month[i][COST_TRANSPORTED_PAS]  = veh_month[TT_ALL].at(i, ATV_DELIVERED_PASSENGER);
+		finance_history_month[i][COST_TRANSPORTED_MAIL] = veh_month[TT_ALL].at(i, ATV_DELIVERED_MAIL);
+		finance_history_month[i][COST_TRANSPORTED_GOOD] = veh_month[TT_ALL].at(i, ATV_DELIVERED_PASSENGER);
+		finance_history_month[i][COST_ALL_CONVOIS]      = com_month.at(i, ATC_ALL_CONVOIS);
+		finance_history_month[i][COST_SCENARIO_COMPLETED] = com_month.at(i, ATC_SCENARIO_COMPLETED);
+		finance_history_month[i][COST_WAY_TOLLS]        = veh_month[TT_ALL].at(i, ATV_WAY_TOLL);
 	}
 }
 
@@ -459,25 +413,25 @@ void finance_t::export_to_cost_year( sint64 finance_history_year[][OLD_MAX_PLAYE
 {
 	calc_finance_history();
 	for(int i=0; i<OLD_MAX_PLAYER_HISTORY_YEARS; ++i){
-		finance_history_year[i][COST_CONSTRUCTION] = veh_year[TT_ALL][i][ATV_CONSTRUCTION_COST];
-		finance_history_year[i][COST_VEHICLE_RUN]  = veh_year[TT_ALL][i][ATV_RUNNING_COST] + veh_month[TT_ALL][i][ATV_VEHICLE_MAINTENANCE];
-		finance_history_year[i][COST_NEW_VEHICLE]  = veh_year[TT_ALL][i][ATV_NEW_VEHICLE];
-		finance_history_year[i][COST_INCOME]       = veh_year[TT_ALL][i][ATV_REVENUE_TRANSPORT];
-		finance_history_year[i][COST_MAINTENANCE]  = veh_year[TT_ALL][i][ATV_INFRASTRUCTURE_MAINTENANCE];
-		finance_history_year[i][COST_ASSETS]       = veh_year[TT_ALL][i][ATV_NON_FINANCIAL_ASSETS];
-		finance_history_year[i][COST_CASH]         = com_year[i][ATC_CASH];
-		finance_history_year[i][COST_NETWEALTH]    = com_year[i][ATC_NETWEALTH];
-		finance_history_year[i][COST_PROFIT]       = veh_year[TT_ALL][i][ATV_PROFIT];
-		finance_history_year[i][COST_OPERATING_PROFIT] = veh_year[TT_ALL][i][ATV_OPERATING_PROFIT];
-		finance_history_year[i][COST_MARGIN]           = veh_year[TT_ALL][i][ATV_PROFIT_MARGIN];
-		finance_history_year[i][COST_ALL_TRANSPORTED]  = veh_year[TT_ALL][i][ATV_TRANSPORTED];
-		finance_history_year[i][COST_POWERLINES]       = veh_year[TT_POWERLINE][i][ATV_REVENUE];
-		finance_history_year[i][COST_TRANSPORTED_PAS]  = veh_year[TT_ALL][i][ATV_DELIVERED_PASSENGER];
-		finance_history_year[i][COST_TRANSPORTED_MAIL] = veh_year[TT_ALL][i][ATV_DELIVERED_MAIL];
-		finance_history_year[i][COST_TRANSPORTED_GOOD] = veh_year[TT_ALL][i][ATV_DELIVERED_GOOD];
-		finance_history_year[i][COST_ALL_CONVOIS]      = com_year[i][ATC_ALL_CONVOIS];
-		finance_history_year[i][COST_SCENARIO_COMPLETED] = com_year[i][ATC_SCENARIO_COMPLETED];
-		finance_history_year[i][COST_WAY_TOLLS]        = veh_year[TT_ALL][i][ATV_WAY_TOLL];
+		finance_history_year[i][COST_CONSTRUCTION] = veh_year[TT_ALL].at(i, ATV_CONSTRUCTION_COST);
+		finance_history_year[i][COST_VEHICLE_RUN]  = veh_year[TT_ALL].at(i, ATV_RUNNING_COST) + veh_month[TT_ALL].at(i, ATV_VEHICLE_MAINTENANCE);
+		finance_history_year[i][COST_NEW_VEHICLE]  = veh_year[TT_ALL].at(i, ATV_NEW_VEHICLE);
+		finance_history_year[i][COST_INCOME]       = veh_year[TT_ALL].at(i, ATV_REVENUE_TRANSPORT);
+		finance_history_year[i][COST_MAINTENANCE]  = veh_year[TT_ALL].at(i, ATV_INFRASTRUCTURE_MAINTENANCE);
+		finance_history_year[i][COST_ASSETS]       = veh_year[TT_ALL].at(i, ATV_NON_FINANCIAL_ASSETS);
+		finance_history_year[i][COST_CASH]         = com_year.at(i, ATC_CASH);
+		finance_history_year[i][COST_NETWEALTH]    = com_year.at(i, ATC_NETWEALTH);
+		finance_history_year[i][COST_PROFIT]       = veh_year[TT_ALL].at(i, ATV_PROFIT);
+		finance_history_year[i][COST_OPERATING_PROFIT] = veh_year[TT_ALL].at(i, ATV_OPERATING_PROFIT);
+		finance_history_year[i][COST_MARGIN]           = veh_year[TT_ALL].at(i, ATV_PROFIT_MARGIN);
+		finance_history_year[i][COST_ALL_TRANSPORTED]  = veh_year[TT_ALL].at(i, ATV_TRANSPORTED);
+		finance_history_year[i][COST_POWERLINES]       = veh_year[TT_POWERLINE].at(i, ATV_REVENUE);
+		finance_history_year[i][COST_TRANSPORTED_PAS]  = veh_year[TT_ALL].at(i, ATV_DELIVERED_PASSENGER);
+		finance_history_year[i][COST_TRANSPORTED_MAIL] = veh_year[TT_ALL].at(i, ATV_DELIVERED_MAIL);
+		finance_history_year[i][COST_TRANSPORTED_GOOD] = veh_year[TT_ALL].at(i, ATV_DELIVERED_GOOD);
+		finance_history_year[i][COST_ALL_CONVOIS]      = com_year.at(i, ATC_ALL_CONVOIS);
+		finance_history_year[i][COST_SCENARIO_COMPLETED] = com_year.at(i, ATC_SCENARIO_COMPLETED);
+		finance_history_year[i][COST_WAY_TOLLS]        = veh_year[TT_ALL].at(i, ATV_WAY_TOLL);
 	}
 }
 
@@ -486,49 +440,49 @@ void finance_t::import_from_cost_month(const sint64 finance_history_month[][OLD_
 {
 	// does it need initial clean-up ? (= initialization)
 	for(int i=0; i<OLD_MAX_PLAYER_HISTORY_MONTHS; ++i){
-		veh_month[TT_OTHER][i][ATV_CONSTRUCTION_COST] = finance_history_month[i][COST_CONSTRUCTION];
-		veh_month[TT_ALL  ][i][ATV_CONSTRUCTION_COST] = finance_history_month[i][COST_CONSTRUCTION];
-		veh_month[TT_OTHER][i][ATV_RUNNING_COST]      = finance_history_month[i][COST_VEHICLE_RUN];
-		veh_month[TT_ALL  ][i][ATV_RUNNING_COST]      = finance_history_month[i][COST_VEHICLE_RUN];
-		veh_month[TT_OTHER][i][ATV_NEW_VEHICLE]       = finance_history_month[i][COST_NEW_VEHICLE];
-		veh_month[TT_ALL  ][i][ATV_NEW_VEHICLE]       = finance_history_month[i][COST_NEW_VEHICLE];
+		veh_month[TT_OTHER].at(i, ATV_CONSTRUCTION_COST) = finance_history_month[i][COST_CONSTRUCTION];
+		veh_month[TT_ALL  ].at(i, ATV_CONSTRUCTION_COST) = finance_history_month[i][COST_CONSTRUCTION];
+		veh_month[TT_OTHER].at(i, ATV_RUNNING_COST)      = finance_history_month[i][COST_VEHICLE_RUN];
+		veh_month[TT_ALL  ].at(i, ATV_RUNNING_COST)      = finance_history_month[i][COST_VEHICLE_RUN];
+		veh_month[TT_OTHER].at(i, ATV_NEW_VEHICLE)       = finance_history_month[i][COST_NEW_VEHICLE];
+		veh_month[TT_ALL  ].at(i, ATV_NEW_VEHICLE)       = finance_history_month[i][COST_NEW_VEHICLE];
 		// he have to store it in _GOOD for not being override in calc_finance history() to 0
-		veh_month[TT_OTHER][i][ATV_REVENUE_GOOD]      = finance_history_month[i][COST_INCOME];
-		veh_month[TT_ALL  ][i][ATV_REVENUE_GOOD]      = finance_history_month[i][COST_INCOME];
-		veh_month[TT_OTHER][i][ATV_REVENUE_TRANSPORT]      = finance_history_month[i][COST_INCOME];
-		veh_month[TT_ALL  ][i][ATV_REVENUE_TRANSPORT]      = finance_history_month[i][COST_INCOME];
-		veh_month[TT_OTHER][i][ATV_INFRASTRUCTURE_MAINTENANCE] = finance_history_month[i][COST_MAINTENANCE];
-		veh_month[TT_ALL  ][i][ATV_INFRASTRUCTURE_MAINTENANCE] = finance_history_month[i][COST_MAINTENANCE];
-		veh_month[TT_OTHER][i][ATV_NON_FINANCIAL_ASSETS] = finance_history_month[i][COST_ASSETS];
-		veh_month[TT_ALL  ][i][ATV_NON_FINANCIAL_ASSETS] = finance_history_month[i][COST_ASSETS];
-		com_month[i][ATC_CASH]                        = finance_history_month[i][COST_CASH];
-		com_month[i][ATC_NETWEALTH]                   = finance_history_month[i][COST_NETWEALTH];
-		veh_month[TT_OTHER][i][ATV_PROFIT]            = finance_history_month[i][COST_PROFIT];
-		veh_month[TT_ALL  ][i][ATV_PROFIT]            = finance_history_month[i][COST_PROFIT];
-		veh_month[TT_OTHER][i][ATV_OPERATING_PROFIT]  = finance_history_month[i][COST_OPERATING_PROFIT];
-		veh_month[TT_ALL  ][i][ATV_OPERATING_PROFIT]  = finance_history_month[i][COST_OPERATING_PROFIT];
-		veh_month[TT_ALL  ][i][ATV_PROFIT_MARGIN]     = finance_history_month[i][COST_MARGIN]; // this needs to be recalculate before usage
-		veh_month[TT_OTHER][i][ATV_TRANSPORTED]       = finance_history_month[i][COST_ALL_TRANSPORTED];
-		veh_month[TT_ALL  ][i][ATV_TRANSPORTED]       = finance_history_month[i][COST_ALL_TRANSPORTED];
-		veh_month[TT_POWERLINE][i][ATV_REVENUE]       = finance_history_month[i][COST_POWERLINES];
-		veh_month[TT_OTHER][i][ATV_DELIVERED_PASSENGER] = finance_history_month[i][COST_TRANSPORTED_PAS];
-		veh_month[TT_ALL  ][i][ATV_DELIVERED_PASSENGER] = finance_history_month[i][COST_TRANSPORTED_PAS];
-		veh_month[TT_OTHER][i][ATV_DELIVERED_MAIL]  = finance_history_month[i][COST_TRANSPORTED_MAIL];
-		veh_month[TT_ALL  ][i][ATV_DELIVERED_MAIL]  = finance_history_month[i][COST_TRANSPORTED_MAIL];
-		veh_month[TT_OTHER][i][ATV_DELIVERED_GOOD]  = finance_history_month[i][COST_TRANSPORTED_GOOD];
-		veh_month[TT_ALL  ][i][ATV_DELIVERED_GOOD]  = finance_history_month[i][COST_TRANSPORTED_GOOD];
-		com_month[i][ATC_ALL_CONVOIS]                 = finance_history_month[i][COST_ALL_CONVOIS];
-		com_month[i][ATC_SCENARIO_COMPLETED]          = finance_history_month[i][COST_SCENARIO_COMPLETED];
+		veh_month[TT_OTHER].at(i, ATV_REVENUE_GOOD)      = finance_history_month[i][COST_INCOME];
+		veh_month[TT_ALL  ].at(i, ATV_REVENUE_GOOD)      = finance_history_month[i][COST_INCOME];
+		veh_month[TT_OTHER].at(i, ATV_REVENUE_TRANSPORT)      = finance_history_month[i][COST_INCOME];
+		veh_month[TT_ALL  ].at(i, ATV_REVENUE_TRANSPORT)      = finance_history_month[i][COST_INCOME];
+		veh_month[TT_OTHER].at(i, ATV_INFRASTRUCTURE_MAINTENANCE) = finance_history_month[i][COST_MAINTENANCE];
+		veh_month[TT_ALL  ].at(i, ATV_INFRASTRUCTURE_MAINTENANCE) = finance_history_month[i][COST_MAINTENANCE];
+		veh_month[TT_OTHER].at(i, ATV_NON_FINANCIAL_ASSETS) = finance_history_month[i][COST_ASSETS];
+		veh_month[TT_ALL  ].at(i, ATV_NON_FINANCIAL_ASSETS) = finance_history_month[i][COST_ASSETS];
+		com_month.at(i, ATC_CASH)                        = finance_history_month[i][COST_CASH];
+		com_month.at(i, ATC_NETWEALTH)                   = finance_history_month[i][COST_NETWEALTH];
+		veh_month[TT_OTHER].at(i, ATV_PROFIT)            = finance_history_month[i][COST_PROFIT];
+		veh_month[TT_ALL  ].at(i, ATV_PROFIT)            = finance_history_month[i][COST_PROFIT];
+		veh_month[TT_OTHER].at(i, ATV_OPERATING_PROFIT)  = finance_history_month[i][COST_OPERATING_PROFIT];
+		veh_month[TT_ALL  ].at(i, ATV_OPERATING_PROFIT)  = finance_history_month[i][COST_OPERATING_PROFIT];
+		veh_month[TT_ALL  ].at(i, ATV_PROFIT_MARGIN)     = finance_history_month[i][COST_MARGIN]; // this needs to be recalculate before usage
+		veh_month[TT_OTHER].at(i, ATV_TRANSPORTED)       = finance_history_month[i][COST_ALL_TRANSPORTED];
+		veh_month[TT_ALL  ].at(i, ATV_TRANSPORTED)       = finance_history_month[i][COST_ALL_TRANSPORTED];
+		veh_month[TT_POWERLINE].at(i, ATV_REVENUE)       = finance_history_month[i][COST_POWERLINES];
+		veh_month[TT_OTHER].at(i, ATV_DELIVERED_PASSENGER) = finance_history_month[i][COST_TRANSPORTED_PAS];
+		veh_month[TT_ALL  ].at(i, ATV_DELIVERED_PASSENGER) = finance_history_month[i][COST_TRANSPORTED_PAS];
+		veh_month[TT_OTHER].at(i, ATV_DELIVERED_MAIL)  = finance_history_month[i][COST_TRANSPORTED_MAIL];
+		veh_month[TT_ALL  ].at(i, ATV_DELIVERED_MAIL)  = finance_history_month[i][COST_TRANSPORTED_MAIL];
+		veh_month[TT_OTHER].at(i, ATV_DELIVERED_GOOD)  = finance_history_month[i][COST_TRANSPORTED_GOOD];
+		veh_month[TT_ALL  ].at(i, ATV_DELIVERED_GOOD)  = finance_history_month[i][COST_TRANSPORTED_GOOD];
+		com_month.at(i, ATC_ALL_CONVOIS)                 = finance_history_month[i][COST_ALL_CONVOIS];
+		com_month.at(i, ATC_SCENARIO_COMPLETED)          = finance_history_month[i][COST_SCENARIO_COMPLETED];
 		if(finance_history_month[i][COST_WAY_TOLLS] > 0 ){
-			veh_month[TT_OTHER][i][ATV_TOLL_RECEIVED] = finance_history_month[i][COST_WAY_TOLLS];
-			veh_month[TT_ALL  ][i][ATV_TOLL_RECEIVED] = finance_history_month[i][COST_WAY_TOLLS];
+			veh_month[TT_OTHER].at(i, ATV_TOLL_RECEIVED) = finance_history_month[i][COST_WAY_TOLLS];
+			veh_month[TT_ALL  ].at(i, ATV_TOLL_RECEIVED) = finance_history_month[i][COST_WAY_TOLLS];
 		}
 		else{
-			veh_month[TT_OTHER][i][ATV_TOLL_PAID] = finance_history_month[i][COST_WAY_TOLLS];
-			veh_month[TT_ALL  ][i][ATV_TOLL_PAID] = finance_history_month[i][COST_WAY_TOLLS];
+			veh_month[TT_OTHER].at(i, ATV_TOLL_PAID) = finance_history_month[i][COST_WAY_TOLLS];
+			veh_month[TT_ALL  ].at(i, ATV_TOLL_PAID) = finance_history_month[i][COST_WAY_TOLLS];
 		}
-		veh_month[TT_OTHER][i][ATV_WAY_TOLL] = finance_history_month[i][COST_WAY_TOLLS];
-		veh_month[TT_ALL  ][i][ATV_WAY_TOLL] = finance_history_month[i][COST_WAY_TOLLS];
+		veh_month[TT_OTHER].at(i, ATV_WAY_TOLL) = finance_history_month[i][COST_WAY_TOLLS];
+		veh_month[TT_ALL  ].at(i, ATV_WAY_TOLL) = finance_history_month[i][COST_WAY_TOLLS];
 	}
 }
 
@@ -536,52 +490,52 @@ void finance_t::import_from_cost_month(const sint64 finance_history_month[][OLD_
 void finance_t::import_from_cost_year( const sint64 finance_history_year[][OLD_MAX_PLAYER_COST])
 {
 	for(int i=0; i<OLD_MAX_PLAYER_HISTORY_YEARS; ++i){
-		veh_year[TT_OTHER][i][ATV_CONSTRUCTION_COST] = finance_history_year[i][COST_CONSTRUCTION];
-		veh_year[TT_ALL  ][i][ATV_CONSTRUCTION_COST] = finance_history_year[i][COST_CONSTRUCTION];
-		veh_year[TT_OTHER][i][ATV_RUNNING_COST]      = finance_history_year[i][COST_VEHICLE_RUN];
-		veh_year[TT_ALL  ][i][ATV_RUNNING_COST]      = finance_history_year[i][COST_VEHICLE_RUN];
-		veh_year[TT_OTHER][i][ATV_NEW_VEHICLE]       = finance_history_year[i][COST_NEW_VEHICLE];
-		veh_year[TT_ALL  ][i][ATV_NEW_VEHICLE]       = finance_history_year[i][COST_NEW_VEHICLE];
+		veh_year[TT_OTHER].at(i, ATV_CONSTRUCTION_COST) = finance_history_year[i][COST_CONSTRUCTION];
+		veh_year[TT_ALL  ].at(i, ATV_CONSTRUCTION_COST) = finance_history_year[i][COST_CONSTRUCTION];
+		veh_year[TT_OTHER].at(i, ATV_RUNNING_COST)      = finance_history_year[i][COST_VEHICLE_RUN];
+		veh_year[TT_ALL  ].at(i, ATV_RUNNING_COST)      = finance_history_year[i][COST_VEHICLE_RUN];
+		veh_year[TT_OTHER].at(i, ATV_NEW_VEHICLE)       = finance_history_year[i][COST_NEW_VEHICLE];
+		veh_year[TT_ALL  ].at(i, ATV_NEW_VEHICLE)       = finance_history_year[i][COST_NEW_VEHICLE];
 		// we have to store it in _GOOD for not being override in calc_finance history() to 0
-		veh_year[TT_OTHER][i][ATV_REVENUE_GOOD]      = finance_history_year[i][COST_INCOME];
-		veh_year[TT_ALL  ][i][ATV_REVENUE_GOOD]      = finance_history_year[i][COST_INCOME];
-		veh_year[TT_OTHER][i][ATV_REVENUE_TRANSPORT]      = finance_history_year[i][COST_INCOME];
-		veh_year[TT_ALL  ][i][ATV_REVENUE_TRANSPORT]      = finance_history_year[i][COST_INCOME];
-		veh_year[TT_OTHER][i][ATV_INFRASTRUCTURE_MAINTENANCE] = finance_history_year[i][COST_MAINTENANCE];
-		veh_year[TT_ALL  ][i][ATV_INFRASTRUCTURE_MAINTENANCE] = finance_history_year[i][COST_MAINTENANCE];
-		veh_year[TT_OTHER][i][ATV_NON_FINANCIAL_ASSETS] = finance_history_year[i][COST_ASSETS];
-		veh_year[TT_ALL  ][i][ATV_NON_FINANCIAL_ASSETS] = finance_history_year[i][COST_ASSETS];
-		com_year[i][ATC_CASH]                        = finance_history_year[i][COST_CASH];
-		com_year[i][ATC_NETWEALTH]                   = finance_history_year[i][COST_NETWEALTH];
-		veh_year[TT_OTHER][i][ATV_PROFIT]            = finance_history_year[i][COST_PROFIT];
-		veh_year[TT_ALL  ][i][ATV_PROFIT]            = finance_history_year[i][COST_PROFIT];
-		veh_year[TT_OTHER][i][ATV_OPERATING_PROFIT]  = finance_history_year[i][COST_OPERATING_PROFIT];
-		veh_year[TT_ALL  ][i][ATV_OPERATING_PROFIT]  = finance_history_year[i][COST_OPERATING_PROFIT];
-		veh_year[TT_ALL  ][i][ATV_PROFIT_MARGIN]     = finance_history_year[i][COST_MARGIN]; // this needs to be recalculate before usage
+		veh_year[TT_OTHER].at(i, ATV_REVENUE_GOOD)      = finance_history_year[i][COST_INCOME];
+		veh_year[TT_ALL  ].at(i, ATV_REVENUE_GOOD)      = finance_history_year[i][COST_INCOME];
+		veh_year[TT_OTHER].at(i, ATV_REVENUE_TRANSPORT)      = finance_history_year[i][COST_INCOME];
+		veh_year[TT_ALL  ].at(i, ATV_REVENUE_TRANSPORT)      = finance_history_year[i][COST_INCOME];
+		veh_year[TT_OTHER].at(i, ATV_INFRASTRUCTURE_MAINTENANCE) = finance_history_year[i][COST_MAINTENANCE];
+		veh_year[TT_ALL  ].at(i, ATV_INFRASTRUCTURE_MAINTENANCE) = finance_history_year[i][COST_MAINTENANCE];
+		veh_year[TT_OTHER].at(i, ATV_NON_FINANCIAL_ASSETS) = finance_history_year[i][COST_ASSETS];
+		veh_year[TT_ALL  ].at(i, ATV_NON_FINANCIAL_ASSETS) = finance_history_year[i][COST_ASSETS];
+		com_year.at(i, ATC_CASH)                        = finance_history_year[i][COST_CASH];
+		com_year.at(i, ATC_NETWEALTH)                   = finance_history_year[i][COST_NETWEALTH];
+		veh_year[TT_OTHER].at(i, ATV_PROFIT)            = finance_history_year[i][COST_PROFIT];
+		veh_year[TT_ALL  ].at(i, ATV_PROFIT)            = finance_history_year[i][COST_PROFIT];
+		veh_year[TT_OTHER].at(i, ATV_OPERATING_PROFIT)  = finance_history_year[i][COST_OPERATING_PROFIT];
+		veh_year[TT_ALL  ].at(i, ATV_OPERATING_PROFIT)  = finance_history_year[i][COST_OPERATING_PROFIT];
+		veh_year[TT_ALL  ].at(i, ATV_PROFIT_MARGIN)     = finance_history_year[i][COST_MARGIN]; // this needs to be recalculate before usage
 		// we have to store it in ATV_TRANSPORTED_GOOD, otherwise calc_finance_history will set ATV_TRANSPORTED to 0
-		veh_year[TT_OTHER][i][ATV_TRANSPORTED_GOOD]  = finance_history_year[i][COST_ALL_TRANSPORTED];
-		veh_year[TT_ALL  ][i][ATV_TRANSPORTED_GOOD]  = finance_history_year[i][COST_ALL_TRANSPORTED];
-		veh_year[TT_OTHER][i][ATV_TRANSPORTED]       = finance_history_year[i][COST_ALL_TRANSPORTED];
-		veh_year[TT_ALL  ][i][ATV_TRANSPORTED]       = finance_history_year[i][COST_ALL_TRANSPORTED];
-		veh_year[TT_POWERLINE][i][ATV_REVENUE]       = finance_history_year[i][COST_POWERLINES];
-		veh_year[TT_OTHER][i][ATV_DELIVERED_PASSENGER] = finance_history_year[i][COST_TRANSPORTED_PAS];
-		veh_year[TT_ALL  ][i][ATV_DELIVERED_PASSENGER] = finance_history_year[i][COST_TRANSPORTED_PAS];
-		veh_year[TT_OTHER][i][ATV_DELIVERED_MAIL]    = finance_history_year[i][COST_TRANSPORTED_MAIL];
-		veh_year[TT_ALL  ][i][ATV_DELIVERED_MAIL]    = finance_history_year[i][COST_TRANSPORTED_MAIL];
-		veh_year[TT_OTHER][i][ATV_DELIVERED_GOOD]    = finance_history_year[i][COST_TRANSPORTED_GOOD];
-		veh_year[TT_ALL  ][i][ATV_DELIVERED_GOOD]    = finance_history_year[i][COST_TRANSPORTED_GOOD];
-		com_year[i][ATC_ALL_CONVOIS]                 = finance_history_year[i][COST_ALL_CONVOIS];
-		com_year[i][ATC_SCENARIO_COMPLETED]          = finance_history_year[i][COST_SCENARIO_COMPLETED];
+		veh_year[TT_OTHER].at(i, ATV_TRANSPORTED_GOOD)  = finance_history_year[i][COST_ALL_TRANSPORTED];
+		veh_year[TT_ALL  ].at(i, ATV_TRANSPORTED_GOOD)  = finance_history_year[i][COST_ALL_TRANSPORTED];
+		veh_year[TT_OTHER].at(i, ATV_TRANSPORTED)       = finance_history_year[i][COST_ALL_TRANSPORTED];
+		veh_year[TT_ALL  ].at(i, ATV_TRANSPORTED)       = finance_history_year[i][COST_ALL_TRANSPORTED];
+		veh_year[TT_POWERLINE].at(i, ATV_REVENUE)       = finance_history_year[i][COST_POWERLINES];
+		veh_year[TT_OTHER].at(i, ATV_DELIVERED_PASSENGER) = finance_history_year[i][COST_TRANSPORTED_PAS];
+		veh_year[TT_ALL  ].at(i, ATV_DELIVERED_PASSENGER) = finance_history_year[i][COST_TRANSPORTED_PAS];
+		veh_year[TT_OTHER].at(i, ATV_DELIVERED_MAIL)    = finance_history_year[i][COST_TRANSPORTED_MAIL];
+		veh_year[TT_ALL  ].at(i, ATV_DELIVERED_MAIL)    = finance_history_year[i][COST_TRANSPORTED_MAIL];
+		veh_year[TT_OTHER].at(i, ATV_DELIVERED_GOOD)    = finance_history_year[i][COST_TRANSPORTED_GOOD];
+		veh_year[TT_ALL  ].at(i, ATV_DELIVERED_GOOD)    = finance_history_year[i][COST_TRANSPORTED_GOOD];
+		com_year.at(i, ATC_ALL_CONVOIS)                 = finance_history_year[i][COST_ALL_CONVOIS];
+		com_year.at(i, ATC_SCENARIO_COMPLETED)          = finance_history_year[i][COST_SCENARIO_COMPLETED];
 		if(finance_history_year[i][COST_WAY_TOLLS] > 0 ){
-			veh_year[TT_OTHER][i][ATV_TOLL_RECEIVED] = finance_history_year[i][COST_WAY_TOLLS];
-			veh_year[TT_ALL  ][i][ATV_TOLL_RECEIVED] = finance_history_year[i][COST_WAY_TOLLS];
+			veh_year[TT_OTHER].at(i, ATV_TOLL_RECEIVED) = finance_history_year[i][COST_WAY_TOLLS];
+			veh_year[TT_ALL  ].at(i, ATV_TOLL_RECEIVED) = finance_history_year[i][COST_WAY_TOLLS];
 		}
 		else{
-			veh_year[TT_OTHER][i][ATV_TOLL_PAID] = finance_history_year[i][COST_WAY_TOLLS];
-			veh_year[TT_ALL  ][i][ATV_TOLL_PAID] = finance_history_year[i][COST_WAY_TOLLS];
+			veh_year[TT_OTHER].at(i, ATV_TOLL_PAID) = finance_history_year[i][COST_WAY_TOLLS];
+			veh_year[TT_ALL  ].at(i, ATV_TOLL_PAID) = finance_history_year[i][COST_WAY_TOLLS];
 		}
-		veh_year[TT_OTHER][i][ATV_WAY_TOLL] = finance_history_year[i][COST_WAY_TOLLS];
-		veh_year[TT_ALL  ][i][ATV_WAY_TOLL] = finance_history_year[i][COST_WAY_TOLLS];
+		veh_year[TT_OTHER].at(i, ATV_WAY_TOLL) = finance_history_year[i][COST_WAY_TOLLS];
+		veh_year[TT_ALL  ].at(i, ATV_WAY_TOLL) = finance_history_year[i][COST_WAY_TOLLS];
 	}
 }
 
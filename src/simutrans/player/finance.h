@@ -10,6 +10,7 @@
 #include <assert.h>
 
 #include "../simtypes.h"
+#include "../tpl/history_tpl.h"
 
 /// for compatibility with old versions
 #define OLD_MAX_PLAYER_COST (19)
@@ -150,18 +151,18 @@ class finance_t {
 	 * Contains values having relation with whole company but not with particular
 	 * type of transport (com - common).
 	 */
-	sint64 com_year[MAX_PLAYER_HISTORY_YEARS][ATC_MAX];
+	history_tpl<sint64, MAX_PLAYER_HISTORY_YEARS, ATC_MAX> com_year;
 
 	/**
 	 * Monthly finance history, data not distinguishable by transport type.
 	 */
-	sint64 com_month[MAX_PLAYER_HISTORY_MONTHS][ATC_MAX];
+	history_tpl<sint64, MAX_PLAYER_HISTORY_MONTHS, ATC_MAX> com_month;
 
 	/**
 	 * Finance history having relation with particular type of service
 	 */
-	sint64 veh_year[TT_MAX][MAX_PLAYER_HISTORY_YEARS][ATV_MAX];
-	sint64 veh_month[TT_MAX][MAX_PLAYER_HISTORY_MONTHS][ATV_MAX];
+	history_tpl<sint64, MAX_PLAYER_HISTORY_YEARS, ATV_MAX> veh_year[TT_MAX];
+	history_tpl<sint64, MAX_PLAYER_HISTORY_MONTHS, ATV_MAX> veh_month[TT_MAX];
 
 	/**
 	 * Monthly maintenance cost
@@ -183,8 +184,8 @@ public:
 	 */
 	inline void book_construction_costs(const sint64 amount, const waytype_t wt) {
 		transport_type tt = translate_waytype_to_tt(wt);
-		veh_year[tt][0][ATV_CONSTRUCTION_COST] += amount;
-		veh_month[tt][0][ATV_CONSTRUCTION_COST] += amount;
+		veh_year[tt].at(0, ATV_CONSTRUCTION_COST) += amount;
+		veh_month[tt].at(0, ATV_CONSTRUCTION_COST) += amount;
 
 		account_balance += amount;
 	}
@@ -193,8 +194,8 @@ public:
 	 * Adds count to number of convois in statistics.
 	 */
 	inline void book_convoi_number( const int count ) {
-		com_year[0][ATC_ALL_CONVOIS] += count;
-		com_month[0][ATC_ALL_CONVOIS] += count;
+		com_year.at(0, ATC_ALL_CONVOIS) += count;
+		com_month.at(0, ATC_ALL_CONVOIS) += count;
 	}
 
 	/**
@@ -219,8 +220,8 @@ public:
 	{
 		const transport_type tt = translate_waytype_to_tt(wt);
 
-		veh_year[ tt][0][ATV_NEW_VEHICLE] += amount;
-		veh_month[tt][0][ATV_NEW_VEHICLE] += amount;
+		veh_year[ tt].at(0, ATV_NEW_VEHICLE) += amount;
+		veh_month[tt].at(0, ATV_NEW_VEHICLE) += amount;
 
 		update_assets(-amount, wt);
 
@@ -239,8 +240,8 @@ public:
 
 		index = ((0 <= index) && (index <= 2)? index : 2);
 
-		veh_year[tt][0][ATV_REVENUE_PASSENGER+index] += amount;
-		veh_month[tt][0][ATV_REVENUE_PASSENGER+index] += amount;
+		veh_year[tt].at(0, ATV_REVENUE_PASSENGER+index) += amount;
+		veh_month[tt].at(0, ATV_REVENUE_PASSENGER+index) += amount;
 
 		account_balance += amount;
 	}
@@ -253,8 +254,8 @@ public:
 	inline void book_running_costs(const sint64 amount, const waytype_t wt)
 	{
 		const transport_type tt = translate_waytype_to_tt(wt);
-		veh_year[tt][0][ATV_RUNNING_COST] += amount;
-		veh_month[tt][0][ATV_RUNNING_COST] += amount;
+		veh_year[tt].at(0, ATV_RUNNING_COST) += amount;
+		veh_month[tt].at(0, ATV_RUNNING_COST) += amount;
 		account_balance += amount;
 	}
 
@@ -266,8 +267,8 @@ public:
 	inline void book_toll_paid(const sint64 amount, const waytype_t wt)
 	{
 		const transport_type tt =  translate_waytype_to_tt(wt);
-		veh_year[tt][0][ATV_TOLL_PAID] += amount;
-		veh_month[tt][0][ATV_TOLL_PAID] += amount;
+		veh_year[tt].at(0, ATV_TOLL_PAID) += amount;
+		veh_month[tt].at(0, ATV_TOLL_PAID) += amount;
 		account_balance += amount;
 	}
 
@@ -279,8 +280,8 @@ public:
 	inline void book_toll_received(const sint64 amount, const waytype_t wt)
 	{
 		const transport_type tt = translate_waytype_to_tt(wt);
-		veh_year[tt][0][ATV_TOLL_RECEIVED] += amount;
-		veh_month[tt][0][ATV_TOLL_RECEIVED] += amount;
+		veh_year[tt].at(0, ATV_TOLL_RECEIVED) += amount;
+		veh_month[tt].at(0, ATV_TOLL_RECEIVED) += amount;
 		account_balance += amount;
 	}
 
@@ -299,8 +300,8 @@ public:
 			index = 2;
 		}
 
-		veh_year[ tt][0][ATV_TRANSPORTED_PASSENGER+index] += amount;
-		veh_month[tt][0][ATV_TRANSPORTED_PASSENGER+index] += amount;
+		veh_year[ tt].at(0, ATV_TRANSPORTED_PASSENGER+index) += amount;
+		veh_month[tt].at(0, ATV_TRANSPORTED_PASSENGER+index) += amount;
 	}
 
 
@@ -319,8 +320,8 @@ public:
 			index = 2;
 		}
 
-		veh_year[ tt][0][ATV_DELIVERED_PASSENGER+index] += amount;
-		veh_month[tt][0][ATV_DELIVERED_PASSENGER+index] += amount;
+		veh_year[ tt].at(0, ATV_DELIVERED_PASSENGER+index) += amount;
+		veh_month[tt].at(0, ATV_DELIVERED_PASSENGER+index) += amount;
 	}
 
 	/**
@@ -340,10 +341,10 @@ public:
 	void book_account(sint64 amount)
 	{
 		account_balance += amount;
-		com_month[0][ATC_CASH] = account_balance;
-		com_year [0][ATC_CASH] = account_balance;
-		com_month[0][ATC_NETWEALTH] += amount;
-		com_year [0][ATC_NETWEALTH] += amount;
+		com_month.at(0, ATC_CASH) = account_balance;
+		com_year.at(0, ATC_CASH) = account_balance;
+		com_month.at(0, ATC_NETWEALTH) += amount;
+		com_year.at(0, ATC_NETWEALTH) += amount;
 		// BUG profit is not adjusted when calling this method
 	}
 
@@ -353,8 +354,8 @@ public:
 	 * @param year 0 .. current year, 1 .. last year, etc
 	 * @param type one of accounting_type_common
 	 */
-	sint64 get_history_com_year(int year, int type) const { return com_year[year][type]; }
-	sint64 get_history_com_month(int month, int type) const { return com_month[month][type]; }
+	sint64 get_history_com_year(int year, int type) const { return com_year.at(year, type); }
+	sint64 get_history_com_month(int month, int type) const { return com_month.at(month, type); }
 
 	/**
 	 * Returns the finance history (distinguishable by type of transport) for player.
@@ -363,8 +364,8 @@ public:
 	 * @param year 0 .. current year, 1 .. last year, etc
 	 * @param type one of accounting_type_vehicles
 	 */
-	sint64 get_history_veh_year(transport_type tt, int year, int type) const { return veh_year[tt][year][type]; }
-	sint64 get_history_veh_month(transport_type tt, int month, int type) const { return veh_month[tt][month][type]; }
+	sint64 get_history_veh_year(transport_type tt, int year, int type) const { return veh_year[tt].at(year, type); }
+	sint64 get_history_veh_month(transport_type tt, int month, int type) const { return veh_month[tt].at(month, type); }
 
 	/**
 	 * @return how much month we have been in red numbers (= we had negative account balance)
@@ -384,14 +385,14 @@ public:
 
 	sint64 get_netwealth() const
 	{
-		// return com_year[0][ATC_NETWEALTH]; wont work as ATC_NETWEALTH is *only* updated in calc_finance_history
+		// return com_year.at(0, ATC_NETWEALTH); wont work as ATC_NETWEALTH is *only* updated in calc_finance_history
 		// see calc_finance_history
-		return veh_month[TT_ALL][0][ATV_NON_FINANCIAL_ASSETS] + account_balance;
+		return veh_month[TT_ALL].at(0, ATV_NON_FINANCIAL_ASSETS) + account_balance;
 	}
 
-	sint64 get_scenario_completed() const { return com_month[0][ATC_SCENARIO_COMPLETED]; }
+	sint64 get_scenario_completed() const { return com_month.at(0, ATC_SCENARIO_COMPLETED); }
 
-	void set_scenario_completed(sint64 percent) { com_year[0][ATC_SCENARIO_COMPLETED] = com_month[0][ATC_SCENARIO_COMPLETED] = percent; }
+	void set_scenario_completed(sint64 percent) { com_year.at(0, ATC_SCENARIO_COMPLETED) = com_month.at(0, ATC_SCENARIO_COMPLETED) = percent; }
 
 	sint64 get_starting_money() const { return starting_money; }
 
@@ -403,7 +404,7 @@ public:
 	/**
 	 * @returns TRUE if there is at least one convoi, otherwise returns false
 	 */
-	bool has_convoi() const { return (com_year[0][ATC_ALL_CONVOIS] > 0); }
+	bool has_convoi() const { return (com_year.at(0, ATC_ALL_CONVOIS) > 0); }
 
 	/**
 	 * returns TRUE if net wealth > 0 (but this of course requires that we keep netwealth up to date!)
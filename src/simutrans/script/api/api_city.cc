@@ -243,6 +243,14 @@ void export_city(HSQUIRRELVM vm)
 	 */
 	register_method(vm, &stadt_t::get_rechtsunten, "get_pos_se");
 
+	/**
+	 * Sum of the weights of all target cities of passengers and mail.
+	 * The weights depend on size and distance of the cities and are
+	 * recalculated once a month.
+	 * @returns total weight
+	 */
+	register_method(vm, &stadt_t::get_target_cities_weight, "get_target_cities_weight");
+
 	/**
 	 * Change city size. City will immediately grow.
 	 * @param delta City size will change by this number.
@@ -20,6 +20,7 @@
  * - Added @ref bridge_x, @ref tunnel_x
  * - Added @ref factory_x::get_fields_list, @ref world::get_label_list
  * - Added @ref schedule_x::current.
+ * - Added @ref city_x::get_target_cities_weight
  *
  * @section api-123 Release 123.0
  *
@@ -29,6 +29,7 @@ BEGIN {
 	export_types_scenario["city_x::get_pos"] = "coord()"
 	export_types_scenario["city_x::get_pos_nw"] = "coord()"
 	export_types_scenario["city_x::get_pos_se"] = "coord()"
+	export_types_scenario["city_x::get_target_cities_weight"] = "integer()"
 	export_types_scenario["city_x::change_size"] = "string(integer)"
 	export_types_scenario["city_x::set_citygrowth_enabled"] = "void(bool)"
 	export_types_scenario["::get_ops_total"] = "integer()"
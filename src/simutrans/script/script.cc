@@ -23,6 +23,7 @@
 #include "../gui/simwin.h"
 #include "../utils/cbuffer.h"
 #include "../utils/plainstring.h"
+#include "../utils/profiler.h"
 
 
 namespace script_api {
@@ -299,6 +300,7 @@ const char* script_vm_t::intern_finish_call(HSQUIRRELVM job, call_type_t ct, int
  */
 const char* script_vm_t::intern_call_function(HSQUIRRELVM job, call_type_t ct, int nparams, bool retvalue)
 {
+	PROFILE_SCOPE(SEC_SCRIPT);
 	BEGIN_STACK_WATCH(job);
 	dbg->message("script_vm_t::intern_call_function", "start: stack=%d nparams=%d ret=%d", sq_gettop(job), nparams, retvalue);
 	const char* err = NULL;
@@ -361,6 +363,7 @@ const char* script_vm_t::intern_call_function(HSQUIRRELVM job, call_type_t ct, i
 
 void script_vm_t::intern_resume_call(HSQUIRRELVM job)
 {
+	PROFILE_SCOPE(SEC_SCRIPT);
 	BEGIN_STACK_WATCH(job);
 	// stack: clean
 	// get retvalue flag
@@ -220,7 +220,7 @@ DBG_MESSAGE("convoi_t::~convoi_t()", "destroying %d, %p", self.get_id(), this);
 			destroy_win((ptrdiff_t)schedule);
 		}
 		if (!schedule->empty() && !line.is_bound()) {
-			welt->set_schedule_counter();
+			haltestelle_t::mark_connections_dirty( schedule, get_owner() );
 		}
 		delete schedule;
 	}
@@ -1412,16 +1412,11 @@ void convoi_t::new_month()
 	}
 	// update statistics of average speed
 	if(  maxspeed_average_count==0  ) {
-		financial_history[0][CONVOI_MAXSPEED] = distance_since_last_stop>0 ? get_speedbonus_kmh() : 0;
+		financial_history.at(0, CONVOI_MAXSPEED) = distance_since_last_stop>0 ? get_speedbonus_kmh() : 0;
 	}
 	maxspeed_average_count = 0;
 	// everything normal: update histroy
-	for (int j = 0; j<MAX_CONVOI_COST; j++) {
-		for (int k = MAX_MONTHS-1; k>0; k--) {
-			financial_history[k][j] = financial_history[k-1][j];
-		}
-		financial_history[0][j] = 0;
-	}
+	financial_history.advance();
 	// remind every new month again
 	if(  state==NO_ROUTE  ) {
 		get_owner()->report_vehicle_problem( self, get_pos() );
@@ -1583,7 +1578,7 @@ void convoi_t::start()
 			line->recalc_catg_index();
 		}
 		else {
-			welt->set_schedule_counter();
+			haltestelle_t::mark_connections_dirty( schedule, get_owner() );
 		}
 		wait_lock = 0;
 
@@ -1870,7 +1865,7 @@ bool convoi_t::set_schedule(schedule_t * f)
 			// if line is unset or schedule is changed
 			// -> register stops from new schedule
 			register_stops();
-			welt->set_schedule_counter(); // must trigger refresh
+			haltestelle_t::mark_connections_dirty( schedule, get_owner() ); // must trigger refresh
 		}
 	}
 
@@ -2438,54 +2433,54 @@ void convoi_t::rdwr(loadsave_t *file)
 		int j;
 		for (j = 0; j<3; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (j = 2; j<5; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][CONVOI_DISTANCE] = 0;
-			financial_history[k][CONVOI_MAXSPEED] = 0;
-			financial_history[k][CONVOI_WAYTOLL] = 0;
+			financial_history.at(k, CONVOI_DISTANCE) = 0;
+			financial_history.at(k, CONVOI_MAXSPEED) = 0;
+			financial_history.at(k, CONVOI_WAYTOLL) = 0;
 		}
 	}
 	else if(  file->is_version_less(102, 3)  ){
 		// load statistics
 		for (int j = 0; j<5; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][CONVOI_DISTANCE] = 0;
-			financial_history[k][CONVOI_MAXSPEED] = 0;
-			financial_history[k][CONVOI_WAYTOLL] = 0;
+			financial_history.at(k, CONVOI_DISTANCE) = 0;
+			financial_history.at(k, CONVOI_MAXSPEED) = 0;
+			financial_history.at(k, CONVOI_WAYTOLL) = 0;
 		}
 	}
 	else if(  file->is_version_less(111, 1)  ){
 		// load statistics
 		for (int j = 0; j<6; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][CONVOI_MAXSPEED] = 0;
-			financial_history[k][CONVOI_WAYTOLL] = 0;
+			financial_history.at(k, CONVOI_MAXSPEED) = 0;
+			financial_history.at(k, CONVOI_WAYTOLL) = 0;
 		}
 	}
 	else if(  file->is_version_less(112, 8)  ){
 		// load statistics
 		for (int j = 0; j<7; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][CONVOI_WAYTOLL] = 0;
+			financial_history.at(k, CONVOI_WAYTOLL) = 0;
 		}
 	}
 	else
@@ -2493,7 +2488,7 @@ void convoi_t::rdwr(loadsave_t *file)
 		// load statistics
 		for (int j = 0; j<MAX_CONVOI_COST; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 	}
@@ -2508,7 +2503,7 @@ void convoi_t::rdwr(loadsave_t *file)
 	if(file->is_loading()) {
 		jahresgewinn = 0;
 		for(int i=welt->get_last_month()%12;  i>=0;  i--  ) {
-			jahresgewinn += financial_history[i][CONVOI_PROFIT];
+			jahresgewinn += financial_history.at(i, CONVOI_PROFIT);
 		}
 	}
 
@@ -2849,10 +2844,10 @@ void convoi_t::calc_gewinn()
 
 	// update statistics of average speed
 	if(  distance_since_last_stop  ) {
-		financial_history[0][CONVOI_MAXSPEED] *= maxspeed_average_count;
-		financial_history[0][CONVOI_MAXSPEED] += get_speedbonus_kmh();
+		financial_history.at(0, CONVOI_MAXSPEED) *= maxspeed_average_count;
+		financial_history.at(0, CONVOI_MAXSPEED) += get_speedbonus_kmh();
 		maxspeed_average_count ++;
-		financial_history[0][CONVOI_MAXSPEED] /= maxspeed_average_count;
+		financial_history.at(0, CONVOI_MAXSPEED) /= maxspeed_average_count;
 	}
 	distance_since_last_stop = 0;
 	sum_speed_limit = 0;
@@ -3318,7 +3313,7 @@ void convoi_t::book(sint64 amount, int cost_type)
 {
 	assert(  cost_type<MAX_CONVOI_COST);
 
-	financial_history[0][cost_type] += amount;
+	financial_history.at(0, cost_type) += amount;
 	if (line.is_bound()) {
 		line->book( amount, simline_t::convoi_to_line_catgory(cost_type) );
 	}
@@ -3327,11 +3322,7 @@ void convoi_t::book(sint64 amount, int cost_type)
 
 void convoi_t::init_financial_history()
 {
-	for (int j = 0; j<MAX_CONVOI_COST; j++) {
-		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][j] = 0;
-		}
-	}
+	financial_history.clear();
 }
 
 
@@ -3363,7 +3354,7 @@ void convoi_t::set_line(linehandle_t org_line)
 		unregister_stops();
 		// must trigger refresh if old schedule was not empty
 		if (schedule  &&  !schedule->empty()) {
-			welt->set_schedule_counter();
+			haltestelle_t::mark_connections_dirty( schedule, get_owner() );
 		}
 	}
 	line_update_pending = org_line;
@@ -3618,11 +3609,11 @@ PIXVAL convoi_t::get_status_color() const
 		// stuck or no route
 		return color_idx_to_rgb(COL_ORANGE);
 	}
-	else if(financial_history[0][CONVOI_PROFIT]+financial_history[1][CONVOI_PROFIT]<0) {
+	else if(financial_history.at(0, CONVOI_PROFIT)+financial_history.at(1, CONVOI_PROFIT)<0) {
 		// ok, not performing best
 		return MONEY_MINUS;
 	}
-	else if((financial_history[0][CONVOI_OPERATIONS]|financial_history[1][CONVOI_OPERATIONS])==0) {
+	else if((financial_history.at(0, CONVOI_OPERATIONS)|financial_history.at(1, CONVOI_OPERATIONS))==0) {
 		// nothing moved
 		return SYSCOL_TEXT_UNUSED;
 	}
@@ -3909,7 +3900,7 @@ bool convoi_t::can_overtake(overtaker_t *other_overtaker, sint32 other_speed, si
 
 sint64 convoi_t::get_stat_converted(int month, int cost_type) const
 {
-	sint64 value = financial_history[month][cost_type];
+	sint64 value = financial_history.at(month, cost_type);
 	switch(cost_type) {
 		case CONVOI_REVENUE:
 		case CONVOI_OPERATIONS:
@@ -16,6 +16,7 @@
 #include "vehicle/overtaker.h"
 #include "tpl/array_tpl.h"
 #include "tpl/minivec_tpl.h"
+#include "tpl/history_tpl.h"
 
 #include "convoihandle.h"
 #include "halthandle.h"
@@ -261,7 +262,7 @@ private:
 	char name_and_id[128];
 
 	/// struct holds new financial history for convoi
-	sint64 financial_history[MAX_MONTHS][MAX_CONVOI_COST];
+	history_tpl<sint64, MAX_MONTHS, MAX_CONVOI_COST> financial_history;
 
 private:
 	/**
@@ -697,12 +698,12 @@ public:
 	/**
 	* return a pointer to the financial history
 	*/
-	sint64* get_finance_history() { return *financial_history; }
+	const history_tpl<sint64, MAX_MONTHS, MAX_CONVOI_COST> &get_finance_history() const { return financial_history; }
 
 	/**
 	* return a specified element from the financial history
 	*/
-	sint64 get_finance_history(int month, int cost_type) const { return financial_history[month][cost_type]; }
+	sint64 get_finance_history(int month, int cost_type) const { return financial_history.at(month, cost_type); }
 	sint64 get_stat_converted(int month, int cost_type) const;
 
 	/**
@@ -110,11 +110,7 @@ sint32 work_from_production(sint64 prod, sint64 scaled){
 
 void ware_production_t::init_stats()
 {
-	for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-		for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
-			statistics[m][s] = 0;
-		}
-	}
+	statistics.clear();
 	weighted_sum_storage = 0;
 }
 
@@ -126,18 +122,9 @@ void ware_production_t::roll_stats(uint32 factor, sint64 aggregate_weight)
 		set_stat( weighted_sum_storage / aggregate_weight, FAB_GOODS_STORAGE );
 	}
 
-	for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
-		for(  int m=MAX_MONTH-1;  m>0;  --m  ) {
-			statistics[m][s] = statistics[m-1][s];
-		}
-		if(  s==FAB_GOODS_TRANSIT  ) {
-			// keep the current amount in transit
-			statistics[0][s] = statistics[1][s];
-		}
-		else {
-			statistics[0][s] = 0;
-		}
-	}
+	statistics.advance();
+	// keep the current amount in transit
+	statistics.at(0, FAB_GOODS_TRANSIT) = statistics.at(1, FAB_GOODS_TRANSIT);
 	weighted_sum_storage = 0;
 
 	// restore current storage level
@@ -152,19 +139,18 @@ void ware_production_t::rdwr(loadsave_t *file)
 	}
 
 	// we use a temporary variable to save/load old data correctly
-	sint64 statistics_buf[MAX_MONTH][MAX_FAB_GOODS_STAT];
-	memcpy( statistics_buf, statistics, sizeof(statistics_buf) );
+	history_tpl<sint64, MAX_MONTH, MAX_FAB_GOODS_STAT> statistics_buf = statistics;
 	if(  file->is_saving()  &&  file->is_version_less(120, 1)  ) {
 		for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-			statistics_buf[m][0] = (statistics[m][FAB_GOODS_STORAGE] >> DEFAULT_PRODUCTION_FACTOR_BITS);
-			statistics_buf[m][2] = (statistics[m][2] >> DEFAULT_PRODUCTION_FACTOR_BITS);
+			statistics_buf.at(m, 0) = (statistics.at(m, FAB_GOODS_STORAGE) >> DEFAULT_PRODUCTION_FACTOR_BITS);
+			statistics_buf.at(m, 2) = (statistics.at(m, 2) >> DEFAULT_PRODUCTION_FACTOR_BITS);
 		}
 	}
 
 	if(  file->is_version_atleast(112, 1)  ) {
 		for(  int s=0;  s<MAX_FAB_GOODS_STAT;  ++s  ) {
 			for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-				file->rdwr_longlong( statistics_buf[m][s] );
+				file->rdwr_longlong( statistics_buf.at(m, s) );
 			}
 		}
 		file->rdwr_longlong( weighted_sum_storage );
@@ -173,26 +159,26 @@ void ware_production_t::rdwr(loadsave_t *file)
 		// save/load statistics
 		for(  int s=0;  s<3;  ++s  ) {
 			for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-				file->rdwr_longlong( statistics_buf[m][s] );
+				file->rdwr_longlong( statistics_buf.at(m, s) );
 			}
 		}
 		file->rdwr_longlong( weighted_sum_storage );
 	}
 
 	if(  file->is_loading()  ) {
-		memcpy( statistics, statistics_buf, sizeof(statistics_buf) );
+		statistics = statistics_buf;
 
 		// Apply correction for output production graphs which have had their precision changed for factory normalization.
 		// Also apply a fix for corrupted in-transit values caused by a logical error.
 		if(file->is_version_less(120, 1)){
 			for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-				statistics[m][0] = (statistics[m][FAB_GOODS_STORAGE] & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
-				statistics[m][2] = (statistics[m][2] & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
+				statistics.at(m, 0) = (statistics.at(m, FAB_GOODS_STORAGE) & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
+				statistics.at(m, 2) = (statistics.at(m, 2) & 0xffffffff) << DEFAULT_PRODUCTION_FACTOR_BITS;
 			}
 		}
 
 		// recalc transit always on load
-		statistics[0][FAB_GOODS_TRANSIT] = 0;
+		statistics.at(0, FAB_GOODS_TRANSIT) = 0;
 	}
 
 	if (file->is_version_atleast(122, 1)) {
@@ -350,11 +336,7 @@ void fabrik_t::update_transit_intern( const ware_t *ware, bool add )
 
 void fabrik_t::init_stats()
 {
-	for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-		for(  int s=0;  s<MAX_FAB_STAT;  ++s  ) {
-			statistics[m][s] = 0;
-		}
-	}
+	statistics.clear();
 	weighted_sum_production = 0;
 	weighted_sum_boost_electric = 0;
 	weighted_sum_boost_pax = 0;
@@ -677,6 +659,63 @@ void fabrik_t::set_base_production(sint32 p)
 }
 
 
+uint32 fabrik_t::links_serial = 1;
+
+
+const fabrik_t::links_t &fabrik_t::get_links() const
+{
+	if(  links.serial != links_serial  ) {
+		links.serial = links_serial;
+
+		links.consumers.clear();
+		for(  koord const k : consumer  ) {
+			links.consumers.append( get_fab( k ) );
+		}
+		links.suppliers.clear();
+		for(  koord const k : suppliers  ) {
+			links.suppliers.append( get_fab( k ) );
+		}
+
+		links.output_consumers.clear();
+		links.output_start.clear();
+		for(  ware_production_t const& out : output  ) {
+			links.output_start.append( links.output_consumers.get_count() );
+			for(  uint32 n = 0;  n < links.consumers.get_count();  n++  ) {
+				if(  fabrik_t *fab = links.consumers[n]  ) {
+					for(  uint32 w = 0;  w < fab->input.get_count();  w++  ) {
+						if(  fab->input[w].get_typ() == out.get_typ()  ) {
+							consumer_link_t link = { fab, n, w };
+							links.output_consumers.append( link );
+							break;
+						}
+					}
+				}
+			}
+		}
+		links.output_start.append( links.output_consumers.get_count() );
+
+		links.input_suppliers.clear();
+		links.input_start.clear();
+		for(  ware_production_t const& in : input  ) {
+			links.input_start.append( links.input_suppliers.get_count() );
+			for(  uint32 n = 0;  n < links.suppliers.get_count();  n++  ) {
+				if(  fabrik_t *fab = links.suppliers[n]  ) {
+					for(  uint32 w = 0;  w < fab->output.get_count();  w++  ) {
+						if(  fab->output[w].get_typ() == in.get_typ()  ) {
+							supplier_link_t link = { fab, n, w };
+							links.input_suppliers.append( link );
+							break;
+						}
+					}
+				}
+			}
+		}
+		links.input_start.append( links.input_suppliers.get_count() );
+	}
+	return links;
+}
+
+
 fabrik_t *fabrik_t::get_fab(const koord &pos)
 {
 	const grund_t *gr = welt->lookup_kartenboden(pos);
@@ -728,6 +767,7 @@ void fabrik_t::add_consumer(koord ziel)
 {
 	if(  !consumer.is_contained(ziel)  ) {
 		consumer.insert_ordered( ziel, RelativeDistanceOrdering(pos.get_2d()) );
+		links_changed();
 		// now tell factory too
 		fabrik_t * fab = fabrik_t::get_fab(ziel);
 		if (fab) {
@@ -739,7 +779,9 @@ void fabrik_t::add_consumer(koord ziel)
 
 void fabrik_t::remove_consumer(koord ziel)
 {
-	consumer.remove(ziel);
+	if(  consumer.remove(ziel)  ) {
+		links_changed();
+	}
 }
 
 
@@ -870,6 +912,8 @@ fabrik_t::fabrik_t(koord3d pos_, player_t* owner, const factory_desc_t* factory_
 
 fabrik_t::~fabrik_t()
 {
+	links_changed();
+
 	while(!fields.empty()) {
 		planquadrat_t *plan = welt->access( fields.back().location );
 		// if destructor is called when world is destroyed, plan is already invalid
@@ -896,6 +940,7 @@ void fabrik_t::build(sint32 rotate, bool build_fields, bool force_initial_prodba
 	gebaeude_t *gb = hausbauer_t::build(owner, pos_origin.get_2d(), rotate, desc->get_building(), this);
 	pos = gb->get_pos();
 	pos_origin.z = pos.z;
+	links_changed();
 
 	if(desc->get_field_group()) {
 		// if there are fields
@@ -1537,7 +1582,7 @@ DBG_DEBUG("fabrik_t::rdwr()","loading factory '%s'",s);
 		// statistics
 		for(  int s=0;  s<MAX_FAB_STAT;  ++s  ) {
 			for(  int m=0;  m<MAX_MONTH;  ++m  ) {
-				file->rdwr_longlong( statistics[m][s] );
+				file->rdwr_longlong( statistics.at(m, s) );
 			}
 		}
 		file->rdwr_longlong( weighted_sum_production );
@@ -2572,6 +2617,16 @@ void fabrik_t::verteile_waren(const uint32 product)
 	const uint32 prod_factor = desc->get_product(product)->get_factor();
 	sint32 menge = (sint32)(((sint64)output[product].min_shipment * (sint64)(prod_factor)) >> (DEFAULT_PRODUCTION_FACTOR_BITS + precision_bits));
 
+	// only the consumers needing this product, starting with the first at or after index_offset
+	const links_t &link = get_links();
+	const uint32 first = link.output_start[product];
+	const uint32 targets = link.output_start[product+1] - first;
+	const uint32 offset = output[product].index_offset % consumer.get_count();
+	uint32 start = 0;
+	while(  start < targets  &&  link.output_consumers[first + start].consumer_index < offset  ) {
+		start++;
+	}
+
 	// ok, first generate list of possible destinations
 	const halthandle_t *haltlist = plan->get_haltlist();
 	for(  unsigned i=0;  i<plan->get_haltlist_count();  i++  ) {
@@ -2581,39 +2636,29 @@ void fabrik_t::verteile_waren(const uint32 product)
 			continue;
 		}
 
-		for(  uint32 n=0;  n<consumer.get_count();  n++  ) {
+		for(  uint32 n=0;  n<targets;  n++  ) {
 			// this way, the halt, that is tried first, will change. As a result, if all destinations are empty, it will be spread evenly
-			const koord lieferziel = consumer[(n + output[product].index_offset) % consumer.get_count()];
-			fabrik_t * ziel_fab = get_fab(lieferziel);
-
-			if(  ziel_fab  ) {
-				const sint8 needed = ziel_fab->is_needed(output[product].get_typ());
-				if(  needed>=0  ) {
-					ware_t ware(output[product].get_typ());
-					ware.amount = menge;
-					ware.to_factory = 1;
-					ware.set_target_pos( lieferziel );
-
-					unsigned w;
-					// find the index in the target factory
-					for(  w = 0;  w < ziel_fab->get_input().get_count()  &&  ziel_fab->get_input()[w].get_typ() != ware.get_desc();  w++  ) {
-						// empty
-					}
+			const consumer_link_t &target = link.output_consumers[first + (n + start) % targets];
+			const koord lieferziel = consumer[target.consumer_index];
+			const ware_production_t &target_input = target.fab->input[target.input_index];
 
-					// if only overflown factories found => deliver to first
-					// else deliver to non-overflown factory
-					if(  !(welt->get_settings().get_just_in_time() != 0)  ) {
-						// without production stop when target overflowing, distribute to least overflow target
-						const sint32 fab_left = ziel_fab->get_input()[w].max - ziel_fab->get_input()[w].menge;
-						dist_list.insert_ordered( distribute_ware_t( halt, fab_left, ziel_fab->get_input()[w].max, (sint32)halt->get_ware_fuer_zielpos(output[product].get_typ(),ware.get_target_pos()), ware ), distribute_ware_t::compare );
+			ware_t ware(output[product].get_typ());
+			ware.amount = menge;
+			ware.to_factory = 1;
+			ware.set_target_pos( lieferziel );
+
+			// if only overflown factories found => deliver to first
+			// else deliver to non-overflown factory
+			if(  !(welt->get_settings().get_just_in_time() != 0)  ) {
+				// without production stop when target overflowing, distribute to least overflow target
+				const sint32 fab_left = target_input.max - target_input.menge;
+				dist_list.insert_ordered( distribute_ware_t( halt, fab_left, target_input.max, (sint32)halt->get_ware_fuer_zielpos(output[product].get_typ(),ware.get_target_pos()), ware ), distribute_ware_t::compare );
 
-					}
-					else if(  needed > 0  ) {
-						// we are not overflowing: Station can only store up to a maximum amount of goods per square
-						const sint32 halt_left = (sint32)halt->get_capacity(2) - (sint32)halt->get_ware_summe(ware.get_desc());
-						dist_list.insert_ordered( distribute_ware_t( halt, halt_left, halt->get_capacity(2), (sint32)halt->get_ware_fuer_zielpos(output[product].get_typ(),ware.get_target_pos()), ware ), distribute_ware_t::compare );
-					}
-				}
+			}
+			else if(  target_input.placing_orders  ) {
+				// we are not overflowing: Station can only store up to a maximum amount of goods per square
+				const sint32 halt_left = (sint32)halt->get_capacity(2) - (sint32)halt->get_ware_summe(ware.get_desc());
+				dist_list.insert_ordered( distribute_ware_t( halt, halt_left, halt->get_capacity(2), (sint32)halt->get_ware_fuer_zielpos(output[product].get_typ(),ware.get_target_pos()), ware ), distribute_ware_t::compare );
 			}
 		}
 	}
@@ -2674,7 +2719,8 @@ void fabrik_t::verteile_waren(const uint32 product)
 				// refund JIT2 demand buffers for rerouted goods
 				if(  welt->get_settings().get_just_in_time() >= 2  ) {
 					// locate destination factory
-					fabrik_t *fab = get_fab( most_waiting.get_target_pos() );
+					const uint32 idx = consumer.index_of( most_waiting.get_target_pos() );
+					fabrik_t *fab = idx < consumer.get_count() ? link.consumers[idx] : NULL;
 
 					if(  fab  ) {
 						for(  uint32 input = 0;  input < fab->input.get_count();  input++  ) {
@@ -2742,12 +2788,7 @@ void fabrik_t::new_month()
 	consumer_active_last_month = 0;
 
 	// advance statistics a month
-	for(  int s = 0;  s < MAX_FAB_STAT;  ++s  ) {
-		for(  int m = MAX_MONTH - 1;  m > 0;  --m  ) {
-			statistics[m][s] = statistics[m-1][s];
-		}
-		statistics[0][s] = 0;
-	}
+	statistics.advance();
 
 	weighted_sum_production = 0;
 	weighted_sum_boost_electric = 0;
@@ -3079,6 +3120,7 @@ void fabrik_t::finish_rd()
 			}
 		}
 	}
+	links_changed();
 
 	// Now rebuild input/output activity information.
 	if( welt->get_settings().get_just_in_time() >= 2 ){
@@ -3135,6 +3177,7 @@ void fabrik_t::rotate90( const sint16 y_size )
 	for(koord & i : suppliers) {
 		i.rotate90(y_size);
 	}
+	links_changed();
 	for(field_data_t & i : fields) {
 		i.location.rotate90(y_size);
 	}
@@ -3173,13 +3216,17 @@ void fabrik_t::add_supplier(koord ziel)
 			// since there could be more than one good, we have to iterate over all of them
 		}
 	}
-	suppliers.insert_unique_ordered( ziel, RelativeDistanceOrdering(pos.get_2d()) );
+	if(  suppliers.insert_unique_ordered( ziel, RelativeDistanceOrdering(pos.get_2d()) ) == NULL  ) {
+		links_changed();
+	}
 }
 
 
 void fabrik_t::remove_supplier(koord pos)
 {
-	suppliers.remove(pos);
+	if(  suppliers.remove(pos)  ) {
+		links_changed();
+	}
 
 	// Updated maximum in-transit. Only used for classic support.
 	if( welt->get_settings().get_factory_maximum_intransit_percentage() && welt->get_settings().get_just_in_time() < 2 ) {
@@ -3189,33 +3236,28 @@ void fabrik_t::remove_supplier(koord pos)
 		}
 
 		// unfourtunately we have to bite the bullet and recalc the values from scratch ...
-		for(koord ziel : suppliers ) {
-			if(  fabrik_t *fab = get_fab( ziel )  ) {
-				for(  uint32 i=0;  i < fab->get_output().get_count();  i++   ) {
-					const ware_production_t &w_out = fab->get_output()[i];
-					// now update transit limits
-					for(ware_production_t &w :  input ) {
-						if(  w_out.get_typ() == w.get_typ()  ) {
+		const links_t &link = get_links();
+		for(  uint32 i = 0;  i < input.get_count();  i++  ) {
+			ware_production_t &w = input[i];
+			for(  uint32 n = link.input_start[i];  n < link.input_start[i+1];  n++  ) {
+				const fabrik_t *fab = link.input_suppliers[n].fab;
+				// now update transit limits
 #ifdef TRANSIT_DISTANCE
-							sint64 distance = koord_distance( fab->get_pos(), get_pos() );
-							// calculate next mean by the following formula: average + (next - average)/(n+1)
-							w.count_suppliers ++;
-							sint64 next = 1 + ( distance * welt->get_settings().get_factory_maximum_intransit_percentage() * (w.max >> fabrik_t::precision_bits) ) / 131072;
-							w.max_transit += (next - w.max_transit)/(w.count_suppliers);
+				sint64 distance = koord_distance( fab->get_pos(), get_pos() );
+				// calculate next mean by the following formula: average + (next - average)/(n+1)
+				w.count_suppliers ++;
+				sint64 next = 1 + ( distance * welt->get_settings().get_factory_maximum_intransit_percentage() * (w.max >> fabrik_t::precision_bits) ) / 131072;
+				w.max_transit += (next - w.max_transit)/(w.count_suppliers);
 #else
-							const sint32 max_storage = (sint32)(1 + ( ((sint64)w_out.max * (sint64)welt->get_settings().get_factory_maximum_intransit_percentage() ) >> fabrik_t::precision_bits) / 100);
-							const sint32 old_max_transit = w.max_transit;
-							w.max_transit += max_storage;
-							if(  w.max_transit < old_max_transit  ) {
-								// we have overflown, so we use the max value
-								w.max_transit = 0x7fffffff;
-							}
-#endif
-							break;
-						}
-					}
+				const ware_production_t &w_out = fab->get_output()[ link.input_suppliers[n].output_index ];
+				const sint32 max_storage = (sint32)(1 + ( ((sint64)w_out.max * (sint64)welt->get_settings().get_factory_maximum_intransit_percentage() ) >> fabrik_t::precision_bits) / 100);
+				const sint32 old_max_transit = w.max_transit;
+				w.max_transit += max_storage;
+				if(  w.max_transit < old_max_transit  ) {
+					// we have overflown, so we use the max value
+					w.max_transit = 0x7fffffff;
 				}
-				// since there could be more than one good, we have to iterate over all of them
+#endif
 			}
 		}
 	}
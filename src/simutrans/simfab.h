@@ -13,6 +13,7 @@
 #include "tpl/slist_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/array_tpl.h"
+#include "tpl/history_tpl.h"
 #include "descriptor/factory_desc.h"
 #include "halthandle.h"
 #include "world/simworld.h"
@@ -112,7 +113,7 @@ class ware_production_t
 private:
 	const goods_desc_t *type;
 	// statistics for each goods
-	sint64 statistics[MAX_MONTH][MAX_FAB_GOODS_STAT];
+	history_tpl<sint64, MAX_MONTH, MAX_FAB_GOODS_STAT> statistics;
 	sint64 weighted_sum_storage;
 
 	/// clears statistics, transit, and weighted_sum_storage
@@ -133,17 +134,17 @@ public:
 	// functions for manipulating goods statistics
 	void roll_stats(uint32 factor, sint64 aggregate_weight);
 	void rdwr(loadsave_t *file);
-	const sint64* get_stats() const { return *statistics; }
-	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics[0][stat_type] += value; }
-	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics[0][stat_type] = value; }
-	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_GOODS_STAT); return statistics[month][stat_type]; }
+	const history_tpl<sint64, MAX_MONTH, MAX_FAB_GOODS_STAT> &get_stats() const { return statistics; }
+	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics.at(0, stat_type) += value; }
+	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_GOODS_STAT); statistics.at(0, stat_type) = value; }
+	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_GOODS_STAT); return statistics.at(month, stat_type); }
 
 	/**
 	 * convert internal units to displayed values
 	 */
 	sint64 get_stat_converted(int month, int stat_type) const {
 		assert(stat_type<MAX_FAB_GOODS_STAT);
-		sint64 value = statistics[month][stat_type];
+		sint64 value = statistics.at(month, stat_type);
 		if (stat_type==FAB_GOODS_STORAGE  ||  stat_type==FAB_GOODS_CONSUMED) {
 			value = convert_goods(value);
 		}
@@ -153,8 +154,8 @@ public:
 
 	sint32 menge; // in internal units shifted by precision_bits (see step)
 	sint32 max;
-	/// Cargo currently in transit from/to this slot. Equivalent to statistics[0][FAB_GOODS_TRANSIT].
-	sint32 get_in_transit() const { return (sint32)statistics[0][FAB_GOODS_TRANSIT]; }
+	/// Cargo currently in transit from/to this slot. Equivalent to statistics.at(0, FAB_GOODS_TRANSIT).
+	sint32 get_in_transit() const { return (sint32)statistics.at(0, FAB_GOODS_TRANSIT); }
 
 	/// Annonmyous union used to save memory and readability. Contains supply flow control limiters.
 	union{
@@ -204,7 +205,7 @@ private:
 	/**
 	 * Factory statistics
 	 */
-	sint64 statistics[MAX_MONTH][MAX_FAB_STAT];
+	history_tpl<sint64, MAX_MONTH, MAX_FAB_STAT> statistics;
 	sint64 weighted_sum_production;
 	sint64 weighted_sum_boost_electric;
 	sint64 weighted_sum_boost_pax;
@@ -247,7 +248,7 @@ private:
 
 	// Functions for manipulating factory statistics
 	void init_stats();
-	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_STAT); statistics[0][stat_type] = value; }
+	void set_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_STAT); statistics.at(0, stat_type) = value; }
 
 	// For accumulating weighted sums for average statistics
 	void book_weighted_sums(sint64 delta_time);
@@ -261,6 +262,48 @@ private:
 	 */
 	vector_tpl <koord> suppliers;
 
+	/// a consumer, which needs one of our outputs
+	struct consumer_link_t {
+		fabrik_t *fab;
+		uint32 consumer_index; ///< in consumer
+		uint32 input_index;    ///< of the good in fab->input
+	};
+
+	/// a supplier, which produces one of our inputs
+	struct supplier_link_t {
+		fabrik_t *fab;
+		uint32 supplier_index; ///< in suppliers
+		uint32 output_index;   ///< of the good in fab->output
+	};
+
+	/**
+	 * The factories of consumer and suppliers, so they are not looked up on
+	 * the map every time. Rebuilt on first use after any connection between
+	 * factories changed or a factory was built or removed (see links_serial).
+	 */
+	struct links_t {
+		uint32 serial;
+		vector_tpl<fabrik_t *> consumers; ///< same order as consumer, NULL if there is no factory
+		vector_tpl<fabrik_t *> suppliers; ///< same order as suppliers, NULL if there is no factory
+		/// consumers needing output[i] are output_consumers[output_start[i]] to output_consumers[output_start[i+1]-1], in order of consumer
+		vector_tpl<consumer_link_t> output_consumers;
+		vector_tpl<uint32> output_start;
+		/// suppliers producing input[i] are input_suppliers[input_start[i]] to input_suppliers[input_start[i+1]-1], in order of suppliers
+		vector_tpl<supplier_link_t> input_suppliers;
+		vector_tpl<uint32> input_start;
+
+		links_t() : serial(0) {}
+	};
+	mutable links_t links;
+
+	/// changed whenever links_t of any factory becomes invalid
+	static uint32 links_serial;
+
+	/// must be called, when a factory is built or removed or its connections change
+	static void links_changed() { links_serial++; }
+
+	const links_t &get_links() const;
+
 	/**
 	 * fields of this factory (only for farms etc.)
 	 */
@@ -485,9 +528,9 @@ public:
 	/**
 	 * Return/book statistics
 	 */
-	const sint64* get_stats() const { return *statistics; }
-	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_STAT); return statistics[month][stat_type]; }
-	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_STAT); statistics[0][stat_type] += value; }
+	const history_tpl<sint64, MAX_MONTH, MAX_FAB_STAT> &get_stats() const { return statistics; }
+	sint64 get_stat(int month, int stat_type) const { assert(stat_type<MAX_FAB_STAT); return statistics.at(month, stat_type); }
+	void book_stat(sint64 value, int stat_type) { assert(stat_type<MAX_FAB_STAT); statistics.at(0, stat_type) += value; }
 
 	// This updates maximum in-transit. Important for loading.
 	static void update_transit( const ware_t *ware, bool add );
@@ -500,7 +543,7 @@ public:
 	 */
 	sint64 get_stat_converted(int month, int stat_type) const {
 		assert(stat_type<MAX_FAB_STAT);
-		sint64 value = statistics[month][stat_type];
+		sint64 value = statistics.at(month, stat_type);
 		switch(stat_type) {
 			case FAB_POWER:
 				value = convert_power(value);
@@ -539,6 +582,12 @@ public:
 
 	const vector_tpl<koord>& get_suppliers() const { return suppliers; }
 
+	/// factories of get_consumer() in the same order, NULL if there is no factory at the position
+	const vector_tpl<fabrik_t *>& get_consumer_fabs() const { return get_links().consumers; }
+
+	/// factories of get_suppliers() in the same order, NULL if there is no factory at the position
+	const vector_tpl<fabrik_t *>& get_supplier_fabs() const { return get_links().suppliers; }
+
 	/**
 	 * Functions for manipulating the list of connected cities
 	 */
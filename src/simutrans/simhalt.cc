@@ -48,6 +48,7 @@
 #include "gui/halt_info.h"
 #include "gui/minimap.h"
 
+#include "utils/profiler.h"
 #include "utils/simrandom.h"
 #include "utils/simstring.h"
 
@@ -72,8 +73,32 @@ uint8 haltestelle_t::status_step = 0;
 uint8 haltestelle_t::reconnect_counter = 0;
 
 
-static vector_tpl<convoihandle_t>stale_convois;
-static vector_tpl<linehandle_t>stale_lines;
+vector_tpl<halthandle_t> haltestelle_t::dirty_halts;
+vector_tpl<halthandle_t> haltestelle_t::reroute_halts;
+
+
+/// convoys and lines which lost a stop and must check their freight, with the step they were queued
+struct stale_convoi_t {
+	convoihandle_t cnv;
+	uint32 since;
+
+	stale_convoi_t(convoihandle_t c = convoihandle_t(), uint32 s = 0) : cnv(c), since(s) {}
+	bool operator == (const stale_convoi_t &other) const { return cnv == other.cnv; }
+};
+
+struct stale_line_t {
+	linehandle_t line;
+	uint32 since;
+
+	stale_line_t(linehandle_t l = linehandle_t(), uint32 s = 0) : line(l), since(s) {}
+	bool operator == (const stale_line_t &other) const { return line == other.line; }
+};
+
+static vector_tpl<stale_convoi_t>stale_convois;
+static vector_tpl<stale_line_t>stale_lines;
+
+// convoys closer than this (in tiles) to the end of their route are checked first
+#define STALE_ARRIVING_TILES (16)
 
 
 void haltestelle_t::reset_routing()
@@ -82,24 +107,66 @@ void haltestelle_t::reset_routing()
 }
 
 
-void haltestelle_t::step_all()
+void haltestelle_t::mark_connections_dirty()
 {
-	// tell all stale convois to reroute their goods
-	if(  !stale_convois.empty()  ) {
-		convoihandle_t cnv = stale_convois.pop_back();
-		if(  cnv.is_bound()  ) {
-			cnv->check_freight();
-		}
+	if(  !connections_dirty  ) {
+		connections_dirty = true;
+		dirty_halts.append( self );
 	}
-	// same for stale lines
-	if(  !stale_lines.empty()  ) {
-		linehandle_t line = stale_lines.pop_back();
-		if(  line.is_bound()  ) {
-			line->check_freight();
+	// the schedule counter is not changed, so tell the minimap about the changed lines
+	minimap_t::get_instance()->invalidate_map_lines_cache();
+}
+
+
+void haltestelle_t::mark_connections_dirty(const schedule_t *schedule, const player_t *player)
+{
+	for(schedule_entry_t const& i : schedule->entries) {
+		halthandle_t const halt = get_halt( i.pos, player );
+		if(  halt.is_bound()  ) {
+			halt->mark_connections_dirty();
 		}
 	}
+}
+
+
+void haltestelle_t::clear_dirty_halts()
+{
+	for(halthandle_t const halt : dirty_halts) {
+		halt->connections_dirty = false;
+	}
+	dirty_halts.clear();
+	reroute_halts.clear();
+}
+
+
+// next halt to reconnect or reroute in step_all()
+static vector_tpl<halthandle_t>::iterator step_iter;
+
+
+void haltestelle_t::rebuild_all_connections()
+{
+	clear_dirty_halts();
+	// rebuild_connections() only changes the links of its own halt
+	welt->index_loop( [](uint32 i) { alle_haltestellen[i]->rebuild_connections(); }, alle_haltestellen.get_count() );
+	rebuild_connected_components();
+
+	// same state as after a complete reconnection in step_all()
+	reconnect_counter = welt->get_schedule_counter();
+	status_step = REROUTING;
+	step_iter = alle_haltestellen.begin();
+}
+
+
+void haltestelle_t::step_all()
+{
+	PROFILE_SCOPE(SEC_HALT_STEP);
+
+	sint16 units_remaining = 128;
+
+	// tell stale convois to reroute their goods; while halts are reconnected or rerouted they only get a part of the budget
+	const bool routing = status_step != 0  ||  reconnect_counter != welt->get_schedule_counter()  ||  !dirty_halts.empty()  ||  !reroute_halts.empty();
+	check_stale_freight( units_remaining, routing ? units_remaining/4 : units_remaining/2 );
 
-	static vector_tpl<halthandle_t>::iterator iter( alle_haltestellen.begin() );
 	if (alle_haltestellen.empty()) {
 		return;
 	}
@@ -108,15 +175,33 @@ void haltestelle_t::step_all()
 		// always start with reconnection, re-routing will happen after complete reconnection
 		status_step = RECONNECTING;
 		reconnect_counter = schedule_counter;
-		iter = alle_haltestellen.begin();
+		step_iter = alle_haltestellen.begin();
+		// the complete reconnection covers all pending incremental updates
+		clear_dirty_halts();
 	}
 
-	sint16 units_remaining = 128;
-	for (; iter != alle_haltestellen.end(); ++iter) {
-		if (units_remaining <= 0) return;
+	if(  status_step == 0  ) {
+		// only some schedules changed: reconnect their halts and reroute their goods
+		if(  !dirty_halts.empty()  ) {
+			update_dirty_connections();
+		}
+		while(  !reroute_halts.empty()  &&  units_remaining > 0  ) {
+			halthandle_t const halt = reroute_halts.back();
+			if(  !halt->reroute_goods(units_remaining)  ) {
+				// continue at next round
+				break;
+			}
+			halt->recalc_status();
+			reroute_halts.pop_back();
+		}
+	}
+
+	for (; step_iter != alle_haltestellen.end(); ++step_iter) {
+		// step(0) costs nothing, but must reach all halts to reset the served stops of this step
+		if (status_step != 0  &&  units_remaining <= 0) return;
 
 		// iterate until the specified number of units were handled
-		if(  !(*iter)->step(status_step, units_remaining)  ) {
+		if(  !(*step_iter)->step(status_step, units_remaining)  ) {
 			// too much rerouted => needs to continue at next round!
 			return;
 		}
@@ -131,7 +216,96 @@ void haltestelle_t::step_all()
 	else if (status_step == REROUTING) {
 		status_step = 0;
 	}
-	iter = alle_haltestellen.begin();
+	step_iter = alle_haltestellen.begin();
+}
+
+
+static bool is_stale_convoi_urgent(convoihandle_t cnv)
+{
+	if(  cnv->get_state() == convoi_t::LOADING  ) {
+		return true;
+	}
+	if(  cnv->get_state() == convoi_t::DRIVING  &&  cnv->get_vehicle_count() > 0  ) {
+		// about to arrive at the next stop
+		return cnv->get_route()->get_count() < (uint32)cnv->front()->get_route_index() + STALE_ARRIVING_TILES;
+	}
+	return false;
+}
+
+
+void haltestelle_t::check_stale_freight(sint16 &units_remaining, sint16 budget)
+{
+	// lines are just expanded into their convoys
+	while(  !stale_lines.empty()  ) {
+		const stale_line_t sl = stale_lines.pop_back();
+		if(  sl.line.is_bound()  ) {
+			for(  uint32 i = 0;  i < sl.line->count_convoys();  i++  ) {
+				stale_convois.append_unique( stale_convoi_t( sl.line->get_convoy(i), sl.since ) );
+			}
+		}
+	}
+	if(  stale_convois.empty()  ) {
+		return;
+	}
+
+	const sint16 limit = units_remaining - budget;
+	bool checked_any = false;
+	static vector_tpl<stale_convoi_t> kept;
+
+	// first those which load or arrive soon, then the oldest
+	for(  int pass = 0;  pass < 2;  pass++  ) {
+		if(  checked_any  &&  units_remaining <= limit  ) {
+			break;
+		}
+		kept.clear();
+		for(stale_convoi_t const& sc : stale_convois) {
+			if(  !sc.cnv.is_bound()  ) {
+				continue;
+			}
+			if(  (!checked_any  ||  units_remaining > limit)  &&  (pass == 1  ||  is_stale_convoi_urgent(sc.cnv))  ) {
+				sc.cnv->check_freight();
+				units_remaining -= max( 1, (int)sc.cnv->get_vehicle_count() );
+				checked_any = true;
+				profiler_t::count( profiler_t::CNT_FREIGHT_CHECKS );
+				continue;
+			}
+			kept.append( sc );
+		}
+		swap( stale_convois, kept );
+	}
+}
+
+
+uint32 haltestelle_t::get_stale_freight_count()
+{
+	return stale_convois.get_count() + stale_lines.get_count();
+}
+
+
+uint32 haltestelle_t::get_stale_freight_latency()
+{
+	const uint32 now = welt->get_steps();
+	uint32 oldest = now;
+	for(stale_convoi_t const& sc : stale_convois) {
+		oldest = min( oldest, sc.since );
+	}
+	for(stale_line_t const& sl : stale_lines) {
+		oldest = min( oldest, sl.since );
+	}
+	return now - oldest;
+}
+
+
+size_t haltestelle_t::get_cargo_memory(uint32 &packets) const
+{
+	size_t bytes = goods_manager_t::get_max_catg_index() * sizeof(vector_tpl<ware_t> *);
+	for(  uint8 i = 0;  i < goods_manager_t::get_max_catg_index();  i++  ) {
+		if(  cargo[i]  ) {
+			bytes += sizeof(vector_tpl<ware_t>) + cargo[i]->get_capacity() * sizeof(ware_t);
+			packets += cargo[i]->get_count();
+		}
+	}
+	return bytes;
 }
 
 
@@ -414,6 +588,7 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 	last_bar_count = 0;
 
 	reconnect_counter = welt->get_schedule_counter()-1;
+	connections_dirty = false;
 
 	enables = NOT_ENABLED;
 
@@ -445,6 +620,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	// force total re-routing
 	reconnect_counter = welt->get_schedule_counter()-1;
 	last_catg_index = 255;
+	connections_dirty = false;
 
 	cargo = (vector_tpl<ware_t> **)calloc( goods_manager_t::get_max_catg_index(), sizeof(vector_tpl<ware_t> *) );
 	all_links = new link_t[ goods_manager_t::get_max_catg_index() ];
@@ -472,6 +648,10 @@ haltestelle_t::~haltestelle_t()
 	if (i != 1) {
 		dbg->error("haltestelle_t::~haltestelle_t()", "handle %i found %i times in haltlist!", self.get_id(), i );
 	}
+	if(  connections_dirty  ) {
+		dirty_halts.remove(self);
+	}
+	reroute_halts.remove(self);
 
 	// free name
 	set_name(NULL);
@@ -1010,14 +1190,9 @@ void haltestelle_t::new_month()
 	}
 
 	// roll financial history
-	for (int j = 0; j<MAX_HALT_COST; j++) {
-		for (int k = MAX_MONTHS-1; k>0; k--) {
-			financial_history[k][j] = financial_history[k-1][j];
-		}
-		financial_history[0][j] = 0;
-	}
+	financial_history.advance();
 	// number of waiting should be constant ...
-	financial_history[0][HALT_WAITING] = financial_history[1][HALT_WAITING];
+	financial_history.at(0, HALT_WAITING) = financial_history.at(1, HALT_WAITING);
 }
 
 
@@ -1083,20 +1258,7 @@ bool haltestelle_t::reroute_goods(sint16 &units_remaining)
 			// remove all goods whose destination was removed from the map
 			if (cargo[last_catg_index] && !cargo[last_catg_index]->empty()) {
 
-				vector_tpl<ware_t> &warray = *cargo[last_catg_index];
-				uint32 last_goods_index = 0;
-				units_remaining -= warray.get_count();
-				while(  last_goods_index<warray.get_count()  ) {
-					search_route_resumable(warray[last_goods_index]);
-					if(  warray[last_goods_index].get_target_halt()==halthandle_t()  ) {
-						// remove invalid destinations
-						fabrik_t::update_transit( &warray[last_goods_index], false);
-						warray.remove_at(last_goods_index);
-					}
-					else {
-						++last_goods_index;
-					}
-				}
+				units_remaining -= (sint16)min( reroute_packets( *cargo[last_catg_index] ), 0x7FFFu );
 			}
 		}
 	}
@@ -1108,6 +1270,90 @@ bool haltestelle_t::reroute_goods(sint16 &units_remaining)
 
 
 
+uint32 haltestelle_t::reroute_packets(vector_tpl<ware_t> &warray)
+{
+	struct route_group_t {
+		const planquadrat_t *plan; ///< one target tile of this group
+		halthandle_t target_halt;
+		halthandle_t via_halt;
+	};
+	// keys are kept below 2^31, since the hashtable compares keys by their difference
+	static vector_tpl<route_group_t> groups;
+	static inthashtable_tpl<uint32, uint32> group_of_haltlist;
+	static inthashtable_tpl<uint32, uint32> packet_of_destination;
+	groups.clear();
+	group_of_haltlist.clear();
+	packet_of_destination.clear();
+
+	const uint32 packets = warray.get_count();
+	uint32 searches = 0;
+	uint32 last_goods_index = 0;
+	for(  uint32 i = 0;  i < packets;  i++  ) {
+		ware_t ware = warray[i];
+
+		const planquadrat_t *const plan = welt->access( ware.get_target_pos() );
+		const halthandle_t *const halt_list = plan->get_haltlist();
+		const uint8 halt_count = plan->get_haltlist_count();
+		uint32 haltlist_key = halt_count;
+		for(  uint8 h = 0;  h < halt_count;  h++  ) {
+			haltlist_key = haltlist_key*31 + halt_list[h].get_id();
+		}
+		haltlist_key &= 0x7FFFFFFFu;
+
+		// the route only depends on the halts serving the target tile
+		const uint32 *group = group_of_haltlist.access( haltlist_key );
+		bool same_halts = group != NULL  &&  groups[*group].plan->get_haltlist_count() == halt_count;
+		for(  uint8 h = 0;  same_halts  &&  h < halt_count;  h++  ) {
+			same_halts = groups[*group].plan->get_haltlist()[h] == halt_list[h];
+		}
+		if(  same_halts  ) {
+			ware.set_target_halt( groups[*group].target_halt );
+			ware.set_via_halt( groups[*group].via_halt );
+		}
+		else {
+			search_route_resumable( ware );
+			searches++;
+			if(  group == NULL  ) {
+				route_group_t new_group;
+				new_group.plan = plan;
+				new_group.target_halt = ware.get_target_halt();
+				new_group.via_halt = ware.get_via_halt();
+				group_of_haltlist.put( haltlist_key, groups.get_count() );
+				groups.append( new_group );
+			}
+		}
+
+		if(  !ware.get_target_halt().is_bound()  ) {
+			// remove invalid destinations
+			fabrik_t::update_transit( &ware, false );
+			continue;
+		}
+
+		// merge with an earlier packet for the same destination
+		uint32 destination_key = ware.get_target_halt().get_id() | ((uint32)ware.get_index() << 16);
+		if(  ware.to_factory  ) {
+			destination_key ^= ((uint32)ware.get_target_pos().x * 4093u + (uint32)ware.get_target_pos().y) << 8;
+		}
+		destination_key &= 0x7FFFFFFFu;
+		const uint32 *packet = packet_of_destination.access( destination_key );
+		if(  packet  &&  warray[*packet].same_destination( ware )  &&  (ware_t::goods_amount_t)warray[*packet].amount + ware.amount <= ware_t::GOODS_AMOUNT_LIMIT  ) {
+			warray[*packet].amount += ware.amount;
+			continue;
+		}
+		if(  packet == NULL  ) {
+			packet_of_destination.put( destination_key, last_goods_index );
+		}
+		warray[last_goods_index++] = ware;
+	}
+	while(  warray.get_count() > last_goods_index  ) {
+		warray.pop_back();
+	}
+
+	return searches + packets/8;
+}
+
+
+
 /*
  * connects a factory to a halt
  */
@@ -1168,14 +1414,15 @@ void haltestelle_t::remove_fabriken(fabrik_t *fab)
 sint32 haltestelle_t::rebuild_connections()
 {
 	// halts which either immediately precede or succeed self halt in serving schedules
-	static vector_tpl<halthandle_t> consecutive_halts[256];
+	// (one set per thread, see rebuild_all_connections())
+	static thread_local vector_tpl<halthandle_t> consecutive_halts[256];
 	// halts which either immediately precede or succeed self halt in currently processed schedule
-	static vector_tpl<halthandle_t> consecutive_halts_schedule[256];
+	static thread_local vector_tpl<halthandle_t> consecutive_halts_schedule[256];
 	// remember max number of consecutive halts for one schedule
 	uint8 max_consecutive_halts_schedule[256];
 	MEMZERON(max_consecutive_halts_schedule, goods_manager_t::get_max_catg_index());
 	// previous halt supporting the ware categories of the serving line
-	static halthandle_t previous_halt[256];
+	static thread_local halthandle_t previous_halt[256];
 
 	// first, remove all old entries
 	for(  uint8 i=0;  i<goods_manager_t::get_max_catg_index();  i++  ){
@@ -1363,6 +1610,109 @@ void haltestelle_t::rebuild_connected_components()
 }
 
 
+void haltestelle_t::update_dirty_connections()
+{
+	if(  dirty_halts.get_count() > alle_haltestellen.get_count()/4  ) {
+		// too many changes at once => complete reconnection is faster
+		reset_routing();
+		return;
+	}
+
+	const uint8 max_catg_index = goods_manager_t::get_max_catg_index();
+	// categories whose components must be recomputed, since links were removed
+	bool split[256];
+	MEMZERON(split, max_catg_index);
+
+	// first rebuild all dirty halts, remembering their old links
+	vector_tpl<uint16> old_components( dirty_halts.get_count()*max_catg_index );
+	vector_tpl<halthandle_t> old_connections;
+	for(halthandle_t const halt : dirty_halts) {
+		for(  uint8 catg_idx = 0;  catg_idx < max_catg_index;  catg_idx++  ) {
+			old_components.append( halt->all_links[catg_idx].catg_connected_component );
+		}
+
+		// save old links of all categories in one list, separated by unbound handles
+		old_connections.clear();
+		for(  uint8 catg_idx = 0;  catg_idx < max_catg_index;  catg_idx++  ) {
+			for(connection_t const& c : halt->all_links[catg_idx].connections) {
+				old_connections.append( c.halt );
+			}
+			old_connections.append( halthandle_t() );
+		}
+
+		halt->rebuild_connections();
+		halt->connections_dirty = false;
+
+		uint32 j = 0;
+		for(  uint8 catg_idx = 0;  catg_idx < max_catg_index;  catg_idx++  ) {
+			vector_tpl<connection_t> const& connections = halt->all_links[catg_idx].connections;
+			for(  ;  old_connections[j].is_bound();  j++  ) {
+				if(  !split[catg_idx]  &&  !connections.is_contained( connection_t(old_connections[j]) )  ) {
+					split[catg_idx] = true;
+				}
+			}
+			j++;
+		}
+	}
+
+	// now update the components
+	for(  uint8 catg_idx = 0;  catg_idx < max_catg_index;  catg_idx++  ) {
+		if(  !split[catg_idx]  ) {
+			// links were only added: keep the old components and merge those joined by new links
+			for(  uint32 i = 0;  i < dirty_halts.get_count();  i++  ) {
+				const uint16 comp = old_components[i*max_catg_index+catg_idx];
+				if(  comp == UNDECIDED_CONNECTED_COMPONENT  ) {
+					// should not happen, but then recompute it
+					split[catg_idx] = true;
+					break;
+				}
+				dirty_halts[i]->all_links[catg_idx].catg_connected_component = comp;
+			}
+		}
+		if(  split[catg_idx]  ) {
+			for(halthandle_t const halt : alle_haltestellen) {
+				halt->all_links[catg_idx].catg_connected_component = UNDECIDED_CONNECTED_COMPONENT;
+			}
+			for(halthandle_t const halt : alle_haltestellen) {
+				if(  halt->all_links[catg_idx].catg_connected_component == UNDECIDED_CONNECTED_COMPONENT  ) {
+					halt->fill_connected_component( catg_idx, halt.get_id() );
+				}
+			}
+			continue;
+		}
+
+		for(halthandle_t const halt : dirty_halts) {
+			for(connection_t &c : halt->all_links[catg_idx].connections) {
+				const uint16 from = c.halt->all_links[catg_idx].catg_connected_component;
+				const uint16 to = halt->all_links[catg_idx].catg_connected_component;
+				if(  from != to  ) {
+					for(halthandle_t const other : alle_haltestellen) {
+						if(  other->all_links[catg_idx].catg_connected_component == from  ) {
+							other->all_links[catg_idx].catg_connected_component = to;
+						}
+					}
+				}
+				// refresh the cached is_transfer values in both directions
+				c.is_transfer = c.halt->is_transfer(catg_idx);
+				for(connection_t &back : c.halt->all_links[catg_idx].connections) {
+					if(  back.halt == halt  ) {
+						back.is_transfer = halt->is_transfer(catg_idx);
+					}
+				}
+			}
+		}
+	}
+
+	// the links changed, so any resumable search is invalid
+	last_search_origin = halthandle_t();
+
+	for(halthandle_t const halt : dirty_halts) {
+		reroute_halts.append_unique( halt );
+	}
+	dirty_halts.clear();
+}
+
+
 sint8 haltestelle_t::is_connected(halthandle_t halt, uint8 catg_index) const
 {
 	if (!halt.is_bound()) {
@@ -1509,6 +1859,8 @@ uint8 haltestelle_t::last_search_ware_catg_idx = 255;
  */
 int haltestelle_t::search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware )
 {
+	profiler_t::count( profiler_t::CNT_HALT_ROUTE_SEARCH );
+
 	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
 	const uint8 ware_idx = ware.get_desc()->get_index();
 
@@ -2256,6 +2608,8 @@ void haltestelle_t::add_ware_to_halt(ware_t ware)
  */
 uint32 haltestelle_t::starte_mit_route(ware_t ware)
 {
+	profiler_t::count( profiler_t::CNT_PACKETS_GENERATED );
+
 	if(ware.get_target_halt()==self) {
 		if(  ware.to_factory  ) {
 			// muss an factory geliefert werden
@@ -2529,8 +2883,8 @@ void haltestelle_t::merge_halt( halthandle_t halt_merged )
 	// add statistics
 	for(  int month=0;  month<MAX_MONTHS;  month++  ) {
 		for(  int type=0;  type<MAX_HALT_COST;  type++  ) {
-			financial_history[month][type] += halt_merged->financial_history[month][type];
-			halt_merged->financial_history[month][type] = 0;
+			financial_history.at(month, type) += halt_merged->financial_history.at(month, type);
+			halt_merged->financial_history.at(month, type) = 0;
 		}
 	}
 
@@ -2880,7 +3234,7 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	if(  file->is_version_atleast(111, 1)  ) {
 		for (int j = 0; j<MAX_HALT_COST; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 	}
@@ -2888,11 +3242,11 @@ void haltestelle_t::rdwr(loadsave_t *file)
 		// old history did not know about walked pax
 		for (int j = 0; j<7; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][HALT_WALKED] = 0;
+			financial_history.at(k, HALT_WALKED) = 0;
 		}
 	}
 }
@@ -2984,19 +3338,14 @@ void haltestelle_t::finish_rd()
 void haltestelle_t::book(sint64 amount, int cost_type)
 {
 	assert(cost_type <= MAX_HALT_COST);
-	financial_history[0][cost_type] += amount;
+	financial_history.at(0, cost_type) += amount;
 }
 
 
 
 void haltestelle_t::init_financial_history()
 {
-	for (int j = 0; j<MAX_HALT_COST; j++)
-	{
-		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][j] = 0;
-		}
-	}
+	financial_history.clear();
 }
 
 
@@ -3006,7 +3355,7 @@ void haltestelle_t::init_financial_history()
  */
 void haltestelle_t::recalc_status()
 {
-	status_color = color_idx_to_rgb(financial_history[0][HALT_CONVOIS_ARRIVED] > 0 ? COL_GREEN : COL_YELLOW);
+	status_color = color_idx_to_rgb(financial_history.at(0, HALT_CONVOIS_ARRIVED) > 0 ? COL_GREEN : COL_YELLOW);
 
 	// since the status is ordered ...
 	uint8 status_bits = 0;
@@ -3058,10 +3407,10 @@ void haltestelle_t::recalc_status()
 		status_color = color_idx_to_rgb(status_bits&2 ? COL_RED : COL_ORANGE);
 	}
 	else {
-		status_color = color_idx_to_rgb((financial_history[0][HALT_WAITING]+financial_history[0][HALT_DEPARTED] == 0) ? COL_YELLOW : COL_GREEN);
+		status_color = color_idx_to_rgb((financial_history.at(0, HALT_WAITING)+financial_history.at(0, HALT_DEPARTED) == 0) ? COL_YELLOW : COL_GREEN);
 	}
 
-	financial_history[0][HALT_WAITING] = total_sum;
+	financial_history.at(0, HALT_WAITING) = total_sum;
 }
 
 
@@ -3355,7 +3704,7 @@ bool haltestelle_t::rem_grund(grund_t *gr)
 		}
 		// need removal?
 		if(!ok) {
-			stale_lines.append_unique( registered_lines[j] );
+			stale_lines.append_unique( stale_line_t( registered_lines[j], welt->get_steps() ) );
 			registered_lines.remove_at(j);
 		}
 	}
@@ -3371,7 +3720,7 @@ bool haltestelle_t::rem_grund(grund_t *gr)
 		}
 		// need removal?
 		if(  !ok  ) {
-			stale_convois.append_unique( registered_convoys[j] );
+			stale_convois.append_unique( stale_convoi_t( registered_convoys[j], welt->get_steps() ) );
 			registered_convoys.remove_at(j);
 		}
 	}
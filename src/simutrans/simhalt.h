@@ -26,6 +26,7 @@
 #include "tpl/slist_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/array_tpl.h"
+#include "tpl/history_tpl.h"
 
 
 #define RECONNECTING (1)
@@ -108,7 +109,7 @@ private:
 	/**
 	 * struct holds new financial history for line
 	 */
-	sint64 financial_history[MAX_MONTHS][MAX_HALT_COST];
+	history_tpl<sint64, MAX_MONTHS, MAX_HALT_COST> financial_history;
 
 	/**
 	 * initialize the financial history
@@ -158,12 +159,36 @@ public:
 
 	static uint8 get_rerouting_status() { return status_step; }
 
+	/// number of convoys and lines waiting to check their freight after losing a stop
+	static uint32 get_stale_freight_count();
+
+	/// steps the oldest of them has been waiting
+	static uint32 get_stale_freight_latency();
+
+	/// bytes allocated for the waiting cargo, @p packets is increased by the number of packets
+	size_t get_cargo_memory(uint32 &packets) const;
+
 	/**
 	 * Resets reconnect_counter.
 	 * The next call to step_all() will start complete reconnecting.
 	 */
 	static void reset_routing();
 
+	/**
+	 * Reconnects all halts at once on all threads, used after loading.
+	 * The goods are rerouted in the following step_all() calls.
+	 */
+	static void rebuild_all_connections();
+
+	/**
+	 * Only the schedules serving this halt changed: its links are rebuilt
+	 * in the next step_all() without a complete reconnection of all halts.
+	 */
+	void mark_connections_dirty();
+
+	/// marks all halts of this schedule, see mark_connections_dirty()
+	static void mark_connections_dirty(const schedule_t *schedule, const player_t *player);
+
 	/**
 	 * Returns an index to a halt at koord k
 	 * optionally limit to that owned by player sp
@@ -302,6 +327,28 @@ private:
 	 */
 	void fill_connected_component(uint8 catg, uint16 comp);
 
+	/// halts waiting for incremental reconnection, see mark_connections_dirty()
+	static vector_tpl<halthandle_t> dirty_halts;
+	/// halts waiting for rerouting after incremental reconnection
+	static vector_tpl<halthandle_t> reroute_halts;
+	bool connections_dirty;
+
+	/**
+	 * Rebuilds the links of all dirty halts and updates the connected components:
+	 * components are merged for new links and only recomputed for categories
+	 * where links were removed.
+	 */
+	static void update_dirty_connections();
+
+	/// forgets pending incremental updates, when a complete reconnection starts
+	static void clear_dirty_halts();
+
+	/**
+	 * Lets stale convoys check their freight within the given part of the budget,
+	 * at least one per call. Loading and arriving convoys are checked first.
+	 */
+	static void check_stale_freight(sint16 &units_remaining, sint16 budget);
+
 
 	// Array with different categories that contains all waiting goods at this stop
 	vector_tpl<ware_t> **cargo;
@@ -357,6 +404,14 @@ private:
 	uint8 sortierung;
 	bool resort_freight_info;
 
+	/**
+	 * Routes all packets of one category again. Packets whose target tiles are
+	 * served by the same halts get the same route, so the route is searched once
+	 * per such group. Packets with the same destination afterwards are merged.
+	 * @return the number of units used
+	 */
+	uint32 reroute_packets(vector_tpl<ware_t> &warray);
+
 	haltestelle_t(loadsave_t *file);
 	haltestelle_t(koord pos, player_t *player);
 	~haltestelle_t();
@@ -571,9 +626,9 @@ public:
 	 */
 	void add_pax_unhappy(int n);
 
-	int get_pax_happy()    const { return (int)financial_history[0][HALT_HAPPY]; }
-	int get_pax_no_route() const { return (int)financial_history[0][HALT_NOROUTE]; }
-	int get_pax_unhappy()  const { return (int)financial_history[0][HALT_UNHAPPY]; }
+	int get_pax_happy()    const { return (int)financial_history.at(0, HALT_HAPPY); }
+	int get_pax_no_route() const { return (int)financial_history.at(0, HALT_NOROUTE); }
+	int get_pax_unhappy()  const { return (int)financial_history.at(0, HALT_UNHAPPY); }
 
 
 	/**
@@ -726,12 +781,12 @@ public:
 	/**
 	 * called, if a line serves this stop
 	 */
-	void add_line(linehandle_t line) { registered_lines.append_unique(line); }
+	void add_line(linehandle_t line) { if(  registered_lines.append_unique(line)  ) { mark_connections_dirty(); } }
 
 	/**
 	 * called, if a line removes this stop from it's schedule
 	 */
-	void remove_line(linehandle_t line) { registered_lines.remove(line); }
+	void remove_line(linehandle_t line) { if(  registered_lines.remove(line)  ) { mark_connections_dirty(); } }
 
 	/**
 	 * list of line ids that serve this stop
@@ -741,12 +796,12 @@ public:
 	/**
 	 * Register a lineless convoy which serves this stop
 	 */
-	void add_convoy(convoihandle_t convoy) { registered_convoys.append_unique(convoy); }
+	void add_convoy(convoihandle_t convoy) { if(  registered_convoys.append_unique(convoy)  ) { mark_connections_dirty(); } }
 
 	/**
 	 * Unregister a lineless convoy
 	 */
-	void remove_convoy(convoihandle_t convoy) { registered_convoys.remove(convoy); }
+	void remove_convoy(convoihandle_t convoy) { if(  registered_convoys.remove(convoy)  ) { mark_connections_dirty(); } }
 
 	/**
 	 * A list of lineless convoys serving this stop
@@ -761,12 +816,12 @@ public:
 	/**
 	 * return a pointer to the financial history
 	 */
-	sint64* get_finance_history() { return *financial_history; }
+	const history_tpl<sint64, MAX_MONTHS, MAX_HALT_COST> &get_finance_history() const { return financial_history; }
 
 	/**
 	 * return a specified element from the financial history
 	 */
-	sint64 get_finance_history(int month, int cost_type) const { return financial_history[month][cost_type]; }
+	sint64 get_finance_history(int month, int cost_type) const { return financial_history.at(month, cost_type); }
 
 	/** marks a coverage area
 	*/
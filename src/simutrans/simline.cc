@@ -193,12 +193,12 @@ void simline_t::add_convoy(convoihandle_t cnv)
 	}
 
 	// will not hurt ...
-	financial_history[0][LINE_CONVOIS] = count_convoys();
+	financial_history.at(0, LINE_CONVOIS) = count_convoys();
 	recalc_status();
 
-	// do we need to tell the world about our new schedule?
+	// do we need to tell the stops about our new schedule?
 	if(  update_schedules  ) {
-		welt->set_schedule_counter();
+		haltestelle_t::mark_connections_dirty( schedule, player );
 	}
 }
 
@@ -208,7 +208,7 @@ void simline_t::remove_convoy(convoihandle_t cnv)
 	if(line_managed_convoys.is_contained(cnv)) {
 		line_managed_convoys.remove(cnv);
 		recalc_catg_index();
-		financial_history[0][LINE_CONVOIS] = count_convoys();
+		financial_history.at(0, LINE_CONVOIS) = count_convoys();
 		recalc_status();
 	}
 	if(line_managed_convoys.empty()) {
@@ -268,40 +268,40 @@ void simline_t::rdwr(loadsave_t *file)
 	if(  file->is_version_less(102, 3)  ) {
 		for (int j = 0; j<6; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][LINE_DISTANCE] = 0;
-			financial_history[k][LINE_MAXSPEED] = 0;
-			financial_history[k][LINE_WAYTOLL] = 0;
+			financial_history.at(k, LINE_DISTANCE) = 0;
+			financial_history.at(k, LINE_MAXSPEED) = 0;
+			financial_history.at(k, LINE_WAYTOLL) = 0;
 		}
 	}
 	else if(  file->is_version_less(111, 1)  ) {
 		for (int j = 0; j<7; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][LINE_MAXSPEED] = 0;
-			financial_history[k][LINE_WAYTOLL] = 0;
+			financial_history.at(k, LINE_MAXSPEED) = 0;
+			financial_history.at(k, LINE_WAYTOLL) = 0;
 		}
 	}
 	else if(  file->is_version_less(112, 8)  ) {
 		for (int j = 0; j<8; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 		for (size_t k = MAX_MONTHS; k-- != 0;) {
-			financial_history[k][LINE_WAYTOLL] = 0;
+			financial_history.at(k, LINE_WAYTOLL) = 0;
 		}
 	}
 	else {
 		for (int j = 0; j<MAX_LINE_COST; j++) {
 			for (size_t k = MAX_MONTHS; k-- != 0;) {
-				file->rdwr_longlong(financial_history[k][j]);
+				file->rdwr_longlong(financial_history.at(k, j));
 			}
 		}
 	}
@@ -311,7 +311,7 @@ void simline_t::rdwr(loadsave_t *file)
 	}
 
 	// otherwise initialized to zero if loading ...
-	financial_history[0][LINE_CONVOIS] = count_convoys();
+	financial_history.at(0, LINE_CONVOIS) = count_convoys();
 }
 
 
@@ -399,21 +399,16 @@ void simline_t::new_month()
 	if(  line_max_speed_count  ) {
 		line_max_speed /= line_max_speed_count;
 	}
-	financial_history[0][LINE_MAXSPEED] = line_max_speed;
+	financial_history.at(0, LINE_MAXSPEED) = line_max_speed;
 	// now roll history
-	for (int j = 0; j<MAX_LINE_COST; j++) {
-		for (int k = MAX_MONTHS-1; k>0; k--) {
-			financial_history[k][j] = financial_history[k-1][j];
-		}
-		financial_history[0][j] = 0;
-	}
-	financial_history[0][LINE_CONVOIS] = count_convoys();
+	financial_history.advance();
+	financial_history.at(0, LINE_CONVOIS) = count_convoys();
 }
 
 
 void simline_t::init_financial_history()
 {
-	MEMZERO(financial_history);
+	financial_history.clear();
 }
 
 
@@ -424,16 +419,16 @@ void simline_t::init_financial_history()
  */
 void simline_t::recalc_status()
 {
-	if(financial_history[0][LINE_CONVOIS]==0) {
+	if(financial_history.at(0, LINE_CONVOIS)==0) {
 		// no convois assigned to this line
 		state_color = SYSCOL_EMPTY;
 		withdraw = false;
 	}
-	else if(financial_history[0][LINE_PROFIT]<0) {
+	else if(financial_history.at(0, LINE_PROFIT)<0) {
 		// ok, not performing best
 		state_color = MONEY_MINUS;
 	}
-	else if((financial_history[0][LINE_OPERATIONS]|financial_history[1][LINE_OPERATIONS])==0) {
+	else if((financial_history.at(0, LINE_OPERATIONS)|financial_history.at(1, LINE_OPERATIONS))==0) {
 		// nothing moved
 		state_color = SYSCOL_TEXT_UNUSED;
 	}
@@ -478,14 +473,14 @@ void simline_t::recalc_catg_index()
 	// if different => schedule need recalculation
 	if(  goods_catg_index.get_count()!=old_goods_catg_index.get_count()  ) {
 		// surely changed
-		welt->set_schedule_counter();
+		haltestelle_t::mark_connections_dirty( schedule, player );
 	}
 	else {
 		// maybe changed => must test all entries
 		for(uint8 const i : goods_catg_index) {
 			if (!old_goods_catg_index.is_contained(i)) {
 				// different => recalc
-				welt->set_schedule_counter();
+				haltestelle_t::mark_connections_dirty( schedule, player );
 				break;
 			}
 		}
@@ -507,7 +502,7 @@ void simline_t::set_withdraw( bool yes_no )
 
 sint64 simline_t::get_stat_converted(int month, int cost_type) const
 {
-	sint64 value = financial_history[month][cost_type];
+	sint64 value = financial_history.at(month, cost_type);
 	switch(cost_type) {
 		case LINE_REVENUE:
 		case LINE_OPERATIONS:
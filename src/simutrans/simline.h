@@ -14,6 +14,7 @@
 
 #include "tpl/minivec_tpl.h"
 #include "tpl/vector_tpl.h"
+#include "tpl/history_tpl.h"
 #include "utils/plainstring.h"
 
 #define MAX_MONTHS     12 // Max history
@@ -86,7 +87,7 @@ private:
 	/**
 	 * struct holds new financial history for line
 	 */
-	sint64 financial_history[MAX_MONTHS][MAX_LINE_COST];
+	history_tpl<sint64, MAX_MONTHS, MAX_LINE_COST> financial_history;
 
 	/**
 	 * creates empty schedule with type depending on line-type
@@ -176,12 +177,12 @@ public:
 	// called after tiles are removed from stations to change the load of connected convois
 	void check_freight();
 
-	sint64* get_finance_history() { return *financial_history; }
+	const history_tpl<sint64, MAX_MONTHS, MAX_LINE_COST> &get_finance_history() const { return financial_history; }
 
-	sint64 get_finance_history(int month, int cost_type) const { return financial_history[month][cost_type]; }
+	sint64 get_finance_history(int month, int cost_type) const { return financial_history.at(month, cost_type); }
 	sint64 get_stat_converted(int month, int cost_type) const;
 
-	void book(sint64 amount, int cost_type) { financial_history[0][cost_type] += amount; }
+	void book(sint64 amount, int cost_type) { financial_history.at(0, cost_type) += amount; }
 
 	static uint8 convoi_to_line_catgory(uint8 convoi_cost_type);
 
@@ -7,6 +7,7 @@
 #include "simlinemgmt.h"
 #include "simline.h"
 #include "simconvoi.h"
+#include "simhalt.h"
 #include "gui/simwin.h"
 #include "world/simworld.h"
 #include "simtypes.h"
@@ -65,7 +66,7 @@ void simlinemgmt_t::update_line(linehandle_t line)
 	// finally de/register all stops
 	line->renew_stops();
 	if(  count>0  ) {
-		world()->set_schedule_counter();
+		haltestelle_t::mark_connections_dirty( line->get_schedule(), line->get_owner() );
 	}
 }
 
@@ -28,6 +28,7 @@
 #include "gui/gui_theme.h"
 #include "gui/messagebox.h"
 #include "simhalt.h"
+#include "simconvoi.h"
 #include "display/simimg.h"
 #include "simcolor.h"
 #include "simskin.h"
@@ -76,6 +77,7 @@
 #include "dataobj/loadsave.h"
 #include "dataobj/environment.h"
 #include "dataobj/tabfile.h"
+#include "dataobj/schedule.h"
 #include "dataobj/scenario.h"
 #include "dataobj/settings.h"
 #include "dataobj/translator.h"
@@ -89,12 +91,18 @@
 #include "sound/sound.h"
 
 #include "utils/cbuffer.h"
+#include "utils/benchmark.h"
+#include "utils/profiler.h"
 #include "utils/simrandom.h"
 #include "utils/unicode.h"
 
+#include "builder/goods_manager.h"
 #include "builder/vehikelbauer.h"
 #include "script/script_tool_manager.h"
 
+#include "tpl/inthashtable_tpl.h"
+#include "tpl/slist_tpl.h"
+
 #include "vehicle/vehicle.h"
 #include "vehicle/simroadtraffic.h"
 
@@ -146,86 +154,183 @@ static void show_sizes()
 
 
 #if defined DEBUG || defined PROFILE
-// render tests ...
-static void show_times(karte_t *welt, main_view_t *view)
+// render tests and benchmarks of the core routines
+static void show_times(karte_t *welt, main_view_t *view, const char *json_filename)
 {
 	intr_set_view(view);
 	welt->set_fast_forward(true);
 	intr_disable();
 
-	dbg->message( "show_times()", "simple profiling of drawing routines" );
-	int i;
+	dbg->message( "show_times()", "profiling of drawing routines, route searches, containers, saving and loading" );
+	benchmark_t bench;
+	int i = 0;
 
+	// drawing kernels
 	image_id img = ground_desc_t::outside->get_image(0,0);
-
-	uint32 ms = dr_time();
-	for (i = 0;  i < 6000000;  i++) {
+	bench.run( "display_img()", 400000, [&]() {
 		display_img_aux( img, 50, 50, 1, 0, true  CLIP_NUM_DEFAULT);
-	}
-	dbg->message( "display_img()", "%i iterations took %li ms", i, dr_time() - ms );
+	} );
 
 	image_id player_img = skinverwaltung_t::color_options->get_image_id(0);
-	ms = dr_time();
-	for (i = 0;  i < 1000000;  i++) {
-		display_color_img( player_img, 120, 100, i%15, 0, 1);
-	}
-	dbg->message( "display_color_img() with recolor", "%i iterations took %li ms", i, dr_time() - ms );
+	bench.run( "display_color_img() with recolor", 70000, [&]() {
+		display_color_img( player_img, 120, 100, (i++)%15, 0, 1);
+	} );
 
-	ms = dr_time();
-	for (i = 0;  i < 1000000;  i++) {
+	bench.run( "display_color_img()", 70000, [&]() {
 		display_color_img( img, 120, 100, 0, 1, 1);
 		display_color_img( player_img, 160, 150, 16, 1, 1);
-	}
-	dbg->message( "display_color_img()", "3x %i iterations took %li ms", i, dr_time() - ms );
+	} );
 
-	ms = dr_time();
-	for (i = 0;  i < 600000;  i++) {
+	bench.run( "display_flush_buffer()", 40000, [&]() {
 		dr_prepare_flush();
 		dr_flush();
-	}
-	dbg->message( "display_flush_buffer()", "%i iterations took %li ms", i, dr_time() - ms );
+	} );
 
-	ms = dr_time();
-	for (i = 0;  i < 300000;  i++) {
+	bench.run( "display_text_proportional_len_clip_rgb()", 20000, [&]() {
 		display_text_proportional_len_clip_rgb(100, 120, "Dies ist ein kurzer Textetxt ...", 0, 0, false, -1);
-	}
-	dbg->message( "display_text_proportional_len_clip_rgb()", "%i iterations took %li ms", i, dr_time() - ms );
+	} );
 
-	ms = dr_time();
-	for (i = 0;  i < 300000;  i++) {
+	bench.run( "display_fillbox_wh_rgb()", 20000, [&]() {
 		display_fillbox_wh_rgb(100, 120, 300, 50, 0, false);
-	}
-	dbg->message( "display_fillbox_wh_rgb()", "%i iterations took %li ms", i, dr_time() - ms );
+	} );
 
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
+	bench.run( "view->display(true)", 100, [&]() {
 		view->display(true);
-	}
-	dbg->message( "view->display(true)", "%i iterations took %li ms", i, dr_time() - ms );
+	} );
 
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
+	bench.run( "view->display(true) and flush", 100, [&]() {
 		view->display(true);
 		win_display_flush(0.0);
-	}
-	dbg->message( "view->display(true) and flush", "%i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0; i < 40000000/(int)weg_t::get_alle_wege().get_count(); i++) {
-		for(weg_t * const w : weg_t::get_alle_wege() ) {
-			grund_t *dummy;
-			welt->lookup( w->get_pos() )->get_neighbour( dummy, invalid_wt, ribi_t::north );
-		}
-	}
-	dbg->message( "grund_t::get_neighbour()", "%i iterations took %li ms", i*weg_t::get_alle_wege().get_count(), dr_time() - ms );
+	} );
+
+	// ground and way lookups
+	if(  const uint32 way_count = weg_t::get_alle_wege().get_count()  ) {
+		bench.run( "grund_t::get_neighbour() for all ways", max(1u, 2000000u/way_count), [&]() {
+			for(weg_t * const w : weg_t::get_alle_wege() ) {
+				grund_t *dummy;
+				welt->lookup( w->get_pos() )->get_neighbour( dummy, invalid_wt, ribi_t::north );
+			}
+		} );
+	}
+
+	// route searches of vehicles to their next stop
+	vector_tpl<convoihandle_t> route_convois;
+	for(  convoihandle_t const cnv : welt->convoys()  ) {
+		if(  route_convois.get_count() < 32  &&  cnv->get_vehicle_count() > 0  &&  cnv->get_schedule()  &&  !cnv->get_schedule()->empty()  ) {
+			route_convois.append( cnv );
+		}
+	}
+	if(  !route_convois.empty()  ) {
+		uint32 n = 0;
+		bench.run( "route_t::calc_route()", route_convois.get_count(), 5, [&]() {
+			convoihandle_t const cnv = route_convois[ (n++) % route_convois.get_count() ];
+			route_t route;
+			route.calc_route( welt, cnv->front()->get_pos(), cnv->get_schedule()->get_current_entry().pos, cnv->front(), speed_to_kmh(cnv->get_min_top_speed()), 8888 );
+		} );
+	}
+
+	// passenger routing between stops
+	vector_tpl<halthandle_t> pax_halts;
+	for(  halthandle_t const halt : haltestelle_t::get_alle_haltestellen()  ) {
+		if(  pax_halts.get_count() < 64  &&  halt->is_enabled( goods_manager_t::passengers )  ) {
+			pax_halts.append( halt );
+		}
+	}
+	if(  pax_halts.get_count() > 1  ) {
+		uint32 n = 0;
+		bench.run( "haltestelle_t::search_route()", 1000, [&]() {
+			const uint32 count = pax_halts.get_count();
+			const halthandle_t start = pax_halts[ n % count ];
+			ware_t pax( goods_manager_t::passengers );
+			pax.set_target_pos( pax_halts[ (n*7 + 3) % count ]->get_basis_pos() );
+			pax.amount = 1;
+			haltestelle_t::search_route( &start, 1, false, pax );
+			n++;
+		} );
+	}
+
+	// containers
+	vector_tpl<uint32> vec;
+	bench.run( "vector_tpl append/iterate 1000", 1000, [&]() {
+		vec.clear();
+		for(  uint32 k = 0;  k < 1000;  k++  ) {
+			vec.append( k );
+		}
+		uint32 sum = 0;
+		for(  uint32 const v : vec  ) {
+			sum += v;
+		}
+		vec[0] = sum;
+	} );
+
+	slist_tpl<uint32> list;
+	bench.run( "slist_tpl append/remove_first 1000", 1000, [&]() {
+		for(  uint32 k = 0;  k < 1000;  k++  ) {
+			list.append( k );
+		}
+		while(  !list.empty()  ) {
+			list.remove_first();
+		}
+	} );
+
+	inthashtable_tpl<uint32, uint32> table;
+	bench.run( "hashtable_tpl put/get/remove 1000", 500, [&]() {
+		for(  uint32 k = 0;  k < 1000;  k++  ) {
+			table.put( k*2654435761u, k );
+		}
+		uint32 sum = 0;
+		for(  uint32 k = 0;  k < 1000;  k++  ) {
+			sum += table.get( k*2654435761u );
+		}
+		for(  uint32 k = 0;  k < 1000;  k++  ) {
+			table.remove( k*2654435761u );
+		}
+		table.put( 1, sum );
+		table.remove( 1 );
+	} );
+
+	// saving the world with each stream backend and loading it back
+	static const struct { loadsave_t::mode_t mode; const char *save_name; const char *load_name; } save_modes[] = {
+		{ loadsave_t::binary,     "loadsave_t save binary",     "loadsave_t load binary" },
+		{ loadsave_t::zipped,     "loadsave_t save zipped",     "loadsave_t load zipped" },
+		{ loadsave_t::bzip2,      "loadsave_t save bzip2",      "loadsave_t load bzip2" },
+#if USE_ZSTD
+		{ loadsave_t::zstd,       "loadsave_t save zstd",       "loadsave_t load zstd" },
+#endif
+		{ loadsave_t::xml_zipped, "loadsave_t save xml_zipped", "loadsave_t load xml_zipped" }
+	};
+	// saved like an autosave, so the game name and the windows are not touched
+	const char *bench_save = "benchmark.sve";
+	const loadsave_t::mode_t old_autosave_mode = loadsave_t::autosave_mode;
+	// loading sets the file name of the game
+	const std::string old_filename = welt->get_settings().get_filename();
+	for(  uint32 m = 0;  m < lengthof(save_modes);  m++  ) {
+		loadsave_t::set_autosavemode( save_modes[m].mode );
+		bench.run( save_modes[m].save_name, 1, 5, [&]() {
+			welt->save( bench_save, true, SAVEGAME_VER_NR, true );
+		} );
+		// replaces the world by the same one
+		bench.run( save_modes[m].load_name, 1, 5, [&]() {
+			welt->load( bench_save );
+		} );
+	}
+	loadsave_t::set_autosavemode( old_autosave_mode );
+	welt->get_settings().set_filename( old_filename.c_str() );
+	dr_remove( bench_save );
+
+	// loading switched back to normal speed
+	welt->set_fast_forward(true);
+	intr_disable();
 
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
+	bench.run( "sync_step(200)/display(200)/step", 100, [&]() {
 		welt->sync_step(200);
 		welt->display(200);
 		welt->step();
+	} );
+
+	if(  json_filename  ) {
+		bench.write_json( json_filename );
 	}
-	dbg->message( "welt->sync_step(200)/display(200)/step", "%i iterations took %li ms", i, dr_time() - ms );
 }
 #endif
 
@@ -374,6 +479,8 @@ void print_help()
 		" -lang CODE          starts with specified language\n"
 		" -load NAME          loads savegame with name 'NAME' from Simutrans 'save' directory\n"
 		" -log                enables logging to file 'simu.log'\n"
+		" -max_speed [SECS]   fast forward as fast as possible (no frame pacing)\n"
+		"                     quits after SECS seconds of real time, if given\n"
 #ifdef SYSLOG
 		" -syslog             enable logging to syslog\n"
 		"                     mutually exclusive with -log\n"
@@ -386,6 +493,8 @@ void print_help()
 		" -objects DIR_NAME/  load the pakset in specified directory\n"
 		" -pause              starts game with paused after loading\n"
 		"                     a server will pause if there are no clients\n"
+		" -profile            records timings, writes profile.csv and profile_trace.json\n"
+		"                     to the user directory on exit\n"
 		" -res N              starts in specified resolution: \n"
 		"                      1=640x480, 2=800x600, 3=1024x768, 4=1280x1024\n"
 		" -scenario NAME      Load scenario NAME\n"
@@ -414,7 +523,7 @@ void print_help()
 #endif
 		" -timeline           enables timeline\n"
 #if defined DEBUG || defined PROFILE
-		" -times              does some simple profiling\n"
+		" -times [FILE]       runs benchmarks, writes the results as JSON to FILE\n"
 #endif
 		" -until YEAR.MONTH   quits when MONTH of YEAR starts\n"
 	);
@@ -1533,7 +1642,9 @@ int simu_main(int argc, char** argv)
 #if defined DEBUG || defined PROFILE
 	// do a render test?
 	if (args.has_arg("-times")) {
-		show_times(welt, view);
+		// optional file name for the results as JSON
+		const char *json_filename = args.gimme_arg("-times", 1);
+		show_times(welt, view, json_filename  &&  json_filename[0] != '-' ? json_filename : NULL);
 	}
 #endif
 
@@ -1550,6 +1661,20 @@ int simu_main(int argc, char** argv)
 		welt->set_fast_forward(true);
 	}
 
+	if(  args.has_arg("-profile")  ) {
+		profiler_t::set_tracing(true);
+	}
+
+	// run without frame pacing (e.g. to pre-age maps)
+	if(  args.has_arg("-max_speed")  ) {
+		env_t::fast_forward_unthrottled = true;
+		const char *secs = args.gimme_arg("-max_speed", 1);
+		if(  secs  &&  atoi(secs) > 0  ) {
+			env_t::fast_forward_time_limit = atoi(secs);
+		}
+		welt->set_fast_forward(true);
+	}
+
 	welt->reset_timer();
 	if(  !env_t::networkmode  &&  !env_t::server  ) {
 #ifdef display_in_main
@@ -1638,6 +1763,11 @@ int simu_main(int argc, char** argv)
 
 	intr_disable();
 
+	if(  args.has_arg("-profile")  ) {
+		profiler_t::dump_csv( (std::string(env_t::user_dir) + "profile.csv").c_str() );
+		profiler_t::dump_trace( (std::string(env_t::user_dir) + "profile_trace.json").c_str() );
+	}
+
 	// save settings
 	{
 		dr_chdir( env_t::user_dir );
@@ -10,6 +10,9 @@
 #include "simdebug.h"
 
 
+size_t pool_chunk_bytes = 0;
+
+
 void* xmalloc(size_t const size)
 {
 	void* const p = malloc(size);
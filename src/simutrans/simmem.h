@@ -18,4 +18,7 @@ void* xrealloc(void * const ptr, size_t size); // Throws std::bad_alloc on failu
 
 #define REALLOC(ptr, type, n) (type*)xrealloc((void *)ptr, sizeof(type) * (n)) // Reallocate n objects of a certain type
 
+// bytes held by the chunks of all freelist_tpl and freelist_iter_tpl pools
+extern size_t pool_chunk_bytes;
+
 #endif
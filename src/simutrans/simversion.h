@@ -23,8 +23,8 @@
 
 // Beware: SAVEGAME minor is often ahead of version minor when there were patches.
 // ==> These have no direct connection at all!
-#define SIM_SAVE_MINOR      1
-#define SIM_SERVER_MINOR    1
+#define SIM_SAVE_MINOR      3
+#define SIM_SERVER_MINOR    3
 // NOTE: increment before next release to enable save/load of new features
 
 #define MAKEOBJ_VERSION "60.7"
@@ -204,6 +204,8 @@ const char *tool_t::id_to_string(uint16 id)
 		CASE_TO_STRING(DIALOG_EDIT_GROUNDOBJ);
 		CASE_TO_STRING(DIALOG_CHAT);
 		CASE_TO_STRING(DIALOG_PLAYER_RANKING);
+		CASE_TO_STRING(DIALOG_PROFILER);
+		CASE_TO_STRING(DIALOG_MEMORY_STATS);
 		}
 	}
 
@@ -384,6 +386,8 @@ tool_t *create_dialog_tool(int toolnr)
 		case DIALOG_EDIT_GROUNDOBJ:  tool = new dialog_edit_groundobj_t();  break;
 		case DIALOG_CHAT:            tool = new dialog_chat_t();            break;
 		case DIALOG_PLAYER_RANKING:  tool = new dialog_player_ranking_t();  break;
+		case DIALOG_PROFILER:        tool = new dialog_profiler_t();        break;
+		case DIALOG_MEMORY_STATS:    tool = new dialog_memory_stats_t();    break;
 		default:
 			dbg->error("create_dialog_tool()","cannot satisfy request for dialog_tool[%i]!",toolnr);
 			return NULL;
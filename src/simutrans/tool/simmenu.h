@@ -171,6 +171,8 @@ enum {
 	DIALOG_EDIT_GROUNDOBJ,
 	DIALOG_CHAT,
 	DIALOG_PLAYER_RANKING,
+	DIALOG_PROFILER,
+	DIALOG_MEMORY_STATS,
 	DIALOGE_TOOL_COUNT,
 	DIALOGE_TOOL = 0x4000
 };
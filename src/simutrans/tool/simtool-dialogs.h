@@ -52,6 +52,8 @@
 #include "../gui/script_tool_frame.h"
 #include "../gui/chat_frame.h"
 #include "../gui/player_ranking_frame.h"
+#include "../gui/profiler_frame.h"
+#include "../gui/memory_stats_frame.h"
 
 #include "../obj/baum.h"
 #include "../obj/groundobj.h"
@@ -688,4 +690,34 @@ public:
 	bool is_work_keeps_game_state() const OVERRIDE { return true; }
 };
 
+// open profiler dialog
+class dialog_profiler_t : public tool_t {
+public:
+	dialog_profiler_t() : tool_t(DIALOG_PROFILER | DIALOGE_TOOL) {}
+	char const* get_tooltip(player_t const*) const OVERRIDE { return translator::translate("Profiler"); }
+	bool is_selected() const OVERRIDE { return win_get_magic(magic_profiler); }
+	bool init(player_t*) OVERRIDE {
+		create_win(new profiler_frame_t(), w_info, magic_profiler);
+		return false;
+	}
+	bool exit(player_t*) OVERRIDE { destroy_win(magic_profiler); return false; }
+	bool is_init_keeps_game_state() const OVERRIDE { return true; }
+	bool is_work_keeps_game_state() const OVERRIDE { return true; }
+};
+
+// open memory usage dialog
+class dialog_memory_stats_t : public tool_t {
+public:
+	dialog_memory_stats_t() : tool_t(DIALOG_MEMORY_STATS | DIALOGE_TOOL) {}
+	char const* get_tooltip(player_t const*) const OVERRIDE { return translator::translate("Memory usage"); }
+	bool is_selected() const OVERRIDE { return win_get_magic(magic_memory_stats); }
+	bool init(player_t*) OVERRIDE {
+		create_win(new memory_stats_frame_t(), w_info, magic_memory_stats);
+		return false;
+	}
+	bool exit(player_t*) OVERRIDE { destroy_win(magic_memory_stats); return false; }
+	bool is_init_keeps_game_state() const OVERRIDE { return true; }
+	bool is_work_keeps_game_state() const OVERRIDE { return true; }
+};
+
 #endif
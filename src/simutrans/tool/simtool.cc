@@ -1537,7 +1537,7 @@ const char *tool_clear_reservation_t::work( player_t *, koord3d pos )
 					// reset driving state
 					cnv->suche_neue_route();
 				}
-				for(weg_t* const w : weg_t::get_alle_wege()) {
+				for(weg_t* const w : weg_t::get_wege(waytype)) {
 					if (w->get_waytype() == waytype) {
 						schiene_t* const sch = obj_cast<schiene_t>(w);
 						if (sch->get_reserved_convoi() == cnv) {
@@ -3286,7 +3286,7 @@ void tool_wayremover_t::mark_tiles( player_t *player, const koord3d &start, cons
 	route_t verbindung;
 	bool can_built = calc_route( verbindung, player, start, end );
 	if( can_built ) {
-		for(koord3d const& pos : verbindung.get_route()) {
+		for(koord3d const& pos : verbindung) {
 			zeiger_t *marker = new zeiger_t(pos, NULL );
 			marker->set_image( cursor );
 			marker->mark_image_dirty( marker->get_image(), 0 );
@@ -3356,7 +3356,7 @@ bool tool_wayremover_t::calc_route( route_t &verbindung, player_t *player, const
 	bool can_delete = start == end  ||  verbindung.get_count()>1;
 	if(  can_delete  ) {
 		// found a route => check if I can delete anything on it
-		for(koord3d const& i : verbindung.get_route()) {
+		for(koord3d const& i : verbindung) {
 			if (!can_delete) break;
 			grund_t const* const gr = welt->lookup(i);
 			if(  wt!=powerline_wt  ) {
@@ -3455,7 +3455,7 @@ const char *tool_wayremover_t::do_work( player_t *player, const koord3d &start,
 
 			// now the tricky part: delete just part of a way (or everything, if possible)
 			// calculate remaining directions
-			ribi_t::ribi rem = 15 ^ ( verbindung.get_route().get_ribi(i) );
+			ribi_t::ribi rem = 15 ^ ( verbindung.get_ribi(i) );
 			// if start=end tile then delete every direction
 			if(  verbindung.get_count() <= 1  ) {
 				rem = 0;
@@ -3657,7 +3657,7 @@ void tool_build_wayobj_t::mark_tiles( player_t* player, const koord3d &start, co
 			koord3d pos = verbindung.at(j);
 			grund_t *gr = welt->lookup(pos);
 
-			ribi_t::ribi show = verbindung.get_route().get_ribi(j);
+			ribi_t::ribi show = verbindung.get_ribi(j);
 			// Search a matching catenary on gr.
 			wayobj_t *wayobj = gr->get_wayobj( wt );
 			if( build ) {
@@ -3721,13 +3721,12 @@ const char *tool_build_wayobj_t::do_work( player_t* player, const koord3d &start
 	bool keep_existing_faster_ways = !is_ctrl_pressed();
 
 	// build wayobj ...
-	koord3d_vector_t const& r = verbindung.get_route();
 	for(uint32 i=0;  i<verbindung.get_count();  i++  ) {
 		if( build ) {
-			wayobj_t::extend_wayobj(r[i], player, r.get_ribi(i), desc, keep_existing_faster_ways);
+			wayobj_t::extend_wayobj(verbindung.at(i), player, verbindung.get_ribi(i), desc, keep_existing_faster_ways);
 		}
 		else {
-			grund_t *gr = welt->lookup(r[i]);
+			grund_t *gr = welt->lookup(verbindung.at(i));
 			for(int n=0;  n<gr->get_top();  n++  ) {
 				obj_t *obj = gr->obj_bei(n);
 				if(  obj  &&  obj->get_typ()==obj_t::wayobj  ) {
@@ -3749,10 +3748,10 @@ const char *tool_build_wayobj_t::do_work( player_t* player, const koord3d &start
 	}
 
 	// Update depots (maybe remove electric tab?). Depots can only be on first and last tile.
-	if(  depot_t *dep = welt->lookup(r[0])->get_depot()  ) {
+	if(  depot_t *dep = welt->lookup(verbindung.front())->get_depot()  ) {
 		dep->update_win();
 	}
-	if(  depot_t *dep = welt->lookup(r.back())->get_depot()  ) {
+	if(  depot_t *dep = welt->lookup(verbindung.back())->get_depot()  ) {
 		dep->update_win();
 	}
 
@@ -88,6 +88,7 @@ private:
 			VALGRIND_DESTROY_MEMPOOL(p);
 #endif
 			free(p);
+			pool_chunk_bytes -= new_chuck_size *sizeof(T)+sizeof(chunklist_node_t);
 		}
 		freelist = 0;
 		chunk_list = 0;
@@ -98,6 +99,12 @@ public:
 	freelist_iter_tpl() : freelist(0), nodecount(0), chunk_list(0) {}
 
 	void sync_step(uint32 delta_t)
+	{
+		sync_step_each( [delta_t](const T &) { return delta_t; } );
+	}
+
+	/// as sync_step(), but the time step of each object is delta_of(object), 0 skips it
+	template<class F> void sync_step_each(F delta_of)
 	{
 		chunklist_node_t* c_list = chunk_list;
 		while (c_list) {
@@ -105,6 +112,10 @@ public:
 			for (unsigned i = 0; i < new_chuck_size; i++) {
 				if (c_list->allocated_mask.test(i)) {
 					// is active object
+					const uint32 delta_t = delta_of(p[i]);
+					if (delta_t == 0) {
+						continue;
+					}
 					if (sync_result result = p[i].sync_step(delta_t)) {
 						// remove from sync
 						c_list->allocated_mask.set(i, false);
@@ -136,6 +147,7 @@ public:
 		nodelist_node_t *tmp;
 		if (freelist == NULL) {
 			char* p = (char*)xmalloc(new_chuck_size *sizeof(T)+sizeof(chunklist_node_t));
+			pool_chunk_bytes += new_chuck_size *sizeof(T)+sizeof(chunklist_node_t);
 			memset(p, 0, sizeof(chunklist_node_t)); // clear allocation bits and next pointer
 
 #ifdef USE_VALGRIND_MEMCHECK
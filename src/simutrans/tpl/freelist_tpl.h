@@ -47,6 +47,9 @@ private:
 
 	const size_t new_chuck_size = (32768 - sizeof(void*)) / sizeof(T);
 
+	// nodes per allocated chunk
+	enum { chunk_nodes = 0x1000 };
+
 #ifdef MULTI_THREADx
 	pthread_mutex_t freelist_mutex = PTHREAD_MUTEX_INITIALIZER;;
 #endif
@@ -63,8 +66,9 @@ public:
 #endif
 		nodelist_node_t *tmp;
 		if (freelist == NULL) {
-			int chunksize = 0x1000;
+			int chunksize = chunk_nodes;
 			char* p = (char*)xmalloc(chunksize *sizeof(T) + sizeof(nodelist_node_t));
+			pool_chunk_bytes += chunksize *sizeof(T) + sizeof(nodelist_node_t);
 
 #ifdef USE_VALGRIND_MEMCHECK
 			// tell valgrind that we still cannot access the pool p
@@ -131,6 +135,7 @@ public:
 			VALGRIND_DESTROY_MEMPOOL(p);
 #endif
 			free(p);
+			pool_chunk_bytes -= chunk_nodes *sizeof(T) + sizeof(nodelist_node_t);
 		}
 		freelist = 0;
 		nodecount = 0;
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_HISTORY_TPL_H
+#define TPL_HISTORY_TPL_H
+
+
+#include "../simdebug.h"
+#include "../simtypes.h"
+
+
+/**
+ * History of STATS statistics over PERIODS periods (months or years).
+ *
+ * Age 0 is the current period, age PERIODS-1 the oldest one. Starting a
+ * new period only moves the head and clears the oldest period instead of
+ * copying all older values one period back.
+ *
+ * The values of one statistic are stored together (starting at the head
+ * and wrapping around), so a chart of one statistic reads a single array.
+ */
+template<class T, int PERIODS, int STATS> class history_tpl
+{
+	T data[STATS][PERIODS];
+
+	/// index of age 0 in data[stat][]
+	uint8 head;
+
+	static int wrap(int i) { return i >= PERIODS ? i - PERIODS : i; }
+
+public:
+	history_tpl() { clear(); }
+
+	void clear()
+	{
+		for(  int s = 0;  s < STATS;  s++  ) {
+			for(  int p = 0;  p < PERIODS;  p++  ) {
+				data[s][p] = 0;
+			}
+		}
+		head = 0;
+	}
+
+	T &at(int age, int stat)
+	{
+		assert( 0 <= age  &&  age < PERIODS  &&  0 <= stat  &&  stat < STATS );
+		return data[stat][ wrap( head + age ) ];
+	}
+
+	const T &at(int age, int stat) const
+	{
+		assert( 0 <= age  &&  age < PERIODS  &&  0 <= stat  &&  stat < STATS );
+		return data[stat][ wrap( head + age ) ];
+	}
+
+	/// starts a new period: all values become one period older, the new period is zero
+	void advance()
+	{
+		head = head > 0 ? head - 1 : PERIODS - 1;
+		for(  int s = 0;  s < STATS;  s++  ) {
+			data[s][head] = 0;
+		}
+	}
+
+	/// all periods of one statistic, the period of age a is at (get_head()+a) % PERIODS
+	const T *get_stat_values(int stat) const { return data[stat]; }
+
+	/// address of the head, stays valid (and up to date) as long as the history exists
+	const uint8 *get_head() const { return &head; }
+};
+
+#endif
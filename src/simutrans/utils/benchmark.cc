@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <algorithm>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "../simdebug.h"
+#include "../simversion.h"
+#include "../sys/simsys.h"
+
+
+// nearest rank percentile of sorted values
+static uint64 percentile(const vector_tpl<uint64> &sorted, uint32 pct)
+{
+	const uint32 n = sorted.get_count();
+	uint32 rank = (pct * n + 99) / 100;
+	return sorted[ rank > 0 ? rank - 1 : 0 ];
+}
+
+
+void benchmark_t::add_result(const char *name, uint32 iterations, vector_tpl<uint64> &samples_us)
+{
+	if(  samples_us.empty()  ||  iterations == 0  ) {
+		return;
+	}
+	std::sort( samples_us.begin(), samples_us.end() );
+
+	uint64 sum = 0;
+	for(  uint64 const us : samples_us  ) {
+		sum += us;
+	}
+
+	// per call in ns
+	const double scale = 1000.0 / iterations;
+
+	result_t res;
+	res.name = name;
+	res.iterations = iterations;
+	res.repetitions = samples_us.get_count();
+	res.min_ns = samples_us[0] * scale;
+	res.median_ns = percentile( samples_us, 50 ) * scale;
+	res.p90_ns = percentile( samples_us, 90 ) * scale;
+	res.max_ns = samples_us.back() * scale;
+	res.mean_ns = ((double)sum / samples_us.get_count()) * scale;
+	results.append( res );
+
+	dbg->message( "benchmark_t::run()", "%-40s median %12.1f ns, p90 %12.1f ns, min %12.1f ns (%u x %u calls)",
+		name, res.median_ns, res.p90_ns, res.min_ns, res.repetitions, iterations );
+}
+
+
+// only letters, digits and some punctuation are used in names, but quotes would break the file
+static void write_json_string(FILE *f, const char *s)
+{
+	fputc( '"', f );
+	for(  ;  *s;  s++  ) {
+		if(  *s == '"'  ||  *s == '\\'  ) {
+			fputc( '\\', f );
+		}
+		fputc( *s, f );
+	}
+	fputc( '"', f );
+}
+
+
+bool benchmark_t::write_json(const char *filename) const
+{
+	FILE *f = dr_fopen( filename, "w" );
+	if(  !f  ) {
+		dbg->warning( "benchmark_t::write_json()", "Cannot open %s for writing", filename );
+		return false;
+	}
+	fprintf( f, "{\n\t\"version\": \"%s\",\n\t\"warmup_runs\": %u,\n\t\"results\": [\n", VERSION_NUMBER, warmup_runs );
+	for(  uint32 i = 0;  i < results.get_count();  i++  ) {
+		const result_t &res = results[i];
+		fputs( "\t\t{ \"name\": ", f );
+		write_json_string( f, res.name.c_str() );
+		fprintf( f, ", \"iterations\": %u, \"repetitions\": %u, \"min_ns\": %.1f, \"median_ns\": %.1f, \"p90_ns\": %.1f, \"max_ns\": %.1f, \"mean_ns\": %.1f }%s\n",
+			res.iterations, res.repetitions, res.min_ns, res.median_ns, res.p90_ns, res.max_ns, res.mean_ns,
+			i + 1 < results.get_count() ? "," : "" );
+	}
+	fputs( "\t]\n}\n", f );
+	fclose( f );
+	dbg->message( "benchmark_t::write_json()", "Wrote %u results to %s", results.get_count(), filename );
+	return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_BENCHMARK_H
+#define UTILS_BENCHMARK_H
+
+
+#include <string>
+
+#include "profiler.h"
+#include "../simtypes.h"
+#include "../tpl/vector_tpl.h"
+
+
+/**
+ * Micro benchmarks with warm-up, repetitions and percentiles.
+ *
+ * run() first calls the kernel for some warm-up runs (to fill caches and
+ * let the clock settle) and then measures a number of repetitions. Each
+ * repetition calls the kernel @p iterations times, so even very short
+ * kernels take long enough to be timed. The spread of the repetitions is
+ * reported as percentiles of the time per kernel call.
+ *
+ * Results are logged and can be written as JSON to compare builds.
+ */
+class benchmark_t
+{
+public:
+	struct result_t {
+		std::string name;
+		uint32 iterations;  ///< kernel calls per repetition
+		uint32 repetitions;
+		// time per kernel call in ns
+		double min_ns;
+		double median_ns;
+		double p90_ns;
+		double max_ns;
+		double mean_ns;
+	};
+
+	benchmark_t(uint32 warmup_runs = 2, uint32 repetitions = 15) : warmup_runs(warmup_runs), repetitions(repetitions) {}
+
+	/// measures @p kernel, which is called @p iterations times per repetition
+	template<class F> void run(const char *name, uint32 iterations, F kernel) { run(name, iterations, repetitions, kernel); }
+
+	template<class F> void run(const char *name, uint32 iterations, uint32 reps, F kernel)
+	{
+		for(  uint32 w = 0;  w < warmup_runs;  w++  ) {
+			for(  uint32 i = 0;  i < iterations;  i++  ) {
+				kernel();
+			}
+		}
+		vector_tpl<uint64> samples_us(reps);
+		for(  uint32 r = 0;  r < reps;  r++  ) {
+			const uint64 start_us = profiler_t::now_us();
+			for(  uint32 i = 0;  i < iterations;  i++  ) {
+				kernel();
+			}
+			samples_us.append( profiler_t::now_us() - start_us );
+		}
+		add_result( name, iterations, samples_us );
+	}
+
+	const vector_tpl<result_t> &get_results() const { return results; }
+
+	/// @return false if the file cannot be written
+	bool write_json(const char *filename) const;
+
+private:
+	uint32 warmup_runs;
+	uint32 repetitions;
+
+	vector_tpl<result_t> results;
+
+	/// calculates and logs the statistics of one benchmark (sorts @p samples_us)
+	void add_result(const char *name, uint32 iterations, vector_tpl<uint64> &samples_us);
+};
+
+#endif
@@ -0,0 +1,348 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <string.h>
+
+#include "memory_stats.h"
+#include "cbuffer.h"
+#include "../simdebug.h"
+#include "../simmem.h"
+#include "../simconvoi.h"
+#include "../simhalt.h"
+#include "../dataobj/freelist.h"
+#include "../dataobj/route.h"
+#include "../display/simgraph.h"
+#include "../network/network.h"
+#include "../network/network_packet.h"
+#include "../world/simworld.h"
+#include "../world/simplan.h"
+
+#include "../ground/boden.h"
+#include "../ground/brueckenboden.h"
+#include "../ground/fundament.h"
+#include "../ground/monorailboden.h"
+#include "../ground/tunnelboden.h"
+#include "../ground/wasser.h"
+
+#include "../obj/baum.h"
+#include "../obj/bruecke.h"
+#include "../obj/crossing.h"
+#include "../obj/depot.h"
+#include "../obj/field.h"
+#include "../obj/gebaeude.h"
+#include "../obj/groundobj.h"
+#include "../obj/label.h"
+#include "../obj/leitung2.h"
+#include "../obj/pillar.h"
+#include "../obj/roadsign.h"
+#include "../obj/signal.h"
+#include "../obj/tunnel.h"
+#include "../obj/wayobj.h"
+#include "../obj/wolke.h"
+#include "../obj/zeiger.h"
+#include "../obj/way/kanal.h"
+#include "../obj/way/maglev.h"
+#include "../obj/way/monorail.h"
+#include "../obj/way/narrowgauge.h"
+#include "../obj/way/runway.h"
+#include "../obj/way/schiene.h"
+#include "../obj/way/strasse.h"
+
+#include "../vehicle/air_vehicle.h"
+#include "../vehicle/movingobj.h"
+#include "../vehicle/pedestrian.h"
+#include "../vehicle/rail_vehicle.h"
+#include "../vehicle/road_vehicle.h"
+#include "../vehicle/simroadtraffic.h"
+#include "../vehicle/water_vehicle.h"
+
+#include "../../squirrel/sq_extensions.h"
+
+
+static const char *category_names[memory_stats_t::MAX_CATEGORIES] = {
+	"tiles",
+	"grounds",
+	"object lists",
+	"objects",
+	"ways",
+	"routes",
+	"halt cargo",
+	"images",
+	"scripts",
+	"network buffers"
+};
+
+static const char *pool_names[memory_stats_t::MAX_POOLS] = {
+	"node pool",
+	"object pools"
+};
+
+
+static size_t get_ground_size(const grund_t *gr)
+{
+	switch(  gr->get_typ()  ) {
+		case grund_t::boden:         return sizeof(boden_t);
+		case grund_t::wasser:        return sizeof(wasser_t);
+		case grund_t::fundament:     return sizeof(fundament_t);
+		case grund_t::tunnelboden:   return sizeof(tunnelboden_t);
+		case grund_t::brueckenboden: return sizeof(brueckenboden_t);
+		case grund_t::monorailboden: return sizeof(monorailboden_t);
+	}
+	return sizeof(grund_t);
+}
+
+
+static size_t get_way_size(const weg_t *w)
+{
+	switch(  w->get_waytype()  ) {
+		case road_wt:        return sizeof(strasse_t);
+		case water_wt:       return sizeof(kanal_t);
+		case monorail_wt:    return sizeof(monorail_t);
+		case maglev_wt:      return sizeof(maglev_t);
+		case narrowgauge_wt: return sizeof(narrowgauge_t);
+		case air_wt:         return sizeof(runway_t);
+		default:             return sizeof(schiene_t);
+	}
+}
+
+
+static size_t get_obj_size(const obj_t *obj)
+{
+	switch(  obj->get_typ()  ) {
+		case obj_t::baum:                return sizeof(baum_t);
+		case obj_t::zeiger:              return sizeof(zeiger_t);
+		case obj_t::cloud:               return sizeof(wolke_t);
+		case obj_t::gebaeude:            return sizeof(gebaeude_t);
+		case obj_t::signal:              return sizeof(signal_t);
+		case obj_t::bruecke:             return sizeof(bruecke_t);
+		case obj_t::tunnel:              return sizeof(tunnel_t);
+		case obj_t::bahndepot:           return sizeof(bahndepot_t);
+		case obj_t::strassendepot:       return sizeof(strassendepot_t);
+		case obj_t::schiffdepot:         return sizeof(schiffdepot_t);
+		case obj_t::airdepot:            return sizeof(airdepot_t);
+		case obj_t::monoraildepot:       return sizeof(monoraildepot_t);
+		case obj_t::tramdepot:           return sizeof(tramdepot_t);
+		case obj_t::maglevdepot:         return sizeof(maglevdepot_t);
+		case obj_t::narrowgaugedepot:    return sizeof(narrowgaugedepot_t);
+		case obj_t::leitung:             return sizeof(leitung_t);
+		case obj_t::pumpe:               return sizeof(pumpe_t);
+		case obj_t::senke:               return sizeof(senke_t);
+		case obj_t::roadsign:            return sizeof(roadsign_t);
+		case obj_t::pillar:              return sizeof(pillar_t);
+		case obj_t::wayobj:              return sizeof(wayobj_t);
+		case obj_t::way:                 return get_way_size( static_cast<const weg_t *>(obj) );
+		case obj_t::label:               return sizeof(label_t);
+		case obj_t::field:               return sizeof(field_t);
+		case obj_t::crossing:            return sizeof(crossing_t);
+		case obj_t::groundobj:           return sizeof(groundobj_t);
+		case obj_t::pedestrian:          return sizeof(pedestrian_t);
+		case obj_t::road_user:           return sizeof(private_car_t);
+		case obj_t::road_vehicle:        return sizeof(road_vehicle_t);
+		case obj_t::rail_vehicle:        return sizeof(rail_vehicle_t);
+		case obj_t::monorail_vehicle:    return sizeof(monorail_vehicle_t);
+		case obj_t::maglev_vehicle:      return sizeof(maglev_vehicle_t);
+		case obj_t::narrowgauge_vehicle: return sizeof(narrowgauge_vehicle_t);
+		case obj_t::water_vehicle:       return sizeof(water_vehicle_t);
+		case obj_t::air_vehicle:         return sizeof(air_vehicle_t);
+		case obj_t::movingobj:           return sizeof(movingobj_t);
+		default:                         return sizeof(obj_t);
+	}
+}
+
+
+// vehicles of convoys are counted from the convoys, since they are not on the map while in a depot
+static bool is_convoi_vehicle(uint8 typ)
+{
+	return typ >= obj_t::road_vehicle  &&  typ <= obj_t::air_vehicle;
+}
+
+
+static void add(memory_stats_t::entry_t &e, uint64 bytes, uint32 count = 1)
+{
+	e.bytes += bytes;
+	e.count += count;
+}
+
+
+uint64 memory_stats_t::census_t::get_total_bytes() const
+{
+	uint64 sum = 0;
+	for(  int c = 0;  c < MAX_CATEGORIES;  c++  ) {
+		sum += category[c].bytes;
+	}
+	return sum;
+}
+
+
+void memory_stats_t::collect(const karte_t *welt, census_t &census)
+{
+	memset( &census, 0, sizeof(census_t) );
+
+	const koord size = welt->get_size();
+	census.tiles = (uint32)size.x * (uint32)size.y;
+
+	// the tile array and the height maps
+	add( census.category[MEM_TILES], (uint64)census.tiles * sizeof(planquadrat_t), census.tiles );
+	add( census.category[MEM_TILES], (uint64)(size.x + 1) * (size.y + 1) * sizeof(sint8) + (uint64)census.tiles * sizeof(sint8), 0 );
+
+	for(  sint16 y = 0;  y < size.y;  y++  ) {
+		for(  sint16 x = 0;  x < size.x;  x++  ) {
+			const planquadrat_t *plan = welt->access_nocheck( x, y );
+			const uint8 boden_count = plan->get_boden_count();
+			if(  boden_count > 1  ) {
+				add( census.category[MEM_TILES], boden_count * sizeof(grund_t *), 0 );
+			}
+			add( census.category[MEM_TILES], plan->get_haltlist_count() * sizeof(halthandle_t), 0 );
+
+			for(  uint8 i = 0;  i < boden_count;  i++  ) {
+				const grund_t *gr = plan->get_boden_bei( i );
+				add( census.category[MEM_GROUNDS], get_ground_size( gr ) );
+				add( census.category[MEM_OBJLISTS], gr->get_objlist_memory(), gr->get_top() );
+
+				for(  uint8 n = 0;  n < gr->get_top();  n++  ) {
+					const obj_t *obj = gr->obj_bei( n );
+					const uint8 typ = (uint8)obj->get_typ();
+					if(  typ >= MAX_OBJ_TYPES  ||  is_convoi_vehicle( typ )  ) {
+						continue;
+					}
+					const size_t bytes = get_obj_size( obj );
+					add( census.obj_type[typ], bytes );
+					add( census.category[ typ == obj_t::way ? MEM_WAYS : MEM_OBJECTS ], bytes );
+				}
+			}
+		}
+	}
+	add( census.category[MEM_WAYS], weg_t::get_registry_memory(), 0 );
+
+	for(  convoihandle_t const cnv : welt->convoys()  ) {
+		for(  uint8 i = 0;  i < cnv->get_vehicle_count();  i++  ) {
+			const vehicle_t *v = cnv->get_vehicle( i );
+			const size_t bytes = get_obj_size( v );
+			add( census.obj_type[ (uint8)v->get_typ() ], bytes );
+			add( census.category[MEM_OBJECTS], bytes );
+		}
+		add( census.category[MEM_ROUTES], cnv->get_route()->get_memory() );
+	}
+
+	for(  halthandle_t const halt : haltestelle_t::get_alle_haltestellen()  ) {
+		uint32 packets = 0;
+		const size_t bytes = halt->get_cargo_memory( packets );
+		add( census.category[MEM_HALT_CARGO], bytes, packets );
+	}
+
+	size_t image_base_bytes, image_cache_bytes;
+	uint32 images_freed;
+	display_get_image_memory( image_base_bytes, image_cache_bytes, images_freed );
+	add( census.category[MEM_IMAGES], image_base_bytes + image_cache_bytes, get_image_count() );
+
+	add( census.category[MEM_SCRIPTS], sq_get_allocated_memory(), 0 );
+
+	const uint32 packets = network_get_buffered_packets();
+	add( census.category[MEM_NETWORK], (uint64)packets * sizeof(packet_t), packets );
+
+	census.pool_bytes[POOL_NODES] = freelist_t::get_chunk_bytes();
+	census.pool_bytes[POOL_OBJECTS] = pool_chunk_bytes;
+}
+
+
+const char *memory_stats_t::get_category_name(category_t cat)
+{
+	return category_names[cat];
+}
+
+
+const char *memory_stats_t::get_pool_name(pool_t pool)
+{
+	return pool_names[pool];
+}
+
+
+const char *memory_stats_t::get_obj_type_name(uint8 typ)
+{
+	switch(  typ  ) {
+		case obj_t::obj:                 return "obj";
+		case obj_t::baum:                return "tree";
+		case obj_t::zeiger:              return "pointer";
+		case obj_t::cloud:               return "cloud";
+		case obj_t::gebaeude:            return "building";
+		case obj_t::signal:              return "signal";
+		case obj_t::bruecke:             return "bridge";
+		case obj_t::tunnel:              return "tunnel";
+		case obj_t::bahndepot:           return "rail depot";
+		case obj_t::strassendepot:       return "road depot";
+		case obj_t::schiffdepot:         return "ship depot";
+		case obj_t::airdepot:            return "air depot";
+		case obj_t::monoraildepot:       return "monorail depot";
+		case obj_t::tramdepot:           return "tram depot";
+		case obj_t::maglevdepot:         return "maglev depot";
+		case obj_t::narrowgaugedepot:    return "narrowgauge depot";
+		case obj_t::leitung:             return "powerline";
+		case obj_t::pumpe:               return "power source";
+		case obj_t::senke:               return "power sink";
+		case obj_t::roadsign:            return "roadsign";
+		case obj_t::pillar:              return "pillar";
+		case obj_t::wayobj:              return "wayobj";
+		case obj_t::way:                 return "way";
+		case obj_t::label:               return "label";
+		case obj_t::field:               return "field";
+		case obj_t::crossing:            return "crossing";
+		case obj_t::groundobj:           return "groundobj";
+		case obj_t::pedestrian:          return "pedestrian";
+		case obj_t::road_user:           return "private car";
+		case obj_t::road_vehicle:        return "road vehicle";
+		case obj_t::rail_vehicle:        return "rail vehicle";
+		case obj_t::monorail_vehicle:    return "monorail vehicle";
+		case obj_t::maglev_vehicle:      return "maglev vehicle";
+		case obj_t::narrowgauge_vehicle: return "narrowgauge vehicle";
+		case obj_t::water_vehicle:       return "water vehicle";
+		case obj_t::air_vehicle:         return "air vehicle";
+		case obj_t::movingobj:           return "movingobj";
+		default:                         return NULL;
+	}
+}
+
+
+void memory_stats_t::print(const census_t &census, cbuffer_t &buf)
+{
+	buf.printf( "%-20s %10s %12s\n", "category", "count", "KB" );
+	for(  int c = 0;  c < MAX_CATEGORIES;  c++  ) {
+		buf.printf( "%-20s %10u %12llu\n", category_names[c], census.category[c].count, (unsigned long long)(census.category[c].bytes >> 10) );
+	}
+	const uint64 total = census.get_total_bytes();
+	buf.printf( "%-20s %10s %12llu\n", "total", "", (unsigned long long)(total >> 10) );
+	buf.printf( "%-20s %10u %12llu (bytes)\n", "per tile", census.tiles, (unsigned long long)(census.tiles ? total / census.tiles : 0) );
+
+	buf.printf( "\n%-20s %10s %12s\n", "pool (included)", "", "KB" );
+	for(  int p = 0;  p < MAX_POOLS;  p++  ) {
+		buf.printf( "%-20s %10s %12llu\n", pool_names[p], "", (unsigned long long)(census.pool_bytes[p] >> 10) );
+	}
+
+	buf.printf( "\n%-20s %10s %12s\n", "object type", "count", "KB" );
+	for(  int t = 0;  t < MAX_OBJ_TYPES;  t++  ) {
+		if(  census.obj_type[t].count > 0  ) {
+			const char *name = get_obj_type_name( t );
+			buf.printf( "%-20s %10u %12llu\n", name ? name : "unknown", census.obj_type[t].count, (unsigned long long)(census.obj_type[t].bytes >> 10) );
+		}
+	}
+}
+
+
+void memory_stats_t::log_summary(const karte_t *welt)
+{
+	census_t census;
+	collect( welt, census );
+
+	cbuffer_t buf;
+	print( census, buf );
+
+	// one message per line, so the log stays readable
+	const char *line = buf.get_str();
+	while(  *line  ) {
+		const char *end = strchr( line, '\n' );
+		const int len = end ? (int)(end - line) : (int)strlen( line );
+		dbg->message( "memory_stats_t::log_summary()", "%.*s", len, line );
+		line += end ? len + 1 : len;
+	}
+}
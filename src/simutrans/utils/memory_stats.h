@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_MEMORY_STATS_H
+#define UTILS_MEMORY_STATS_H
+
+
+#include "../simtypes.h"
+
+class cbuffer_t;
+class karte_t;
+
+
+/**
+ * Census of the memory used by the world, split into categories and
+ * object types.
+ *
+ * Nothing is tracked at allocation time: collect() walks all tiles, convoys
+ * and halts and adds up the sizes of the objects and their allocated
+ * buffers. Images, script vms and the memory pools report their own
+ * counters. This takes about as long as a full map redraw, so it is only
+ * done on request.
+ */
+class memory_stats_t
+{
+public:
+	enum category_t {
+		MEM_TILES = 0,
+		MEM_GROUNDS,
+		MEM_OBJLISTS,
+		MEM_OBJECTS,
+		MEM_WAYS,
+		MEM_ROUTES,
+		MEM_HALT_CARGO,
+		MEM_IMAGES,
+		MEM_SCRIPTS,
+		MEM_NETWORK,
+		MAX_CATEGORIES
+	};
+
+	/// allocators, their memory is already included in the categories above
+	enum pool_t {
+		POOL_NODES = 0, ///< freelist_t: grounds, object lists, list nodes
+		POOL_OBJECTS,   ///< freelist_tpl and freelist_iter_tpl: trees, clouds, signs, private cars ...
+		MAX_POOLS
+	};
+
+	/// obj_t::typ are below this
+	enum { MAX_OBJ_TYPES = 96 };
+
+	struct entry_t {
+		uint64 bytes;
+		uint32 count;
+	};
+
+	struct census_t {
+		entry_t category[MAX_CATEGORIES];
+		entry_t obj_type[MAX_OBJ_TYPES];
+		uint64 pool_bytes[MAX_POOLS];
+		uint32 tiles;
+
+		uint64 get_total_bytes() const;
+	};
+
+	/// fills @p census from the current state of @p welt
+	static void collect(const karte_t *welt, census_t &census);
+
+	static const char *get_category_name(category_t cat);
+	static const char *get_pool_name(pool_t pool);
+
+	/// @return NULL for unused types
+	static const char *get_obj_type_name(uint8 typ);
+
+	/// human readable table of all categories and object types
+	static void print(const census_t &census, cbuffer_t &buf);
+
+	/// collects and writes the table to the log
+	static void log_summary(const karte_t *welt);
+};
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "csv.h"
+#include "../simdebug.h"
+#include "../macros.h"
+#include "../sys/simsys.h"
+#include "../tpl/vector_tpl.h"
+
+
+profiler_t::sample_t profiler_t::current[MAX_HISTORY_TYPES];
+profiler_t::sample_t profiler_t::history[MAX_HISTORY_TYPES][HISTORY];
+uint32 profiler_t::head[MAX_HISTORY_TYPES] = { 0, 0 };
+uint32 profiler_t::filled[MAX_HISTORY_TYPES] = { 0, 0 };
+bool profiler_t::tracing = false;
+
+
+// one timed section for the trace file
+struct trace_event_t
+{
+	uint64 start_us;
+	uint32 duration_us;
+	uint8 section;
+};
+
+// about 16 MB, enough for several minutes of a busy game
+#define MAX_TRACE_EVENTS (1u<<20)
+
+static vector_tpl<trace_event_t> trace_events;
+
+
+static const char *section_names[profiler_t::MAX_SECTIONS] = {
+	"step",
+	"sync_step",
+	"display",
+	"new_month",
+	"convoi_step",
+	"city_step",
+	"factory_step",
+	"halt_step",
+	"script"
+};
+
+static const char *counter_names[profiler_t::MAX_COUNTERS] = {
+	"route_searches",
+	"halt_route_searches",
+	"packets_generated",
+	"images_rezoomed",
+	"bytes_sent",
+	"freight_checks",
+	"images_freed"
+};
+
+
+uint64 profiler_t::now_us()
+{
+	static const std::chrono::steady_clock::time_point first = std::chrono::steady_clock::now();
+	return (uint64)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - first ).count();
+}
+
+
+void profiler_t::add_time(section_t sec, uint64 start_us, uint64 end_us)
+{
+	const uint32 delta = (uint32)(end_us - start_us);
+	for(  int t = 0;  t < MAX_HISTORY_TYPES;  t++  ) {
+		current[t].time_us[sec] += delta;
+		current[t].calls[sec] ++;
+	}
+
+	if(  tracing  ) {
+		if(  trace_events.get_count() < MAX_TRACE_EVENTS  ) {
+			trace_event_t ev;
+			ev.start_us = start_us;
+			ev.duration_us = delta;
+			ev.section = (uint8)sec;
+			trace_events.append( ev );
+		}
+		else {
+			dbg->warning( "profiler_t::add_time()", "Trace buffer full (%u events), tracing stopped", trace_events.get_count() );
+			tracing = false;
+		}
+	}
+}
+
+
+void profiler_t::close_sample(history_t type)
+{
+	history[type][head[type]] = current[type];
+	head[type] = (head[type] + 1) % HISTORY;
+	if(  filled[type] < HISTORY  ) {
+		filled[type] ++;
+	}
+	memset( &current[type], 0, sizeof(sample_t) );
+}
+
+
+const profiler_t::sample_t &profiler_t::get_sample(history_t type, uint32 age)
+{
+	assert( age < HISTORY );
+	return history[type][ (head[type] + HISTORY - 1 - age) % HISTORY ];
+}
+
+
+void profiler_t::get_time_stats(history_t type, section_t sec, uint32 &avg_us, uint32 &max_us)
+{
+	uint64 sum = 0;
+	max_us = 0;
+	for(  uint32 i = 0;  i < filled[type];  i++  ) {
+		const uint32 t = get_sample( type, i ).time_us[sec];
+		sum += t;
+		max_us = max( max_us, t );
+	}
+	avg_us = filled[type] ? (uint32)(sum / filled[type]) : 0;
+}
+
+
+uint32 profiler_t::get_average_count(history_t type, counter_t cnt)
+{
+	uint64 sum = 0;
+	for(  uint32 i = 0;  i < filled[type];  i++  ) {
+		sum += get_sample( type, i ).count[cnt];
+	}
+	return filled[type] ? (uint32)(sum / filled[type]) : 0;
+}
+
+
+const char *profiler_t::get_section_name(section_t sec)
+{
+	return section_names[sec];
+}
+
+
+const char *profiler_t::get_counter_name(counter_t cnt)
+{
+	return counter_names[cnt];
+}
+
+
+void profiler_t::set_tracing(bool on)
+{
+	if(  on  &&  !tracing  ) {
+		trace_events.clear();
+	}
+	tracing = on;
+}
+
+
+bool profiler_t::dump_csv(const char *filename)
+{
+	CSV_t csv;
+	csv.add_field( "type" );
+	csv.add_field( "age" );
+	for(  int s = 0;  s < MAX_SECTIONS;  s++  ) {
+		char buf[64];
+		sprintf( buf, "%s_us", section_names[s] );
+		csv.add_field( buf );
+		sprintf( buf, "%s_calls", section_names[s] );
+		csv.add_field( buf );
+	}
+	for(  int c = 0;  c < MAX_COUNTERS;  c++  ) {
+		csv.add_field( counter_names[c] );
+	}
+	csv.new_line();
+
+	for(  int t = 0;  t < MAX_HISTORY_TYPES;  t++  ) {
+		// oldest first
+		for(  uint32 age = filled[t];  age-- > 0;  ) {
+			const sample_t &smp = get_sample( (history_t)t, age );
+			csv.add_field( t == STEPS ? "step" : "frame" );
+			csv.add_field( (int)age );
+			for(  int s = 0;  s < MAX_SECTIONS;  s++  ) {
+				csv.add_field( (int)smp.time_us[s] );
+				csv.add_field( (int)smp.calls[s] );
+			}
+			for(  int c = 0;  c < MAX_COUNTERS;  c++  ) {
+				csv.add_field( (int)smp.count[c] );
+			}
+			csv.new_line();
+		}
+	}
+
+	FILE *f = dr_fopen( filename, "w" );
+	if(  !f  ) {
+		dbg->warning( "profiler_t::dump_csv()", "Cannot open %s for writing", filename );
+		return false;
+	}
+	fputs( csv.get_str(), f );
+	fclose( f );
+	dbg->message( "profiler_t::dump_csv()", "Wrote %d samples to %s", csv.get_lines()-1, filename );
+	return true;
+}
+
+
+bool profiler_t::dump_trace(const char *filename)
+{
+	FILE *f = dr_fopen( filename, "w" );
+	if(  !f  ) {
+		dbg->warning( "profiler_t::dump_trace()", "Cannot open %s for writing", filename );
+		return false;
+	}
+	fputs( "{\"traceEvents\":[\n", f );
+	for(  uint32 i = 0;  i < trace_events.get_count();  i++  ) {
+		const trace_event_t &ev = trace_events[i];
+		fprintf( f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%u}\n",
+			i ? "," : "", section_names[ev.section], (unsigned long long)ev.start_us, ev.duration_us );
+	}
+	fputs( "],\"displayTimeUnit\":\"ms\"}\n", f );
+	fclose( f );
+	dbg->message( "profiler_t::dump_trace()", "Wrote %u events to %s", trace_events.get_count(), filename );
+	return true;
+}
+
+
+void profiler_t::log_summary()
+{
+	if(  filled[STEPS] == 0  ) {
+		return;
+	}
+	const sample_t &last = get_sample( STEPS, 0 );
+	for(  int s = 0;  s < MAX_SECTIONS;  s++  ) {
+		uint32 avg, max;
+		get_time_stats( STEPS, (section_t)s, avg, max );
+		dbg->message( "profiler_t::log_summary()", "%-12s last %7u us (%u calls), avg %7u us, max %7u us",
+			section_names[s], last.time_us[s], last.calls[s], avg, max );
+	}
+	for(  int c = 0;  c < MAX_COUNTERS;  c++  ) {
+		dbg->message( "profiler_t::log_summary()", "%-20s last %7u, avg %7u",
+			counter_names[c], last.count[c], get_average_count( STEPS, (counter_t)c ) );
+	}
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_PROFILER_H
+#define UTILS_PROFILER_H
+
+
+#include "../simtypes.h"
+
+
+/**
+ * Lightweight timers and counters for the hot paths of the simulation.
+ *
+ * The time spent in each section and the counted events are accumulated
+ * for every frame (from one sync_step to the next) and every step (from
+ * one step to the next, i.e. including the frames in between). The last
+ * HISTORY samples of both are kept in ring buffers.
+ *
+ * Timers and counters must only be used from the main thread.
+ */
+class profiler_t
+{
+public:
+	enum section_t {
+		SEC_STEP = 0,
+		SEC_SYNC_STEP,
+		SEC_DISPLAY,
+		SEC_NEW_MONTH,
+		SEC_CONVOI_STEP,
+		SEC_CITY_STEP,
+		SEC_FACTORY_STEP,
+		SEC_HALT_STEP,
+		SEC_SCRIPT,
+		MAX_SECTIONS
+	};
+
+	enum counter_t {
+		CNT_ROUTE_SEARCH = 0,
+		CNT_HALT_ROUTE_SEARCH,
+		CNT_PACKETS_GENERATED,
+		CNT_IMAGES_REZOOMED,
+		CNT_BYTES_SENT,
+		CNT_FREIGHT_CHECKS,
+		CNT_IMAGES_FREED,
+		MAX_COUNTERS
+	};
+
+	enum history_t {
+		FRAMES = 0,
+		STEPS,
+		MAX_HISTORY_TYPES
+	};
+
+	enum { HISTORY = 128 };
+
+	struct sample_t {
+		uint32 time_us[MAX_SECTIONS];
+		uint32 calls[MAX_SECTIONS];
+		uint32 count[MAX_COUNTERS];
+	};
+
+	/// RAII timer for one section
+	class scope_t
+	{
+		const section_t section;
+		const uint64 start;
+	public:
+		explicit scope_t(section_t sec) : section(sec), start(profiler_t::now_us()) {}
+		~scope_t() { profiler_t::add_time(section, start, profiler_t::now_us()); }
+	};
+
+private:
+	static sample_t current[MAX_HISTORY_TYPES];
+	static sample_t history[MAX_HISTORY_TYPES][HISTORY];
+	static uint32 head[MAX_HISTORY_TYPES];
+	static uint32 filled[MAX_HISTORY_TYPES];
+
+	static bool tracing;
+
+	static void close_sample(history_t type);
+
+public:
+	/// microseconds since program start
+	static uint64 now_us();
+
+	static void add_time(section_t sec, uint64 start_us, uint64 end_us);
+
+	static void count(counter_t cnt, uint32 n = 1)
+	{
+		current[FRAMES].count[cnt] += n;
+		current[STEPS].count[cnt] += n;
+	}
+
+	/// closes the sample of the current frame, called at the start of each sync_step
+	static void end_frame() { close_sample(FRAMES); }
+
+	/// closes the sample of the current step, called at the start of each step
+	static void end_step() { close_sample(STEPS); }
+
+	/// number of valid samples in the history
+	static uint32 get_sample_count(history_t type) { return filled[type]; }
+
+	/// @param age 0 is the last completed sample
+	static const sample_t &get_sample(history_t type, uint32 age);
+
+	/// average and maximum time of a section in us over the history
+	static void get_time_stats(history_t type, section_t sec, uint32 &avg_us, uint32 &max_us);
+
+	/// average count per sample over the history
+	static uint32 get_average_count(history_t type, counter_t cnt);
+
+	static const char *get_section_name(section_t sec);
+	static const char *get_counter_name(counter_t cnt);
+
+	/// record every timed section for a Chrome trace file (memory is capped)
+	static void set_tracing(bool on);
+	static bool is_tracing() { return tracing; }
+
+	/// writes the step and frame history as CSV
+	static bool dump_csv(const char *filename);
+
+	/// writes the recorded sections in Chrome trace event format (chrome://tracing)
+	static bool dump_trace(const char *filename);
+
+	/// writes the times of the last step and the averages to the log
+	static void log_summary();
+};
+
+
+#define PROFILE_SCOPE(sec) profiler_t::scope_t profile_scope_(profiler_t::sec)
+
+#endif
@@ -25,6 +25,11 @@ static uint32 mersenne_twister_index = MERSENNE_TWISTER_N + 1; // mersenne_twist
 
 static uint8 random_origin = 0;
 
+// the stream simrand() uses in this thread instead of the global generator
+static thread_local simrand_stream_t *current_stream = NULL;
+
+static uint32 stream_seed = 0;
+
 
 /* initializes mersenne_twister[N] with a seed */
 static void init_genrand(uint32 s)
@@ -80,6 +85,10 @@ uint32 get_random_seed()
 /* generates a random number on [0,0xffffffff]-interval */
 uint32 simrand_plain()
 {
+	if(  current_stream  ) {
+		return current_stream->next();
+	}
+
 	uint32 y;
 
 	if (mersenne_twister_index >= MERSENNE_TWISTER_N) { /* generate N words at one time */
@@ -100,7 +109,7 @@ uint32 simrand_plain()
 /* generates a random number on [0,max-1]-interval */
 uint32 simrand(const uint32 max)
 {
-	assert( (random_origin&INTERACTIVE_RANDOM) == 0  );
+	assert( current_stream  ||  (random_origin&INTERACTIVE_RANDOM) == 0  );
 
 	if(max<=1) { // may rather assert this?
 		return 0;
@@ -120,6 +129,96 @@ void simrand_rdwr(loadsave_t *file)
 	for (uint32 i=0; i<MERSENNE_TWISTER_N; ++i) {
 		file->rdwr_long(mersenne_twister[i]);
 	}
+
+	if(  file->is_version_atleast(124, 2)  ) {
+		file->rdwr_long(stream_seed);
+	}
+	else if(  file->is_loading()  ) {
+		// same on all clients, since derived from the loaded state
+		stream_seed = mersenne_twister[0] ^ mersenne_twister[MERSENNE_TWISTER_N-1];
+	}
+}
+
+
+uint32 get_stream_seed()
+{
+	return stream_seed;
+}
+
+
+// mixes all bits (splitmix64 finaliser)
+static inline uint64 mix64(uint64 z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+
+#ifdef DEBUG_SIMRAND_STREAMS
+#include <set>
+#include "../simdebug.h"
+#ifdef MULTI_THREAD
+#include "simthread.h"
+static pthread_mutex_t used_keys_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// keys used in the current step
+static std::set<uint64> used_keys;
+static uint32 used_keys_step = 0;
+
+// its address identifies the thread
+static thread_local char thread_marker;
+
+static void check_new_stream(uint64 key, uint32 step)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &used_keys_mutex );
+#endif
+	if(  step != used_keys_step  ) {
+		used_keys.clear();
+		used_keys_step = step;
+	}
+	const bool is_new = used_keys.insert( key ).second;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &used_keys_mutex );
+#endif
+	if(  !is_new  ) {
+		dbg->fatal( "simrand_stream_t()", "Stream %llx created twice in step %u, its numbers would repeat", (unsigned long long)key, step );
+	}
+}
+#endif
+
+
+simrand_stream_t::simrand_stream_t(uint32 seed, uint32 id, uint32 step)
+{
+	key = mix64( mix64( ((uint64)seed << 32) | id ) ^ step );
+	counter = 0;
+#ifdef DEBUG_SIMRAND_STREAMS
+	check_new_stream( key, step );
+	owner = &thread_marker;
+#endif
+	previous = current_stream;
+	current_stream = this;
+}
+
+
+simrand_stream_t::~simrand_stream_t()
+{
+	assert( current_stream == this ); // streams must be destroyed in reverse order
+	current_stream = previous;
+}
+
+
+/* the n-th number is a hash of the key and n, so nearby ids and steps are unrelated */
+uint32 simrand_stream_t::next()
+{
+#ifdef DEBUG_SIMRAND_STREAMS
+	if(  owner != &thread_marker  ) {
+		dbg->fatal( "simrand_stream_t::next()", "Stream %llx used by another thread", (unsigned long long)key );
+	}
+#endif
+	return (uint32)(mix64( key + (++counter) * 0x9E3779B97F4A7C15ull ) >> 32);
 }
 
 
@@ -164,6 +263,7 @@ uint32 setsimrand(uint32 seed,uint32 ns)
 
 	if(seed!=0xFFFFFFFF) {
 		init_genrand( seed );
+		stream_seed = (uint32)mix64( seed );
 		async_rand_seed = seed + dr_time(); // dr_time() ok here. re comment ^^^. setsimrand not called immediately on program startup.
 		random_origin = 0;
 	}
@@ -34,6 +34,40 @@ uint32 simrand_plain();
 /// reads/writes the sate of the random number generator
 void simrand_rdwr(loadsave_t *file);
 
+// define to check that no two streams with the same seed, id and step are
+// created and that a stream is only used by the thread which created it
+//#define DEBUG_SIMRAND_STREAMS
+
+/**
+ * Random numbers, which only depend on a seed, the number of a part of the
+ * work (like a region of the map or an object) and the step. The n-th number
+ * of a stream is computed from these and n alone (counter based), so streams
+ * can be split without any shared state.
+ *
+ * While it exists, simrand() in this thread uses it instead of the global
+ * generator. So the parts can run in parallel and still give the same result
+ * for any number of threads, also in network games.
+ */
+class simrand_stream_t
+{
+	uint64 key;
+	uint64 counter;
+	simrand_stream_t *previous;
+#ifdef DEBUG_SIMRAND_STREAMS
+	const void *owner;
+#endif
+
+public:
+	simrand_stream_t(uint32 seed, uint32 id, uint32 step = 0);
+	~simrand_stream_t();
+
+	/* generates a random number on [0,0xFFFFFFFFu]-interval */
+	uint32 next();
+};
+
+/// seed for the streams of objects, part of the game state and saved with it
+uint32 get_stream_seed();
+
 double perlin_noise_2D(const double x, const double y, const double persistence);
 
 // for network debugging, i.e. finding hidden simrands in wrong places
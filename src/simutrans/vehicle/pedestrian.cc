@@ -13,6 +13,7 @@
 #include "../ground/grund.h"
 #include "../dataobj/loadsave.h"
 #include "../dataobj/translator.h"
+#include "../dataobj/environment.h"
 
 #include "../utils/cbuffer.h"
 #include "../descriptor/pedestrian_desc.h"
@@ -238,6 +239,14 @@ int pedestrian_t::generate_pedestrians_near(grund_t *gr, int count)
 }
 
 
+void pedestrian_t::sync_handler(uint32 delta_t)
+{
+	// pedestrians do not affect the game state, so they may move differently on each client
+	static uint32 calls = 0, far_delta = 0;
+	sync_step_near_far( fl, delta_t, env_t::far_traffic_interval, calls, far_delta );
+}
+
+
 sync_result pedestrian_t::sync_step(uint32 delta_t)
 {
 	time_to_life -= delta_t;
@@ -50,7 +50,8 @@ protected:
 public:
 	pedestrian_t(loadsave_t *file);
 
-	static void sync_handler(uint32 delta_t) { fl.sync_step(delta_t); }
+	/// pedestrians far from the view are stepped only every env_t::far_traffic_interval-th call
+	static void sync_handler(uint32 delta_t);
 
 	const pedestrian_desc_t *get_desc() const { return desc; }
 
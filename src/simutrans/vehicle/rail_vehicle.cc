@@ -19,7 +19,8 @@
 
 
 /* from now on rail vehicles (and other vehicles using blocks) */
-rail_vehicle_t::rail_vehicle_t(loadsave_t *file, bool is_first, bool is_last) : vehicle_t()
+rail_vehicle_t::rail_vehicle_t(loadsave_t *file, bool is_first, bool is_last) : vehicle_t(),
+	block_cache(NULL)
 {
 	vehicle_t::rdwr_from_convoi(file);
 
@@ -63,7 +64,8 @@ DBG_MESSAGE("rail_vehicle_t::rail_vehicle_t()","replaced by %s",desc->get_name()
 
 
 rail_vehicle_t::rail_vehicle_t(koord3d pos, const vehicle_desc_t* desc, player_t* player, convoi_t* cn) :
-	vehicle_t(pos, desc, player)
+	vehicle_t(pos, desc, player),
+	block_cache(NULL)
 {
 	cnv = cn;
 }
@@ -86,6 +88,7 @@ rail_vehicle_t::~rail_vehicle_t()
 			sch->unreserve(this);
 		}
 	}
+	delete block_cache;
 }
 
 
@@ -686,6 +689,50 @@ bool rail_vehicle_t::can_enter_tile(const grund_t *gr, sint32 &restart_speed, ui
 }
 
 
+// tiles added to the block cache at once
+#define BLOCK_CACHE_STEP (32)
+
+schiene_t *rail_vehicle_t::get_route_track(const route_t *route, uint32 i, ribi_t::ribi &dir) const
+{
+	if(  block_cache == NULL  ) {
+		block_cache = new block_cache_t;
+		block_cache->route = NULL;
+	}
+	block_cache_t &bc = *block_cache;
+
+	if(  bc.route != route  ||  bc.route_serial != route->get_serial()  ||  bc.network_serial != schiene_t::get_network_serial()
+		||  i < bc.first  ||  i > bc.first + bc.tracks.get_count()  ) {
+		// outdated or not next to the cached tiles => start again here
+		bc.route = route;
+		bc.route_serial = route->get_serial();
+		bc.network_serial = schiene_t::get_network_serial();
+		bc.first = i;
+		bc.tracks.clear();
+		bc.dirs.clear();
+	}
+
+	if(  i == bc.first + bc.tracks.get_count()  ) {
+		// same directions as ribi_type( route->at(k-1), route->at(k+1) ) with the ends clipped
+		const uint32 end = min( route->get_count(), i + BLOCK_CACHE_STEP );
+		koord3d prev = route->at( max(1u,i)-1u );
+		route_t::const_iterator it = route->iterator_at( i );
+		for(  uint32 k = i;  k < end;  k++  ) {
+			const koord3d pos = *it;
+			if(  k + 1 < route->get_count()  ) {
+				++it;
+			}
+			grund_t *gr = welt->lookup( pos );
+			bc.tracks.append( gr ? (schiene_t *)gr->get_weg( get_waytype() ) : NULL );
+			bc.dirs.append( ribi_type( prev, *it ) );
+			prev = pos;
+		}
+	}
+
+	dir = bc.dirs[i - bc.first];
+	return bc.tracks[i - bc.first];
+}
+
+
 /**
  * reserves or un-reserves all blocks and returns the handle to the next block (if there)
  * if count is larger than 1, (and defined) maximum MAX_CHOOSE_BLOCK_TILES tiles will be checked
@@ -699,7 +746,7 @@ bool rail_vehicle_t::block_reserver(const route_t *route, route_t::index_t start
 #ifdef MAX_CHOOSE_BLOCK_TILES
 	int max_tiles=2*MAX_CHOOSE_BLOCK_TILES; // max tiles to check for choosesignals
 #endif
-	slist_tpl<grund_t *> signs; // switch all signals on their way too ...
+	vector_tpl<schiene_t *> signs; // switch all signals on their way too ...
 
 	if(start_index>=route->get_count()) {
 		cnv->set_next_reservation_index( max(route->get_count(),1)-1 );
@@ -719,40 +766,21 @@ bool rail_vehicle_t::block_reserver(const route_t *route, route_t::index_t start
 	next_signal_index = route_t::INVALID_INDEX;
 	next_crossing_index = route_t::INVALID_INDEX;
 	bool unreserve_now = false;
+	ribi_t::ribi dir;
 
-	for ( ; success  &&  count>=0  &&  i<route->get_count(); i++) {
-
-		koord3d pos = route->at(i);
-		grund_t *gr = welt->lookup(pos);
-		schiene_t * sch1 = gr ? (schiene_t *)gr->get_weg(get_waytype()) : NULL;
-		if(sch1==NULL  &&  reserve) {
-			// reserve until the end of track
-			break;
-		}
-		// we un-reserve also nonexistent tiles! (may happen during deletion)
-
+	if(  !reserve  ) {
+		for ( ; count>=0  &&  i<route->get_count(); i++) {
+			schiene_t *sch1 = get_route_track( route, i, dir );
 #ifdef MAX_CHOOSE_BLOCK_TILES
-		max_tiles--;
-		if(max_tiles<0  &&   count>1) {
-			break;
-		}
-#endif
-		if(reserve) {
-			if(  sch1->has_signal()  &&  i<route->get_count()-1  ) {
-				if(count) {
-					signs.append(gr);
-				}
-				count --;
-				next_signal_index = i;
+			max_tiles--;
+			if(max_tiles<0  &&   count>1) {
+				break;
 			}
-			if(  !sch1->reserve( cnv->self, ribi_type( route->at(max(1u,i)-1u), route->at(min(route->get_count()-1u,i+1u)) ) )  ) {
-				success = false;
-			}
-			if(next_crossing_index==route_t::INVALID_INDEX  &&  sch1->is_crossing()) {
-				next_crossing_index = i;
+#endif
+			// we un-reserve also nonexistent tiles! (may happen during deletion)
+			if(  sch1==NULL  ) {
+				continue;
 			}
-		}
-		else if(sch1) {
 			if(!sch1->unreserve(cnv->self)) {
 				if(unreserve_now) {
 					// reached an reserved or free track => finished
@@ -763,39 +791,72 @@ bool rail_vehicle_t::block_reserver(const route_t *route, route_t::index_t start
 				// un-reserve from here (used during sale, since there might be reserved tiles not freed)
 				unreserve_now = !force_unreserve;
 			}
-			if(sch1->has_signal()) {
-				signal_t* signal = gr->find<signal_t>();
-				if(signal) {
-					signal->set_state(roadsign_t::STATE_RED);
+			if(  sch1->has_signal()  ||  sch1->is_crossing()  ) {
+				grund_t *gr = welt->lookup( sch1->get_pos() );
+				if(sch1->has_signal()) {
+					signal_t* signal = gr->find<signal_t>();
+					if(signal) {
+						signal->set_state(roadsign_t::STATE_RED);
+					}
+				}
+				if(sch1->is_crossing()) {
+					gr->find<crossing_t>()->release_crossing(this);
 				}
-			}
-			if(sch1->is_crossing()) {
-				gr->find<crossing_t>()->release_crossing(this);
 			}
 		}
+		return false;
 	}
 
-	if(!reserve) {
-		return false;
+	// first find the end of the block and check whether all of it can be reserved
+	for ( ; success  &&  count>=0  &&  i<route->get_count(); i++) {
+
+		schiene_t *sch1 = get_route_track( route, i, dir );
+		if(sch1==NULL) {
+			// reserve until the end of track
+			break;
+		}
+
+#ifdef MAX_CHOOSE_BLOCK_TILES
+		max_tiles--;
+		if(max_tiles<0  &&   count>1) {
+			break;
+		}
+#endif
+		if(  sch1->has_signal()  &&  i<route->get_count()-1  ) {
+			if(count) {
+				signs.append(sch1);
+			}
+			count --;
+			next_signal_index = i;
+		}
+		if(  !sch1->can_reserve( cnv->self )  ) {
+			success = false;
+		}
+		if(next_crossing_index==route_t::INVALID_INDEX  &&  sch1->is_crossing()) {
+			next_crossing_index = i;
+		}
 	}
-	// here we go only with reserve
 
 //DBG_MESSAGE("block_reserver()","signals at %i, success=%d",next_signal_index,success);
 
-	// free, in case of un-reserve or no success in reservation
+	// not free: release what we may still hold in this range
 	if(!success) {
-		// free reservation
 		for ( route_t::index_t j=start_index; j<i; j++) {
-			schiene_t * sch1 = (schiene_t *)welt->lookup( route->at(j))->get_weg(get_waytype());
-			sch1->unreserve(cnv->self);
+			get_route_track( route, j, dir )->unreserve(cnv->self);
 		}
 		cnv->set_next_reservation_index( start_index );
 		return false;
 	}
 
+	// now reserve the whole block
+	for ( route_t::index_t j=start_index; j<i; j++) {
+		schiene_t *sch1 = get_route_track( route, j, dir );
+		sch1->reserve( cnv->self, dir );
+	}
+
 	// ok, switch everything green ...
-	for(grund_t* const g : signs) {
-		if (signal_t* const signal = g->find<signal_t>()) {
+	for(schiene_t* const sch : signs) {
+		if (signal_t* const signal = welt->lookup( sch->get_pos() )->find<signal_t>()) {
 			signal->set_state(roadsign_t::STATE_GREEN);
 		}
 	}
@@ -9,6 +9,8 @@
 
 #include "vehicle.h"
 
+class schiene_t;
+
 
 /**
  * A class for rail vehicles (trains). Manages the look of the vehicles
@@ -17,6 +19,30 @@
  */
 class rail_vehicle_t : public vehicle_t
 {
+private:
+	/**
+	 * Tracks and driving directions along a part of the route, so block_reserver()
+	 * does not need to decode the route and look up every tile again and again
+	 * while waiting at a signal.
+	 * Valid as long as neither the route nor the track network changed.
+	 */
+	struct block_cache_t {
+		const route_t *route;
+		uint32 route_serial;
+		uint32 network_serial;
+		uint32 first;                   ///< route index of tracks[0]
+		vector_tpl<schiene_t *> tracks; ///< NULL if there is no track at this index
+		vector_tpl<ribi_t::ribi> dirs;  ///< direction for schiene_t::reserve()
+	};
+
+	mutable block_cache_t *block_cache;
+
+	/**
+	 * @return track at route index @p i (or NULL) from the block cache, which is extended or rebuilt as needed
+	 * @param[out] dir driving direction on this tile
+	 */
+	schiene_t *get_route_track(const route_t *route, uint32 i, ribi_t::ribi &dir) const;
+
 protected:
 	bool check_next_tile(const grund_t *bd) const OVERRIDE;
 
@@ -5,6 +5,7 @@
 
 #include "../simdebug.h"
 #include "../display/simgraph.h"
+#include "../display/viewport.h"
 #include "../simmesg.h"
 #include "../world/simworld.h"
 #include "../utils/simrandom.h"
@@ -52,6 +53,40 @@ road_user_t::road_user_t() :
 }
 
 
+// tiles visible around the view center, in screen columns (dx-dy) and rows (dx+dy)
+static koord view_center;
+static sint32 view_columns = 0;
+static sint32 view_rows = 0;
+
+// also treat tiles this close to the screen border as visible
+#define VIEW_MARGIN_TILES (4)
+
+
+void road_user_t::update_view_area()
+{
+	const viewport_t *vp = welt->get_viewport();
+	if(  vp == NULL  ) {
+		// no view yet, everything counts as visible
+		view_columns = view_rows = 0x7FFFFFFF;
+		return;
+	}
+	const scr_coord_val raster = max( get_tile_raster_width(), (scr_coord_val)1 );
+	view_center = vp->get_world_position();
+	view_columns = display_get_width() / raster + VIEW_MARGIN_TILES;
+	view_rows = (2 * display_get_height()) / raster + 2 * VIEW_MARGIN_TILES;
+}
+
+
+bool road_user_t::is_far_from_view(const koord3d &pos)
+{
+	const sint32 dx = pos.x - view_center.x;
+	const sint32 dy = pos.y - view_center.y;
+	// higher tiles are drawn further up
+	const sint32 row = dx + dy - (4 * pos.z * TILE_HEIGHT_STEP) / max( get_base_tile_raster_width(), (scr_coord_val)1 );
+	return abs(dx - dy) > view_columns  ||  abs(row) > view_rows;
+}
+
+
 /**
  * Ensures that this object is removed correctly from the list
  * of sync step-able things!
@@ -352,6 +387,14 @@ private_car_t::private_car_t(grund_t* gr, koord const target, const char* name)
 }
 
 
+void private_car_t::sync_handler(uint32 delta_t)
+{
+	static uint32 calls = 0, far_delta = 0;
+	// the cars are part of the game state, so in network games all clients must step them alike
+	sync_step_near_far( fl, delta_t, env_t::networkmode ? 1 : env_t::far_traffic_interval, calls, far_delta );
+}
+
+
 sync_result private_car_t::sync_step(uint32 delta_t)
 {
 	time_to_life -= delta_t;
@@ -40,6 +40,33 @@ protected:
 
 	road_user_t();
 
+	/// caches the part of the map around the main view
+	static void update_view_area();
+
+	/// true if @p pos is not visible in the main view
+	static bool is_far_from_view(const koord3d &pos);
+
+	/**
+	 * Steps all objects of @p fl, but those far from the view only every @p interval-th call,
+	 * with the time since their last step. @p calls and @p far_delta keep the state of @p fl.
+	 */
+	template<class T> static void sync_step_near_far(freelist_iter_tpl<T> &fl, uint32 delta_t, uint32 interval, uint32 &calls, uint32 &far_delta)
+	{
+		if(  interval <= 1  ) {
+			fl.sync_step(delta_t);
+			return;
+		}
+		far_delta += delta_t;
+		uint32 far_step = 0;
+		if(  ++calls >= interval  ) {
+			far_step = far_delta;
+			calls = 0;
+			far_delta = 0;
+		}
+		update_view_area();
+		fl.sync_step_each( [delta_t, far_step](const T &obj) { return is_far_from_view(obj.get_pos()) ? far_step : delta_t; } );
+	}
+
 	/**
 	 * Creates thing at position given by @p gr.
 	 * Does not add it to the tile!
@@ -118,7 +145,8 @@ public:
 	void* operator new(size_t) { return fl.gimme_node(); }
 	void operator delete(void* p) { return fl.putback_node(p); }
 
-	static void sync_handler(uint32 delta_t) { fl.sync_step(delta_t); }
+	/// in single player games the cars far from the view are stepped only every env_t::far_traffic_interval-th call
+	static void sync_handler(uint32 delta_t);
 
 	void rotate90() OVERRIDE;
 
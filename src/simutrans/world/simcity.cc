@@ -121,12 +121,98 @@ public:
 	}
 };
 
+/**
+ * Tile properties tested by the rules
+ */
+enum rule_class_t {
+	RULE_ROAD = 0,
+	RULE_FUNDAMENT,
+	RULE_HOUSE,
+	RULE_NATURE,
+	RULE_WAY_SLOPE,
+	RULE_HALT,
+	MAX_RULE_CLASSES
+};
+
+/**
+ * The properties of the 7x7 tiles around a position,
+ * one bit (x + 7*y) per tile and property
+ */
+struct rule_area_t {
+	koord pos;
+	bool classified;
+	uint64 bits[MAX_RULE_CLASSES];
+	uint64 outside; // not on the map
+
+	rule_area_t(koord k) : pos(k), classified(false) {}
+};
+
+// the properties tested by any rule, others are not classified
+static uint8 rule_classes = 0;
+
 class rule_t {
 public:
 	sint16  chance;
 	vector_tpl<rule_entry_t> rule;
+
+	// compiled for each rotation: tiles which must have or must not have a property, and all tested tiles
+	uint64 must_have[4][MAX_RULE_CLASSES];
+	uint64 must_not[4][MAX_RULE_CLASSES];
+	uint64 tested[4];
+
 	rule_t(uint32 count=0) : chance(0), rule(count) {}
 
+	/// builds the masks from the entries, returns the tested properties
+	uint8 compile()
+	{
+		uint8 classes = 0;
+		MEMZERO(must_have);
+		MEMZERO(must_not);
+		MEMZERO(tested);
+		for(rule_entry_t const& r : rule) {
+			for(  int rot = 0;  rot < 4;  rot++  ) {
+				uint8 x,y;
+				switch (rot) {
+					default:
+					case 0: x=r.x; y=r.y; break;
+					case 1: x=r.y; y=6-r.x; break;
+					case 2: x=6-r.x; y=6-r.y; break;
+					case 3: x=6-r.y; y=r.x; break;
+				}
+				const uint64 bit = 1ull << (x + 7*y);
+				tested[rot] |= bit;
+				switch (r.flag) {
+					case 's': must_have[rot][RULE_ROAD] |= bit; classes |= 1<<RULE_ROAD; break;
+					case 'S': must_not[rot][RULE_ROAD] |= bit; classes |= 1<<RULE_ROAD; break;
+					case 'h': must_have[rot][RULE_HOUSE] |= bit; classes |= 1<<RULE_HOUSE; break;
+					case 'H': must_not[rot][RULE_FUNDAMENT] |= bit; classes |= 1<<RULE_FUNDAMENT; break;
+					case 'n': must_have[rot][RULE_NATURE] |= bit; classes |= 1<<RULE_NATURE; break;
+					case 'U': must_have[rot][RULE_WAY_SLOPE] |= bit; classes |= 1<<RULE_WAY_SLOPE; break;
+					case 'u': must_not[rot][RULE_WAY_SLOPE] |= bit; classes |= 1<<RULE_WAY_SLOPE; break;
+					case 't': must_have[rot][RULE_HALT] |= bit; classes |= 1<<RULE_HALT; break;
+					case 'T': must_not[rot][RULE_HALT] |= bit; classes |= 1<<RULE_HALT; break;
+					default: ;
+						// ignore
+				}
+			}
+		}
+		return classes;
+	}
+
+	bool matches(const rule_area_t &area, int rot) const
+	{
+		if(  tested[rot] & area.outside  ) {
+			// outside of the map => cannot apply this rule
+			return false;
+		}
+		for(  int c = 0;  c < MAX_RULE_CLASSES;  c++  ) {
+			if(  (must_have[rot][c] & ~area.bits[c])  ||  (must_not[rot][c] & area.bits[c])  ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 	void rdwr(loadsave_t* file)
 	{
 		file->rdwr_short(chance);
@@ -151,6 +237,18 @@ static vector_tpl<rule_t *> house_rules;
 // and road rules
 static vector_tpl<rule_t *> road_rules;
 
+
+static void compile_rules()
+{
+	rule_classes = 0;
+	for(rule_t *r : house_rules) {
+		rule_classes |= r->compile();
+	}
+	for(rule_t *r : road_rules) {
+		rule_classes |= r->compile();
+	}
+}
+
 /**
  * Symbols in rules:
  * S = not a road
@@ -169,73 +267,46 @@ static vector_tpl<rule_t *> road_rules;
 static char const* const allowed_chars_in_rule = "SsnHhTtUu";
 
 /**
- * @param pos position to check
- * @param regel the rule to evaluate
- * @return true on match, false otherwise
+ * Looks up the properties of the tiles around area.pos needed by the rules
  */
-bool stadt_t::bewerte_loc(const koord pos, const rule_t &regel, int rotation)
+void stadt_t::classify_area(rule_area_t &area)
 {
-	//printf("Test for (%s) in rotation %d\n", pos.get_str(), rotation);
-	koord k;
-
-	for(rule_entry_t const& r : regel.rule) {
-		uint8 x,y;
-		switch (rotation) {
-			default:
-			case   0: x=r.x; y=r.y; break;
-			case  90: x=r.y; y=6-r.x; break;
-			case 180: x=6-r.x; y=6-r.y; break;
-			case 270: x=6-r.y; y=r.x; break;
-		}
-
-		const koord k(pos.x+x-3, pos.y+y-3);
-		const grund_t* gr = welt->lookup_kartenboden(k);
-		if (gr == NULL) {
-			// outside of the map => cannot apply this rule
-			return false;
-		}
-		switch (r.flag) {
-			case 's':
-				// road?
-				if (!gr->hat_weg(road_wt)) return false;
-				break;
-			case 'S':
-				// not road?
-				if (gr->hat_weg(road_wt)) return false;
-				break;
-			case 'h':
-				// is house
-				if (gr->get_typ() != grund_t::fundament  ||  gr->obj_bei(0)->get_typ()!=obj_t::gebaeude) return false;
-				break;
-			case 'H':
-				// no house
-				if (gr->get_typ() == grund_t::fundament) return false;
-				break;
-			case 'n':
-				// nature/empty
-				if (!gr->ist_natur() || gr->kann_alle_obj_entfernen(NULL) != NULL) return false;
-				break;
-			case 'U':
-				// unbuildable for road
-				if (!slope_t::is_way(gr->get_grund_hang())) return false;
-				break;
-			case 'u':
-				// road may be buildable
-				if (slope_t::is_way(gr->get_grund_hang())) return false;
-				break;
-			case 't':
-				// here is a stop/extension building
-				if (!gr->is_halt()) return false;
-				break;
-			case 'T':
-				// no stop
-				if (gr->is_halt()) return false;
-				break;
-			default: ;
-				// ignore
+	MEMZERO(area.bits);
+	area.outside = 0;
+	for(  uint8 y = 0;  y < 7;  y++  ) {
+		for(  uint8 x = 0;  x < 7;  x++  ) {
+			const uint64 bit = 1ull << (x + 7*y);
+			const koord k = area.pos + koord(x-3, y-3);
+			// most rules are answered by the tile summary, only houses and nature need the ground itself
+			const surface_t::tile_summary_t *ts = welt->get_tile_summary(k);
+			if (ts == NULL) {
+				area.outside |= bit;
+				continue;
+			}
+			if(  (rule_classes & (1<<RULE_ROAD))  &&  (ts->ways & surface_t::get_way_bit(road_wt))  ) {
+				area.bits[RULE_ROAD] |= bit;
+			}
+			if(  ts->ground_typ == grund_t::fundament  ) {
+				area.bits[RULE_FUNDAMENT] |= bit;
+				const grund_t *gr = welt->lookup_kartenboden_nocheck(k);
+				if(  gr->obj_bei(0)  &&  gr->obj_bei(0)->get_typ() == obj_t::gebaeude  ) {
+					area.bits[RULE_HOUSE] |= bit;
+				}
+			}
+			if(  (rule_classes & (1<<RULE_NATURE))  &&  (ts->ground_typ == grund_t::boden  ||  ts->ground_typ == grund_t::tunnelboden)  &&  ts->ways == 0  &&  ts->halt_id == 0  ) {
+				if(  welt->lookup_kartenboden_nocheck(k)->kann_alle_obj_entfernen(NULL) == NULL  ) {
+					area.bits[RULE_NATURE] |= bit;
+				}
+			}
+			if(  slope_t::is_way(ts->slope)  ) {
+				area.bits[RULE_WAY_SLOPE] |= bit;
+			}
+			if(  (rule_classes & (1<<RULE_HALT))  &&  ts->halt_id != 0  ) {
+				area.bits[RULE_HALT] |= bit;
+			}
 		}
 	}
-	return true;
+	area.classified = true;
 }
 
 
@@ -243,31 +314,33 @@ bool stadt_t::bewerte_loc(const koord pos, const rule_t &regel, int rotation)
  * Check rule in all transformations at given position
  * @note but the rules should explicitly forbid building then?!?
  */
-sint32 stadt_t::bewerte_pos(const koord pos, const rule_t &regel)
+sint32 stadt_t::bewerte_pos(rule_area_t &area, const rule_t &regel)
 {
+	if(  !area.classified  ) {
+		classify_area(area);
+	}
 	// will be called only a single time, so we can stop after a single match
-	if(bewerte_loc(pos, regel,   0) ||
-		 bewerte_loc(pos, regel,  90) ||
-		 bewerte_loc(pos, regel, 180) ||
-		 bewerte_loc(pos, regel, 270)) {
-		return 1;
+	for(  int rot = 0;  rot < 4;  rot++  ) {
+		if(  regel.matches(area, rot)  ) {
+			return 1;
+		}
 	}
 	return 0;
 }
 
 
-void stadt_t::bewerte_strasse(koord k, sint32 rd, const rule_t &regel)
+void stadt_t::bewerte_strasse(rule_area_t &area, sint32 rd, const rule_t &regel)
 {
 	if (simrand(rd) == 0) {
-		best_strasse.check(k, bewerte_pos(k, regel));
+		best_strasse.check(area.pos, bewerte_pos(area, regel));
 	}
 }
 
 
-void stadt_t::bewerte_haus(koord k, sint32 rd, const rule_t &regel)
+void stadt_t::bewerte_haus(rule_area_t &area, sint32 rd, const rule_t &regel)
 {
 	if (simrand(rd) == 0) {
-		best_haus.check(k, bewerte_pos(k, regel));
+		best_haus.check(area.pos, bewerte_pos(area, regel));
 	}
 }
 
@@ -424,6 +497,7 @@ bool stadt_t::cityrules_init()
 			}
 		}
 	}
+	compile_rules();
 	return true;
 }
 
@@ -480,6 +554,9 @@ void stadt_t::cityrules_rdwr(loadsave_t *file)
 		}
 		road_rules[i]->rdwr(file);
 	}
+	if (file->is_loading()) {
+		compile_rules();
+	}
 }
 
 /**
@@ -786,7 +863,7 @@ void stadt_t::factory_set_t::remove_factory(fabrik_t *const factory)
 #define SUPPLY_BITS   (3)
 #define SUPPLY_FACTOR (9) // out of 2^SUPPLY_BITS
 
-void stadt_t::factory_set_t::recalc_generation_ratio(const sint32 default_percent, const sint64 *city_stats, const int stats_count, const int stat_type)
+void stadt_t::factory_set_t::recalc_generation_ratio(const sint32 default_percent, const history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> &city_stats, const int stat_type)
 {
 	ratio_stale = false; // reset flag
 
@@ -794,7 +871,7 @@ void stadt_t::factory_set_t::recalc_generation_ratio(const sint32 default_percen
 	uint32 months = 0;
 	sint64 average_generated = 0;
 	sint64 month_generated;
-	while(  months<3  &&  (month_generated=city_stats[(months+1)*stats_count+stat_type])>0  ) {
+	while(  months<3  &&  (month_generated=city_stats.at(months+1, stat_type))>0  ) {
 		average_generated += month_generated;
 		++months;
 	}
@@ -1045,28 +1122,16 @@ stadt_t::stadt_t(player_t* player, koord pos, sint32 citizens) :
 		change_size( citizens, true );
 	}
 
-	// fill with start citizen ...
+	// initialize history array and fill with start citizen ...
+	city_history_year.clear();
+	city_history_month.clear();
 	sint64 bew = get_einwohner();
 	for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
-		city_history_year[year][HIST_CITIZENS] = bew;
+		city_history_year.at(year, HIST_CITIZENS) = bew;
 	}
 	for (uint month = 0; month < MAX_CITY_HISTORY_MONTHS; month++) {
-		city_history_month[month][HIST_CITIZENS] = bew;
+		city_history_month.at(month, HIST_CITIZENS) = bew;
 	}
-
-	// initialize history array
-	for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
-		for (uint hist_type = 1; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_year[year][hist_type] = 0;
-		}
-	}
-	for (uint month = 0; month < MAX_CITY_HISTORY_YEARS; month++) {
-		for (uint hist_type = 1; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_month[month][hist_type] = 0;
-		}
-	}
-	city_history_year[0][HIST_CITIZENS]  = get_einwohner();
-	city_history_month[0][HIST_CITIZENS] = get_einwohner();
 #ifdef DESTINATION_CITYCARS
 	number_of_cars = 0;
 #endif
@@ -1140,18 +1205,10 @@ void stadt_t::rdwr(loadsave_t* file)
 
 	if(file->is_loading()) {
 		// initialize history array
-		for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
-			for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-				city_history_year[year][hist_type] = 0;
-			}
-		}
-		for (uint month = 0; month < MAX_CITY_HISTORY_MONTHS; month++) {
-			for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-				city_history_month[month][hist_type] = 0;
-			}
-		}
-		city_history_year[0][HIST_CITIZENS] = get_einwohner();
-		city_history_year[0][HIST_CITIZENS] = get_einwohner();
+		city_history_year.clear();
+		city_history_month.clear();
+		city_history_year.at(0, HIST_CITIZENS) = get_einwohner();
+		city_history_year.at(0, HIST_CITIZENS) = get_einwohner();
 	}
 
 	// we probably need to load/save the city history
@@ -1161,18 +1218,18 @@ void stadt_t::rdwr(loadsave_t* file)
 		// 86.00.0 introduced city history
 		for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
 			for (uint hist_type = 0; hist_type < 2; hist_type++) {
-				file->rdwr_longlong(city_history_year[year][hist_type]);
+				file->rdwr_longlong(city_history_year.at(year, hist_type));
 			}
 			for (uint hist_type = 4; hist_type < 6; hist_type++) {
-				file->rdwr_longlong(city_history_year[year][hist_type]);
+				file->rdwr_longlong(city_history_year.at(year, hist_type));
 			}
 		}
 		for (uint month = 0; month < MAX_CITY_HISTORY_MONTHS; month++) {
 			for (uint hist_type = 0; hist_type < 2; hist_type++) {
-				file->rdwr_longlong(city_history_month[month][hist_type]);
+				file->rdwr_longlong(city_history_month.at(month, hist_type));
 			}
 			for (uint hist_type = 4; hist_type < 6; hist_type++) {
-				file->rdwr_longlong(city_history_month[month][hist_type]);
+				file->rdwr_longlong(city_history_month.at(month, hist_type));
 			}
 		}
 		// not needed any more
@@ -1189,7 +1246,7 @@ void stadt_t::rdwr(loadsave_t* file)
 				if(  hist_type==HIST_PAS_WALKED  ||  hist_type==HIST_MAIL_WALKED  ) {
 					continue;
 				}
-				file->rdwr_longlong(city_history_year[year][hist_type]);
+				file->rdwr_longlong(city_history_year.at(year, hist_type));
 			}
 		}
 		for (uint month = 0; month < MAX_CITY_HISTORY_MONTHS; month++) {
@@ -1197,7 +1254,7 @@ void stadt_t::rdwr(loadsave_t* file)
 				if(  hist_type==HIST_PAS_WALKED  ||  hist_type==HIST_MAIL_WALKED  ) {
 					continue;
 				}
-				file->rdwr_longlong(city_history_month[month][hist_type]);
+				file->rdwr_longlong(city_history_month.at(month, hist_type));
 			}
 		}
 		// save button settings for this town
@@ -1207,12 +1264,12 @@ void stadt_t::rdwr(loadsave_t* file)
 		// 120,001 with walking (direct connections) recored seperately
 		for (uint year = 0; year < MAX_CITY_HISTORY_YEARS; year++) {
 			for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-				file->rdwr_longlong(city_history_year[year][hist_type]);
+				file->rdwr_longlong(city_history_year.at(year, hist_type));
 			}
 		}
 		for (uint month = 0; month < MAX_CITY_HISTORY_MONTHS; month++) {
 			for (uint hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-				file->rdwr_longlong(city_history_month[month][hist_type]);
+				file->rdwr_longlong(city_history_month.at(month, hist_type));
 			}
 		}
 		// save button settings for this town
@@ -1445,10 +1502,10 @@ void stadt_t::step(uint32 delta_t)
 	// recalculate factory going ratios where necessary
 	const sint16 factory_worker_percentage = welt->get_settings().get_factory_worker_percentage();
 	if(  target_factories_pax.ratio_stale  ) {
-		target_factories_pax.recalc_generation_ratio( factory_worker_percentage, *city_history_month, MAX_CITY_HISTORY, HIST_PAS_GENERATED);
+		target_factories_pax.recalc_generation_ratio( factory_worker_percentage, city_history_month, HIST_PAS_GENERATED);
 	}
 	if(  target_factories_mail.ratio_stale  ) {
-		target_factories_mail.recalc_generation_ratio( factory_worker_percentage, *city_history_month, MAX_CITY_HISTORY, HIST_MAIL_GENERATED);
+		target_factories_mail.recalc_generation_ratio( factory_worker_percentage, city_history_month, HIST_MAIL_GENERATED);
 	}
 
 	// is it time for the next step?
@@ -1474,14 +1531,14 @@ void stadt_t::step(uint32 delta_t)
 	}
 
 	// update history (might be changed do to construction/destroying of houses)
-	city_history_month[0][HIST_CITIZENS] = get_einwohner(); // total number
-	city_history_year[0][HIST_CITIZENS] = get_einwohner();
+	city_history_month.at(0, HIST_CITIZENS) = get_einwohner(); // total number
+	city_history_year.at(0, HIST_CITIZENS) = get_einwohner();
 
-	city_history_month[0][HIST_GROWTH] = city_history_month[0][HIST_CITIZENS]-city_history_month[1][HIST_CITIZENS]; // growth
-	city_history_year[0][HIST_GROWTH] = city_history_year[0][HIST_CITIZENS]-city_history_year[1][HIST_CITIZENS];
+	city_history_month.at(0, HIST_GROWTH) = city_history_month.at(0, HIST_CITIZENS)-city_history_month.at(1, HIST_CITIZENS); // growth
+	city_history_year.at(0, HIST_GROWTH) = city_history_year.at(0, HIST_CITIZENS)-city_history_year.at(1, HIST_CITIZENS);
 
-	city_history_month[0][HIST_BUILDING] = buildings.get_count();
-	city_history_year[0][HIST_BUILDING] = buildings.get_count();
+	city_history_month.at(0, HIST_BUILDING) = buildings.get_count();
+	city_history_year.at(0, HIST_BUILDING) = buildings.get_count();
 }
 
 
@@ -1490,55 +1547,38 @@ void stadt_t::step(uint32 delta_t)
 void stadt_t::roll_history()
 {
 	// roll months
-	for (int i = MAX_CITY_HISTORY_MONTHS - 1; i > 0; i--) {
-		for (int hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_month[i][hist_type] = city_history_month[i - 1][hist_type];
-		}
-	}
+	city_history_month.advance();
 	// init this month
-	for (int hist_type = 1; hist_type < MAX_CITY_HISTORY; hist_type++) {
-		city_history_month[0][hist_type] = 0;
-	}
-	city_history_month[0][HIST_CITIZENS] = get_einwohner();
-	city_history_month[0][HIST_BUILDING] = buildings.get_count();
-	city_history_month[0][HIST_GOODS_NEEDED] = 0;
+	city_history_month.at(0, HIST_CITIZENS) = get_einwohner();
+	city_history_month.at(0, HIST_BUILDING) = buildings.get_count();
+	city_history_month.at(0, HIST_GOODS_NEEDED) = 0;
 
 	//need to roll year too?
 	if (welt->get_last_month() == 0) {
-		for (int i = MAX_CITY_HISTORY_YEARS - 1; i > 0; i--) {
-			for (int hist_type = 0; hist_type < MAX_CITY_HISTORY; hist_type++) {
-				city_history_year[i][hist_type] = city_history_year[i - 1][hist_type];
-			}
-		}
+		city_history_year.advance();
 		// init this year
-		for (int hist_type = 1; hist_type < MAX_CITY_HISTORY; hist_type++) {
-			city_history_year[0][hist_type] = 0;
-		}
-		city_history_year[0][HIST_CITIZENS] = get_einwohner();
-		city_history_year[0][HIST_BUILDING] = buildings.get_count();
-		city_history_year[0][HIST_GOODS_NEEDED] = 0;
+		city_history_year.at(0, HIST_CITIZENS) = get_einwohner();
+		city_history_year.at(0, HIST_BUILDING) = buildings.get_count();
+		city_history_year.at(0, HIST_GOODS_NEEDED) = 0;
 	}
 }
 
 
 void stadt_t::city_growth_get_factors(city_growth_factor_t(&factors)[GROWTH_FACTOR_NUMBER], uint32 const month) const {
-	// optimize view of history for convenience
-	sint64 const (&h)[MAX_CITY_HISTORY] = city_history_month[month];
-
 	// go through each index one at a time
 	uint32 index = 0;
 
 	// passenger growth factors
-	factors[index  ].demand   = h[HIST_PAS_GENERATED];
-	factors[index++].supplied = h[HIST_PAS_TRANSPORTED] + h[HIST_PAS_WALKED];
+	factors[index  ].demand   = city_history_month.at(month, HIST_PAS_GENERATED);
+	factors[index++].supplied = city_history_month.at(month, HIST_PAS_TRANSPORTED) + city_history_month.at(month, HIST_PAS_WALKED);
 
 	// mail growth factors
-	factors[index  ].demand   = h[HIST_MAIL_GENERATED];
-	factors[index++].supplied = h[HIST_MAIL_TRANSPORTED] + h[HIST_MAIL_WALKED];
+	factors[index  ].demand   = city_history_month.at(month, HIST_MAIL_GENERATED);
+	factors[index++].supplied = city_history_month.at(month, HIST_MAIL_TRANSPORTED) + city_history_month.at(month, HIST_MAIL_WALKED);
 
 	// goods growth factors
-	factors[index  ].demand   = h[HIST_GOODS_NEEDED];
-	factors[index++].supplied = h[HIST_GOODS_RECEIVED];
+	factors[index  ].demand   = city_history_month.at(month, HIST_GOODS_NEEDED);
+	factors[index++].supplied = city_history_month.at(month, HIST_GOODS_RECEIVED);
 
 	assert(index == GROWTH_FACTOR_NUMBER);
 }
@@ -1630,7 +1670,7 @@ void stadt_t::city_growth_monthly(uint32 const month)
 }
 
 
-void stadt_t::new_month( bool recalc_destinations )
+void stadt_t::new_month()
 {
 	swap<PIXVAL>( pax_destinations_old, pax_destinations_new );
 	pax_destinations_new.clear();
@@ -1643,15 +1683,8 @@ void stadt_t::new_month( bool recalc_destinations )
 
 	const sint16 factory_worker_percentage = welt->get_settings().get_factory_worker_percentage();
 //	settings_t const& s = welt->get_settings();
-	target_factories_pax.recalc_generation_ratio( factory_worker_percentage, *city_history_month, MAX_CITY_HISTORY, HIST_PAS_GENERATED);
-	target_factories_mail.recalc_generation_ratio( factory_worker_percentage, *city_history_month, MAX_CITY_HISTORY, HIST_MAIL_GENERATED);
-	recalc_target_cities();
-
-	// center has moved => change attraction weights
-	if(  recalc_destinations  ||  last_center != get_center()  ) {
-		last_center = get_center();
-		recalc_target_attractions();
-	}
+	target_factories_pax.recalc_generation_ratio( factory_worker_percentage, city_history_month, HIST_PAS_GENERATED);
+	target_factories_mail.recalc_generation_ratio( factory_worker_percentage, city_history_month, HIST_MAIL_GENERATED);
 
 	if(  !private_car_t::list_empty()  &&  welt->get_settings().get_traffic_level() > 0  ) {
 		// spawn eventual citycars
@@ -1659,17 +1692,17 @@ void stadt_t::new_month( bool recalc_destinations )
 		// the larger the city, the more spawned ...
 
 		/* original implementation that is replaced by integer-only version below
-		double pfactor = (double)(city_history_month[1][HIST_PAS_TRANSPORTED]) / (double)(city_history_month[1][HIST_PAS_GENERATED]+1);
-		double mfactor = (double)(city_history_month[1][HIST_MAIL_TRANSPORTED]) / (double)(city_history_month[1][HIST_MAIL_GENERATED]+1);
-		double gfactor = (double)(city_history_month[1][HIST_GOODS_RECEIVED]) / (double)(city_history_month[1][HIST_GOODS_NEEDED]+1);
+		double pfactor = (double)(city_history_month.at(1, HIST_PAS_TRANSPORTED)) / (double)(city_history_month.at(1, HIST_PAS_GENERATED)+1);
+		double mfactor = (double)(city_history_month.at(1, HIST_MAIL_TRANSPORTED)) / (double)(city_history_month.at(1, HIST_MAIL_GENERATED)+1);
+		double gfactor = (double)(city_history_month.at(1, HIST_GOODS_RECEIVED)) / (double)(city_history_month.at(1, HIST_GOODS_NEEDED)+1);
 
 		double factor = pfactor > mfactor ? (gfactor > pfactor ? gfactor : pfactor ) : mfactor;
-		factor = (1.0-factor)*city_history_month[1][HIST_CITIZENS];
+		factor = (1.0-factor)*city_history_month.at(1, HIST_CITIZENS);
 		factor = log10( factor );
 		*/
 
 		// placeholder for fractions
-#		define decl_stat(name, i0, i1) sint64 name##_stat[2]; name##_stat[0] = city_history_month[1][i0];  name##_stat[1] = city_history_month[1][i1]+1;
+#		define decl_stat(name, i0, i1) sint64 name##_stat[2]; name##_stat[0] = city_history_month.at(1, i0);  name##_stat[1] = city_history_month.at(1, i1)+1;
 
 		// defines and initializes local sint64[2] arrays
 		decl_stat(pax, HIST_PAS_TRANSPORTED, HIST_PAS_GENERATED);
@@ -1678,8 +1711,8 @@ void stadt_t::new_month( bool recalc_destinations )
 
 		// true if s1[0] / s1[1] > s2[0] / s2[1]
 #		define comp_stats(s1,s2) ( s1[0]*s2[1] > s2[0]*s1[1] )
-		// computes (1.0 - s[0]/s[1]) * city_history_month[1][HIST_CITIZENS]
-#		define comp_factor(s) (city_history_month[1][HIST_CITIZENS] *( s[1]-s[0] )) / s[1]
+		// computes (1.0 - s[0]/s[1]) * city_history_month.at(1, HIST_CITIZENS)
+#		define comp_factor(s) (city_history_month.at(1, HIST_CITIZENS) *( s[1]-s[0] )) / s[1]
 
 		uint32 factor = (uint32)( comp_stats(pax_stat, mail_stat) ? (comp_stats(good_stat, pax_stat) ? comp_factor(good_stat) : comp_factor(pax_stat)) : comp_factor(mail_stat) );
 		factor = log10(factor);
@@ -1687,8 +1720,8 @@ void stadt_t::new_month( bool recalc_destinations )
 #ifndef DESTINATION_CITYCARS
 		uint16 number_of_cars = simrand( factor * welt->get_settings().get_traffic_level() ) / 16;
 
-		city_history_month[0][HIST_CITYCARS] = number_of_cars;
-		city_history_year[0][HIST_CITYCARS] += number_of_cars;
+		city_history_month.at(0, HIST_CITYCARS) = number_of_cars;
+		city_history_year.at(0, HIST_CITYCARS) += number_of_cars;
 
 		koord k;
 		koord pos = get_zufallspunkt();
@@ -1712,16 +1745,28 @@ void stadt_t::new_month( bool recalc_destinations )
 		}
 
 		// correct statistics for ungenerated cars
-		city_history_month[0][HIST_CITYCARS] -= number_of_cars;
-		city_history_year[0][HIST_CITYCARS] -= number_of_cars;
+		city_history_month.at(0, HIST_CITYCARS) -= number_of_cars;
+		city_history_year.at(0, HIST_CITYCARS) -= number_of_cars;
 #else
-		city_history_month[0][HIST_CITYCARS] = 0;
+		city_history_month.at(0, HIST_CITYCARS) = 0;
 		number_of_cars = simrand( factor * welt->get_settings().get_traffic_level() ) / 16;
 #endif
 	}
 }
 
 
+void stadt_t::recalc_monthly( bool recalc_destinations )
+{
+	recalc_target_cities();
+
+	// center has moved => change attraction weights
+	if(  recalc_destinations  ||  last_center != get_center()  ) {
+		last_center = get_center();
+		recalc_target_attractions();
+	}
+}
+
+
 void stadt_t::calc_growth()
 {
 	// now iterate over all factories to get the ratio of producing version non-producing factories
@@ -1732,11 +1777,11 @@ void stadt_t::calc_growth()
 			// consumer => check for it storage
 			const factory_desc_t *const desc = fab->get_desc();
 			for(  int i=0;  i<desc->get_supplier_count();  i++  ) {
-				city_history_month[0][HIST_GOODS_NEEDED] ++;
-				city_history_year[0][HIST_GOODS_NEEDED] ++;
+				city_history_month.at(0, HIST_GOODS_NEEDED) ++;
+				city_history_year.at(0, HIST_GOODS_NEEDED) ++;
 				if(  fab->get_input_stock( desc->get_supplier(i)->get_input_type() )>0  ) {
-					city_history_month[0][HIST_GOODS_RECEIVED] ++;
-					city_history_year[0][HIST_GOODS_RECEIVED] ++;
+					city_history_month.at(0, HIST_GOODS_RECEIVED) ++;
+					city_history_year.at(0, HIST_GOODS_RECEIVED) ++;
 				}
 			}
 		}
@@ -1853,8 +1898,8 @@ void stadt_t::step_passagiere()
 	}
 
 	// track number of generated passengers.
-	city_history_year[0][history_type + HIST_OFFSET_GENERATED] += num_pax;
-	city_history_month[0][history_type + HIST_OFFSET_GENERATED] += num_pax;
+	city_history_year.at(0, history_type + HIST_OFFSET_GENERATED) += num_pax;
+	city_history_month.at(0, history_type + HIST_OFFSET_GENERATED) += num_pax;
 
 	// only continue, if this is a good start halt
 	if(  !start_halts.empty()  ) {
@@ -1870,7 +1915,7 @@ void stadt_t::step_passagiere()
 			pax_return_type will_return;
 			factory_entry_t *factory_entry = NULL;
 			stadt_t *dest_city = NULL;
-			const koord dest_pos = find_destination(target_factories, city_history_month[0][history_type + HIST_OFFSET_GENERATED], &will_return, factory_entry, dest_city);
+			const koord dest_pos = find_destination(target_factories, city_history_month.at(0, history_type + HIST_OFFSET_GENERATED), &will_return, factory_entry, dest_city);
 			if(  factory_entry  ) {
 				if (welt->get_settings().get_factory_enforce_demand()) {
 					// ensure no more than remaining amount
@@ -1898,8 +1943,8 @@ void stadt_t::step_passagiere()
 				start_halt->add_pax_happy(pax.amount);
 
 				// people were transported so are logged
-				city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
-				city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_left_to_do;
+				city_history_year.at(0, history_type + HIST_OFFSET_TRANSPORTED) += pax_left_to_do;
+				city_history_month.at(0, history_type + HIST_OFFSET_TRANSPORTED) += pax_left_to_do;
 
 				// destination logged
 				merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
@@ -1914,8 +1959,8 @@ void stadt_t::step_passagiere()
 				start_halt->add_pax_walked(pax_left_to_do);
 
 				// people who walk or deliver by hand logged as walking
-				city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
-				city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_left_to_do;
+				city_history_year.at(0, history_type + HIST_OFFSET_WALKED) += pax_left_to_do;
+				city_history_month.at(0, history_type + HIST_OFFSET_WALKED) += pax_left_to_do;
 
 				// probably not a good idea to mark them as player only cares about remote traffic
 				//merke_passagier_ziel(dest_pos, color_idx_to_rgb(COL_YELLOW));
@@ -1963,8 +2008,8 @@ void stadt_t::step_passagiere()
 				}
 
 				// log potential return passengers at destination city
-				dest_city->city_history_year[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
-				dest_city->city_history_month[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
+				dest_city->city_history_year.at(0, history_type + HIST_OFFSET_GENERATED) += pax_return;
+				dest_city->city_history_month.at(0, history_type + HIST_OFFSET_GENERATED) += pax_return;
 
 				// factories generate return traffic
 				if (  factory_entry  ) {
@@ -1992,8 +2037,8 @@ void stadt_t::step_passagiere()
 						return_halt->add_pax_happy(pax_return);
 
 						// log departed at destination city
-						dest_city->city_history_year[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
-						dest_city->city_history_month[0][history_type + HIST_OFFSET_TRANSPORTED] += pax_return;
+						dest_city->city_history_year.at(0, history_type + HIST_OFFSET_TRANSPORTED) += pax_return;
+						dest_city->city_history_month.at(0, history_type + HIST_OFFSET_TRANSPORTED) += pax_return;
 					}
 					else {
 						// stop is crowded
@@ -2013,8 +2058,8 @@ void stadt_t::step_passagiere()
 					start_halt->add_pax_walked(pax_return);
 
 					// log people who walk or deliver by hand
-					dest_city->city_history_year[0][history_type + HIST_OFFSET_WALKED] += pax_return;
-					dest_city->city_history_month[0][history_type + HIST_OFFSET_WALKED] += pax_return;
+					dest_city->city_history_year.at(0, history_type + HIST_OFFSET_WALKED) += pax_return;
+					dest_city->city_history_month.at(0, history_type + HIST_OFFSET_WALKED) += pax_return;
 				}
 				else if(  route_result == haltestelle_t::ROUTE_OVERCROWDED  ) {
 					// overcrowded routes cause unhappiness to be logged
@@ -2070,7 +2115,7 @@ void stadt_t::step_passagiere()
 		pax_return_type will_return;
 		factory_entry_t *factory_entry = NULL;
 		stadt_t *dest_city = NULL;
-		const koord ziel = find_destination(target_factories, city_history_month[0][history_type + HIST_OFFSET_GENERATED], &will_return, factory_entry, dest_city);
+		const koord ziel = find_destination(target_factories, city_history_month.at(0, history_type + HIST_OFFSET_GENERATED), &will_return, factory_entry, dest_city);
 		if(  factory_entry  ) {
 			// consider at most 1 packet's amount as factory-going
 			sint32 amount = min(PACKET_SIZE, num_pax);
@@ -2096,8 +2141,8 @@ void stadt_t::step_passagiere()
 			}
 
 			// log potential return passengers at destination city
-			dest_city->city_history_year[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
-			dest_city->city_history_month[0][history_type + HIST_OFFSET_GENERATED] += pax_return;
+			dest_city->city_history_year.at(0, history_type + HIST_OFFSET_GENERATED) += pax_return;
+			dest_city->city_history_month.at(0, history_type + HIST_OFFSET_GENERATED) += pax_return;
 
 			// factories generate return traffic
 			if (  factory_entry  ) {
@@ -3421,8 +3466,8 @@ void stadt_t::generate_private_cars(koord pos, koord target)
 						}
 						private_car_t* vt = new private_car_t(gr, target);
 						gr->obj_add(vt);
-						city_history_month[0][HIST_CITYCARS] ++;
-						city_history_year[0][HIST_CITYCARS] ++;
+						city_history_month.at(0, HIST_CITYCARS) ++;
+						city_history_year.at(0, HIST_CITYCARS) ++;
 						number_of_cars --;
 						return;
 					}
@@ -3697,13 +3742,16 @@ void stadt_t::build()
 	// checks only make sense on empty ground
 	if(gr->ist_natur()) {
 
+		// the tiles around are classified once for all rules
+		rule_area_t area(k);
+
 		// since only a single location is checked, we can stop after we have found a positive rule
 		best_strasse.reset(k);
 		const uint32 num_road_rules = road_rules.get_count();
 		uint32 offset = simrand(num_road_rules); // start with random rule
 		for (uint32 i = 0; i < num_road_rules  &&  !best_strasse.found(); i++) {
 			uint32 rule = ( i+offset ) % num_road_rules;
-			bewerte_strasse(k, 8 + road_rules[rule]->chance, *road_rules[rule]);
+			bewerte_strasse(area, 8 + road_rules[rule]->chance, *road_rules[rule]);
 		}
 		// ok => then built road
 		if (best_strasse.found()) {
@@ -3720,7 +3768,7 @@ void stadt_t::build()
 		offset = simrand(num_house_rules); // start with random rule
 		for(  uint32 i = 0;  i < num_house_rules  &&  !best_haus.found();  i++  ) {
 			uint32 rule = ( i+offset ) % num_house_rules;
-			bewerte_haus(k, 8 + house_rules[rule]->chance, *house_rules[rule]);
+			bewerte_haus(area, 8 + house_rules[rule]->chance, *house_rules[rule]);
 		}
 		// one rule applied?
 		if(  best_haus.found()  ) {
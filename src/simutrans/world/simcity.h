@@ -13,6 +13,7 @@
 #include "../tpl/vector_tpl.h"
 #include "../tpl/weighted_vector_tpl.h"
 #include "../tpl/sparse_tpl.h"
+#include "../tpl/history_tpl.h"
 #include "../utils/plainstring.h"
 
 #include <string>
@@ -21,6 +22,7 @@ class building_desc_t;
 class karte_ptr_t;
 class player_t;
 class rule_t;
+struct rule_area_t;
 
 
 #define MAX_CITY_HISTORY_YEARS  (12) // number of years to keep history
@@ -183,8 +185,8 @@ private:
 	* City history
 	* Current month stats are not appropiate to determine satisfaction for growth.
 	*/
-	sint64 city_history_year[MAX_CITY_HISTORY_YEARS][MAX_CITY_HISTORY];
-	sint64 city_history_month[MAX_CITY_HISTORY_MONTHS][MAX_CITY_HISTORY];
+	history_tpl<sint64, MAX_CITY_HISTORY_YEARS, MAX_CITY_HISTORY> city_history_year;
+	history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> city_history_month;
 
 	/* updates the city history
 	*/
@@ -230,12 +232,10 @@ private:
 
 public:
 	/**
-	 * Returns pointer to history for city
+	 * Returns the history for city
 	 */
-	sint64* get_city_history_year() { return *city_history_year; }
-	sint64* get_city_history_month() { return *city_history_month; }
-	const sint64* get_city_history_year() const { return *city_history_year; }
-	const sint64* get_city_history_month() const { return *city_history_month; }
+	const history_tpl<sint64, MAX_CITY_HISTORY_YEARS, MAX_CITY_HISTORY> &get_city_history_year() const { return city_history_year; }
+	const history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> &get_city_history_month() const { return city_history_month; }
 
 	uint32 stadtinfo_options;
 
@@ -292,7 +292,7 @@ public:
 		factory_entry_t* get_random_entry();
 		void update_factory(fabrik_t *const factory, const sint32 demand);
 		void remove_factory(fabrik_t *const factory);
-		void recalc_generation_ratio(const sint32 default_percent, const sint64 *city_stats, const int stats_count, const int stat_type);
+		void recalc_generation_ratio(const sint32 default_percent, const history_tpl<sint64, MAX_CITY_HISTORY_MONTHS, MAX_CITY_HISTORY> &city_stats, const int stat_type);
 		void new_month();
 		void rdwr(loadsave_t *file);
 		void resolve_factories();
@@ -382,19 +382,18 @@ private:
 	void build();
 
 	/**
-	 * @param pos position to check
-	 * @param regel the rule to evaluate
-	 * @return true on match, false otherwise
+	 * Looks up the tiles around area.pos once for all rules
 	 */
-	static bool bewerte_loc(koord pos, const rule_t &regel, int rotation);
+	static void classify_area(rule_area_t &area);
 
 	/**
 	 * Check rule in all transformations at given position
+	 * @return 1 on match, 0 otherwise
 	 */
-	static sint32 bewerte_pos(koord pos, const rule_t &regel);
+	static sint32 bewerte_pos(rule_area_t &area, const rule_t &regel);
 
-	void bewerte_strasse(koord pos, sint32 rd, const rule_t &regel);
-	void bewerte_haus(koord pos, sint32 rd, const rule_t &regel);
+	void bewerte_strasse(rule_area_t &area, sint32 rd, const rule_t &regel);
+	void bewerte_haus(rule_area_t &area, sint32 rd, const rule_t &regel);
 
 	/**
 	 * Updates city limits: tile at @p pos belongs to city.
@@ -435,11 +434,11 @@ public:
 	/**
 	* Returns the finance history for cities
 	*/
-	sint64 get_finance_history_year(int year, int type) { return city_history_year[year][type]; }
-	sint64 get_finance_history_month(int month, int type) { return city_history_month[month][type]; }
+	sint64 get_finance_history_year(int year, int type) { return city_history_year.at(year, type); }
+	sint64 get_finance_history_month(int month, int type) { return city_history_month.at(month, type); }
 
 	// growth number (smoothed!)
-	sint32 get_wachstum() const {return ((sint32)city_history_month[0][HIST_GROWTH]*5) + (sint32)(city_history_month[1][HIST_GROWTH]*4) + (sint32)city_history_month[2][HIST_GROWTH]; }
+	sint32 get_wachstum() const {return ((sint32)city_history_month.at(0, HIST_GROWTH)*5) + (sint32)(city_history_month.at(1, HIST_GROWTH)*4) + (sint32)city_history_month.at(2, HIST_GROWTH); }
 
 	/**
 	 * ermittelt die Einwohnerzahl der City
@@ -512,7 +511,15 @@ public:
 
 	void step(uint32 delta_t);
 
-	void new_month( bool recalc_destinations );
+	/// rolls the history and the monthly statistics, spawns the citycars
+	void new_month();
+
+	/**
+	 * The expensive part of the monthly update: target cities and attractions.
+	 * Called by the world some steps after new_month(). Uses no random numbers,
+	 * since it is not done before saving (the targets are recalculated on loading).
+	 */
+	void recalc_monthly( bool recalc_destinations );
 
 private:
 	/**
@@ -532,6 +539,7 @@ public:
 	void add_target_city(stadt_t *const city);
 	void remove_target_city(stadt_t *const city) { target_cities.remove( city ); }
 	void recalc_target_cities();
+	uint32 get_target_cities_weight() const { return target_cities.get_sum_weight(); }
 
 	/**
 	 * Functions for manipulating the list of target attractions
@@ -109,6 +109,7 @@ DBG_MESSAGE("planquadrat_t::boden_hinzufuegen()","addition ground %s at (%i,%i,%
 		tmp[1] = bd;
 		data.some = tmp;
 		ground_size = 2;
+		welt->update_tile_summary(data.some[0]);
 		minimap_t::get_instance()->calc_map_pixel(bd->get_pos().get_2d());
 		return;
 	}
@@ -138,6 +139,7 @@ DBG_MESSAGE("planquadrat_t::boden_hinzufuegen()","addition ground %s at (%i,%i,%
 		ground_size ++;
 		delete [] data.some;
 		data.some = tmp;
+		welt->update_tile_summary(data.some[0]);
 		minimap_t::get_instance()->calc_map_pixel(bd->get_pos().get_2d());
 	}
 }
@@ -166,6 +168,7 @@ bool planquadrat_t::boden_entfernen(grund_t *bd)
 					delete [] data.some;
 					data.one = tmp;
 				}
+				welt->update_tile_summary(get_kartenboden());
 				return true;
 			}
 		}
@@ -186,6 +189,7 @@ void planquadrat_t::kartenboden_setzen(grund_t *bd, bool startup)
 		data.one = bd;
 		ground_size = 1;
 		bd->set_kartenboden(true);
+		welt->update_tile_summary(bd);
 	}
 	if (!startup) {
 		// water tiles need neighbor tiles, which might not be initialized at startup
@@ -236,6 +240,7 @@ void planquadrat_t::boden_ersetzen(grund_t *alt, grund_t *neu)
 		}
 		delete alt;
 	}
+	welt->update_tile_summary(neu);
 }
 
 
@@ -321,16 +326,26 @@ void planquadrat_t::rdwr(loadsave_t *file, koord pos )
 }
 
 
-void planquadrat_t::check_season_snowline(const bool season_change, const bool snowline_change)
+bool planquadrat_t::check_season_snowline(const bool season_change, const bool snowline_change, const bool defer_tree_events)
 {
+	bool deferred = false;
 	if(  ground_size == 1  ) {
-		data.one->check_season_snowline( season_change, snowline_change );
+		deferred = data.one->check_season_snowline( season_change, snowline_change, defer_tree_events );
 	}
 	else if(  ground_size > 1  ) {
 		for(  uint8 i = 0;  i < ground_size;  i++  ) {
-			data.some[i]->check_season_snowline( season_change, snowline_change );
+			deferred |= data.some[i]->check_season_snowline( season_change, snowline_change, defer_tree_events );
 		}
 	}
+	return deferred;
+}
+
+
+void planquadrat_t::check_season_tree_events(const bool season_change, const bool snowline_change)
+{
+	for(  uint8 i = 0;  i < ground_size;  i++  ) {
+		get_boden_bei(i)->check_season_tree_events( season_change, snowline_change );
+	}
 }
 
 
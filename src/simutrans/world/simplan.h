@@ -209,8 +209,16 @@ public:
 
 	/**
 	* Updates season and/or snowline dependent graphics
+	* @param defer_tree_events leave trees which plant or die for check_season_tree_events(),
+	*        so different tiles can be updated in parallel
+	* @return true if trees were left
 	*/
-	void check_season_snowline(const bool season_change, const bool snowline_change);
+	bool check_season_snowline(const bool season_change, const bool snowline_change, const bool defer_tree_events = false);
+
+	/**
+	* Trees left by check_season_snowline(), they may plant trees on the neighbour tiles
+	*/
+	void check_season_tree_events(const bool season_change, const bool snowline_change);
 
 	void display_obj(const sint16 xpos, const sint16 ypos, const sint16 raster_tile_width, const bool is_global, const sint8 hmin, const sint8 hmax  CLIP_NUM_DEF) const;
 
@@ -90,6 +90,7 @@
 #include "../dataobj/pakset_manager.h"
 
 #include "../utils/cbuffer.h"
+#include "../utils/profiler.h"
 #include "../utils/simrandom.h"
 #include "../utils/simstring.h"
 
@@ -410,6 +411,8 @@ void karte_t::destroy()
 	destroying = true;
 	DBG_MESSAGE("karte_t::destroy()", "destroying world");
 
+	clear_month_rollover();
+
 	uint32 max_display_progress = 256+cities.get_count()*10 + haltestelle_t::get_alle_haltestellen().get_count() + convoi_array.get_count() + (cached_size.x*cached_size.y)*2;
 	uint32 old_progress = 0;
 
@@ -493,6 +496,8 @@ void karte_t::destroy()
 	// dinge aufraeumen
 	cached_grid_size.x = cached_grid_size.y = 1;
 	cached_size.x = cached_size.y = 0;
+	delete [] tile_summary;
+	tile_summary = NULL;
 	delete [] plan;
 	plan = NULL;
 	DBG_MESSAGE("karte_t::destroy()", "planquadrat destroyed");
@@ -588,6 +593,10 @@ bool karte_t::remove_city(stadt_t *s)
 		DBG_MESSAGE("karte_t::remove_city()", "%s", s->get_name());
 	}
 	cities.remove(s);
+	const uint32 rollover_index = rollover_cities.index_of(s);
+	if(  rollover_index < rollover_cities.get_count()  ) {
+		rollover_cities[rollover_index] = NULL;
+	}
 	DBG_DEBUG4("karte_t::remove_city()", "reduce city to %i", settings.get_city_count() - 1);
 	settings.set_city_count(settings.get_city_count() - 1);
 
@@ -623,6 +632,8 @@ void karte_t::init_tiles()
 	MEMZERON(grid_hgts, (x + 1) * (y + 1));
 	water_hgts = new sint8[x * y];
 	MEMZERON(water_hgts, x * y);
+	tile_summary = new tile_summary_t[x * y];
+	MEMZERON(tile_summary, x * y);
 
 	win_set_world( this );
 	minimap_t::get_instance()->init();
@@ -653,20 +664,10 @@ void karte_t::init_tiles()
 	pending_snowline_change = 0;
 
 	// init global history
-	for (int year=0; year<MAX_WORLD_HISTORY_YEARS; year++) {
-		for (int cost_type=0; cost_type<MAX_WORLD_COST; cost_type++) {
-			finance_history_year[year][cost_type] = 0;
-		}
-	}
-	for (int month=0; month<MAX_WORLD_HISTORY_MONTHS; month++) {
-		for (int cost_type=0; cost_type<MAX_WORLD_COST; cost_type++) {
-			finance_history_month[month][cost_type] = 0;
-		}
-	}
+	finance_history_year.clear();
+	finance_history_month.clear();
 	last_month_bev = 0;
 
-	tile_counter = 0;
-
 	convoihandle_t::init( 1024 );
 	linehandle_t::init( 1024 );
 
@@ -814,7 +815,7 @@ void karte_t::distribute_cities(int new_city_count, sint32 new_mean_citizen_coun
 #endif
 			for(  int i=0;  i<new_city_count;  i++  ) {
 				if (const stadt_t *s = create_city((*pos)[i], 1)) {
-					DBG_DEBUG("karte_t::distribute_cities()","Erzeuge stadt %i with %ld inhabitants",i,(s->get_city_history_month())[HIST_CITIZENS] );
+					DBG_DEBUG("karte_t::distribute_cities()","Erzeuge stadt %i with %ld inhabitants",i,s->get_city_history_month().at(0, HIST_CITIZENS) );
 				}
 			}
 
@@ -884,8 +885,8 @@ void karte_t::distribute_cities(int new_city_count, sint32 new_mean_citizen_coun
 			settings.set_industry_increase_every( original_industry_growth );
 			msg->clear();
 		}
-		finance_history_year[0][WORLD_TOWNS] = finance_history_month[0][WORLD_TOWNS] = cities.get_count();
-		finance_history_year[0][WORLD_CITIZENS] = finance_history_month[0][WORLD_CITIZENS] = last_month_bev;
+		finance_history_year.at(0, WORLD_TOWNS) = finance_history_month.at(0, WORLD_TOWNS) = cities.get_count();
+		finance_history_year.at(0, WORLD_CITIZENS) = finance_history_month.at(0, WORLD_CITIZENS) = last_month_bev;
 
 		// connect some cities with roads
 		way_desc_t const* desc = settings.get_intercity_road_type(get_timeline_year_month());
@@ -1121,37 +1122,110 @@ void karte_t::distribute_cities(int new_city_count, sint32 new_mean_citizen_coun
 }
 
 
+/*
+ * Map generation in parallel: the map is split into regions of rows with
+ * their own random numbers (see simrand_stream_t), so the map only depends
+ * on the seed. Each region first decides on its objects in parallel, then
+ * the objects are created in the order of the regions.
+ */
+#define MAP_REGION_ROWS (32)
+
+// the part of the map to fill and the seed of the current pass
+static koord region_start, region_end;
+static sint16 region_old_x, region_old_y;
+static uint32 region_seed;
+
+struct groundobj_plan_t
+{
+	koord pos;
+	const groundobj_desc_t *desc;
+};
+
+static vector_tpl<groundobj_plan_t> *groundobj_plans = NULL;
+
+struct tree_plan_t
+{
+	koord pos;
+	uint8 tree_id;
+	uint16 age;
+};
+
+static vector_tpl<tree_plan_t> *tree_plans = NULL;
+
+
+static uint32 get_region_count(sint16 ytop, sint16 ybottom)
+{
+	return ybottom > ytop ? (ybottom - 1) / MAP_REGION_ROWS - ytop / MAP_REGION_ROWS + 1 : 0;
+}
+
+
+// the rows of the n-th region in ytop ... ybottom
+static void get_region_rows(uint32 region, sint16 ytop, sint16 ybottom, sint16 &y_min, sint16 &y_max)
+{
+	const sint32 first = (ytop / MAP_REGION_ROWS + region) * MAP_REGION_ROWS;
+	y_min = max( ytop, first );
+	y_max = min( ybottom, first + MAP_REGION_ROWS );
+}
+
+
+void karte_t::plan_groundobjs_region(uint32 region)
+{
+	sint16 y_min, y_max;
+	get_region_rows( region, 0, get_size().y, y_min, y_max );
+	simrand_stream_t stream( region_seed, y_min );
+	vector_tpl<groundobj_plan_t> &plans = groundobj_plans[region];
+
+	koord k;
+	sint32 queried = simrand(env_t::ground_object_probability*2-1);
+	for(  k.y=y_min;  k.y<y_max;  k.y++  ) {
+		for(  k.x=(k.y<region_old_y)?region_old_x:0;  k.x<get_size().x;  k.x++  ) {
+			const grund_t *gr = lookup_kartenboden_nocheck(k);
+			if(  gr->get_typ()==grund_t::boden  &&  !gr->hat_wege()  ) {
+				queried --;
+				if(  queried<0  ) {
+					// test for beach
+					bool neighbour_water = false;
+					for(int i=0; i<8; i++) {
+						if(  is_within_limits(k + koord::neighbours[i])  &&  get_climate( k + koord::neighbours[i] ) == water_climate  ) {
+							neighbour_water = true;
+							break;
+						}
+					}
+					const climate_bits cl = neighbour_water ? water_climate_bit : (climate_bits)(1<<get_climate(k));
+					groundobj_plan_t plan;
+					plan.pos = k;
+					plan.desc = groundobj_t::random_groundobj_for_climate( cl, gr->get_grund_hang() );
+					queried = simrand(env_t::ground_object_probability*2-1);
+					if(  plan.desc  ) {
+						plans.append( plan );
+					}
+				}
+			}
+		}
+	}
+}
+
+
 void karte_t::distribute_groundobjs(sint16 old_x, sint16 old_y)
 {
 DBG_DEBUG("karte_t::distribute_groundobj()","distributing groundobjs");
 	if(  env_t::ground_object_probability > 0  ) {
 		// add eyecandy like rocky, moles, flowers, ...
-		koord k;
-		sint32 queried = simrand(env_t::ground_object_probability*2-1);
-		for(  k.y=0;  k.y<get_size().y;  k.y++  ) {
-			for(  k.x=(k.y<old_y)?old_x:0;  k.x<get_size().x;  k.x++  ) {
-				grund_t *gr = lookup_kartenboden_nocheck(k);
-				if(  gr->get_typ()==grund_t::boden  &&  !gr->hat_wege()  ) {
-					queried --;
-					if(  queried<0  ) {
-						// test for beach
-						bool neighbour_water = false;
-						for(int i=0; i<8; i++) {
-							if(  is_within_limits(k + koord::neighbours[i])  &&  get_climate( k + koord::neighbours[i] ) == water_climate  ) {
-								neighbour_water = true;
-								break;
-							}
-						}
-						const climate_bits cl = neighbour_water ? water_climate_bit : (climate_bits)(1<<get_climate(k));
-						const groundobj_desc_t *desc = groundobj_t::random_groundobj_for_climate( cl, gr->get_grund_hang() );
-						queried = simrand(env_t::ground_object_probability*2-1);
-						if(desc) {
-							gr->obj_add( new groundobj_t( gr->get_pos(), desc ) );
-						}
-					}
-				}
+		const uint32 regions = get_region_count( 0, get_size().y );
+		groundobj_plans = new vector_tpl<groundobj_plan_t>[regions];
+		region_old_x = old_x;
+		region_old_y = old_y;
+		region_seed = simrand_plain();
+		index_loop( [](uint32 region) { world->plan_groundobjs_region(region); }, regions );
+
+		for(  uint32 r = 0;  r < regions;  r++  ) {
+			for(groundobj_plan_t const& plan : groundobj_plans[r]) {
+				grund_t *gr = lookup_kartenboden_nocheck(plan.pos);
+				gr->obj_add( new groundobj_t( gr->get_pos(), plan.desc ) );
 			}
 		}
+		delete [] groundobj_plans;
+		groundobj_plans = NULL;
 	}
 }
 
@@ -1302,7 +1376,7 @@ DBG_DEBUG("karte_t::init()","built timeline");
 	}
 
 	settings.set_factory_count( fab_list.get_count() );
-	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
+	finance_history_year.at(0, WORLD_FACTORIES) = finance_history_month.at(0, WORLD_FACTORIES) = fab_list.get_count();
 
 	// tourist attractions
 	factory_builder_t::distribute_attractions(settings.get_tourist_attractions());
@@ -1600,6 +1674,60 @@ void karte_t::create_beaches(  int xoff, int yoff  )
 }
 
 
+// adds the planted trees to the plans
+static void plan_trees_on_coordinate(vector_tpl<tree_plan_t> &plans, koord pos, const uint8 maximum_count, const uint8 count)
+{
+	const uint8 count_planted = min( tree_builder_t::get_free_tree_count( pos, maximum_count ), count );
+	for(  uint8 i = 0;  i < count_planted;  i++  ) {
+		// same as the random tree in baum_t::baum_t(koord3d)
+		tree_plan_t plan;
+		plan.pos = pos;
+		plan.age = simrand(baum_t::AGE_LIMIT-1);
+		plan.tree_id = (uint8)tree_builder_t::random_tree_id_for_climate( world()->get_climate( pos ) );
+		plans.append( plan );
+	}
+}
+
+
+void karte_t::plan_trees_region(uint32 region)
+{
+	sint16 y_min, y_max;
+	get_region_rows( region, region_start.y, region_end.y, y_min, y_max );
+	simrand_stream_t stream( region_seed, y_min );
+	vector_tpl<tree_plan_t> &plans = tree_plans[region];
+
+	koord pos;
+	for(  pos.y=y_min;  pos.y<y_max;  pos.y++  ) {
+		for(  pos.x=region_start.x;  pos.x<region_end.x;  pos.x++  ) {
+			const grund_t *gr = lookup_kartenboden(pos);
+			if(gr->get_top() == 0  &&  gr->get_typ() == grund_t::boden)  {
+				if(humidity_map.at(pos.x,pos.y)>75) {
+					const uint32 tree_probability = (humidity_map.at(pos.x,pos.y) - 75)/5 + 38;
+					uint8 number_to_plant = 0;
+					uint8 const max_trees_here = min(get_settings().get_max_no_of_trees_on_square(), (tree_probability - 38 + 1) / 2);
+					for (uint8 c2 = 0 ; c2<max_trees_here; c2++) {
+						const uint32 rating = simrand(10) + 38 + c2*2;
+						if (rating < tree_probability ) {
+							number_to_plant++;
+						}
+					}
+
+					plan_trees_on_coordinate(plans, pos, get_settings().get_max_no_of_trees_on_square(), number_to_plant);
+				}
+				else if(humidity_map.at(pos.x,pos.y)>75) {
+					// plant spare trees, (those with low preffered density) or in an entirely tree climate
+					uint16 cl = 1 << get_climate(pos);
+					settings_t const& s = get_settings();
+					if ((cl & s.get_no_tree_climates()) == 0 && ((cl & s.get_tree_climates()) != 0 || simrand(s.get_forest_inverse_spare_tree_density() * /*dichte*/3) < 100)) {
+						plan_trees_on_coordinate(plans, pos, 1, 1);
+					}
+				}
+			}
+		}
+	}
+}
+
+
 void karte_t::distribute_trees_region( sint16 xtop, sint16 ytop, sint16 xbottom, sint16 ybottom  )
 {
 	// now distribute trees
@@ -1607,35 +1735,21 @@ void karte_t::distribute_trees_region( sint16 xtop, sint16 ytop, sint16 xbottom,
 	switch (settings.get_tree_distribution()) {
 	case settings_t::TREE_DIST_RAINFALL:
 		if( humidity_map.get_height() != 0 ) {
-			koord pos;
-			for(  pos.y=ytop;  pos.y<ybottom;  pos.y++  ) {
-				for(  pos.x=xtop;  pos.x<xbottom;  pos.x++  ) {
-					grund_t *gr = lookup_kartenboden(pos);
-					if(gr->get_top() == 0  &&  gr->get_typ() == grund_t::boden)  {
-						if(humidity_map.at(pos.x,pos.y)>75) {
-							const uint32 tree_probability = (humidity_map.at(pos.x,pos.y) - 75)/5 + 38;
-							uint8 number_to_plant = 0;
-							uint8 const max_trees_here = min(get_settings().get_max_no_of_trees_on_square(), (tree_probability - 38 + 1) / 2);
-							for (uint8 c2 = 0 ; c2<max_trees_here; c2++) {
-								const uint32 rating = simrand(10) + 38 + c2*2;
-								if (rating < tree_probability ) {
-									number_to_plant++;
-								}
-							}
-
-							tree_builder_t::plant_tree_on_coordinate(pos, get_settings().get_max_no_of_trees_on_square(), number_to_plant);
-						}
-						else if(humidity_map.at(pos.x,pos.y)>75) {
-							// plant spare trees, (those with low preffered density) or in an entirely tree climate
-							uint16 cl = 1 << get_climate(pos);
-							settings_t const& s = get_settings();
-							if ((cl & s.get_no_tree_climates()) == 0 && ((cl & s.get_tree_climates()) != 0 || simrand(s.get_forest_inverse_spare_tree_density() * /*dichte*/3) < 100)) {
-								tree_builder_t::plant_tree_on_coordinate(pos, 1, 1);
-							}
-						}
-					}
+			const uint32 regions = get_region_count( ytop, ybottom );
+			tree_plans = new vector_tpl<tree_plan_t>[regions];
+			region_start = koord( xtop, ytop );
+			region_end = koord( xbottom, ybottom );
+			region_seed = simrand_plain();
+			index_loop( [](uint32 region) { world->plan_trees_region(region); }, regions );
+
+			for(  uint32 r = 0;  r < regions;  r++  ) {
+				for(tree_plan_t const& plan : tree_plans[r]) {
+					grund_t *gr = lookup_kartenboden_nocheck(plan.pos);
+					gr->obj_add( new baum_t( gr->get_pos(), plan.tree_id, plan.age, gr->get_grund_hang() ) );
 				}
 			}
+			delete [] tree_plans;
+			tree_plans = NULL;
 			break;
 		}
 		// fall-through
@@ -1722,6 +1836,10 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 	grid_hgts = new_grid_hgts;
 	delete [] water_hgts;
 	water_hgts = new_water_hgts;
+	delete [] tile_summary;
+	tile_summary = new tile_summary_t[new_size.x * new_size.y];
+	// the new tiles are added by kartenboden_setzen() later
+	world_xy_loop(&karte_t::update_tile_summary_range, 0);
 
 	if(  new_world  ) {
 		// init max and min with defaults
@@ -2017,6 +2135,7 @@ karte_t::karte_t() :
 	viewport = new viewport_t(this);
 
 	set_dirty();
+	parallel_image_change = false;
 
 	// for new world just set load version to current savegame version
 	load_version = loadsave_t::int_version( env_t::savegame_version_str, NULL );
@@ -2042,6 +2161,8 @@ karte_t::karte_t() :
 
 	map_counter = 0;
 
+	clear_month_rollover();
+
 	msg = new message_t();
 	chat_msg = new chat_message_t();
 
@@ -2405,6 +2526,9 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	cached_grid_size.x = cached_grid_size.y;
 	cached_grid_size.y = wx;
 
+	// grund_t::rotate90() does not update the tile summary
+	world_xy_loop(&karte_t::update_tile_summary_range, 0);
+
 	// now step all towns (to generate passengers)
 	for (stadt_t* const i : cities) {
 		i->rotate90(cached_size.x);
@@ -2629,6 +2753,9 @@ stadt_t *karte_t::find_nearest_city(const koord k) const
  */
 void karte_t::sync_step(uint32 delta_t)
 {
+	profiler_t::end_frame();
+	PROFILE_SCOPE(SEC_SYNC_STEP);
+
 	set_random_mode( SYNC_STEP_RANDOM );
 
 	// only omitted, when called to display a new frame during fast forward
@@ -2828,6 +2955,12 @@ void karte_t::update_frame_sleep_time()
 			}
 		}
 	}
+	else if(  env_t::fast_forward_unthrottled  ) {
+		assert(step_mode == FAST_FORWARD);
+
+		// simulation runs unpaced: only a minimal display rate to keep the UI alive
+		set_frame_time( 1000/env_t::min_fps );
+	}
 	else  {
 		assert(step_mode == FAST_FORWARD);
 
@@ -2849,8 +2982,8 @@ void karte_t::update_frame_sleep_time()
 void karte_t::buche(sint64 const betrag, player_cost const type)
 {
 	assert(type < MAX_WORLD_COST);
-	finance_history_year[0][type] += betrag;
-	finance_history_month[0][type] += betrag;
+	finance_history_year.at(0, type) += betrag;
+	finance_history_month.at(0, type) += betrag;
 	// to do: check for dependencies
 }
 
@@ -2861,18 +2994,25 @@ inline sint32 get_population(stadt_t const* const c)
 }
 
 
+// the monthly recalculation of the city targets is spread over this many steps
+#define MONTH_ROLLOVER_STEPS (16)
+
 void karte_t::new_month()
 {
+	PROFILE_SCOPE(SEC_NEW_MONTH);
 	bool need_locality_update = false;
 
+	// cities of the last month still waiting must be done before the month changes again
+	finish_month_rollover();
+
 	update_history();
 
 	// advance history ...
-	last_month_bev = finance_history_month[ 0 ][ WORLD_CITIZENS ];
+	last_month_bev = finance_history_month.at(0, WORLD_CITIZENS);
+	// the new month starts with the values of the last one
+	finance_history_month.advance();
 	for( int hist = 0; hist < karte_t::MAX_WORLD_COST; hist++ ) {
-		for( int y = MAX_WORLD_HISTORY_MONTHS - 1; y > 0; y-- ) {
-			finance_history_month[ y ][ hist ] = finance_history_month[ y - 1 ][ hist ];
-		}
+		finance_history_month.at( 0, hist ) = finance_history_month.at( 1, hist );
 	}
 
 	current_month++;
@@ -2893,9 +3033,7 @@ void karte_t::new_month()
 	DBG_MESSAGE( "karte_t::new_month()", "Month (%d/%d) has started", (last_month % 12) + 1, last_month / 12 );
 
 	// this should be done before a map update, since the map may want an update of the way usage
-	for(weg_t* const w : weg_t::get_alle_wege() ) {
-		w->new_month();
-	}
+	weg_t::new_month_all();
 
 	// recalc old settings (and maybe update the stops with the current values)
 	minimap_t::get_instance()->new_month();
@@ -2910,10 +3048,15 @@ void karte_t::new_month()
 
 
 //	DBG_MESSAGE("karte_t::new_month()","cities");
+	// all cities roll their history now, the target cities and attractions are recalculated in the next steps
 	cities.update_weights(get_population);
 	for(stadt_t* const i : cities) {
-		i->new_month(need_locality_update);
+		i->new_month();
+		rollover_cities.append( i );
 	}
+	rollover_recalc_destinations = need_locality_update;
+	rollover_pos = 0;
+	rollover_budget = max( 1u, (rollover_cities.get_count() + MONTH_ROLLOVER_STEPS - 1) / MONTH_ROLLOVER_STEPS );
 
 	INT_CHECK("simworld 1282");
 
@@ -2984,15 +3127,44 @@ void karte_t::new_month()
 }
 
 
+void karte_t::step_month_rollover(uint32 budget)
+{
+	uint32 pos = rollover_pos;
+	const uint32 end = rollover_cities.get_count();
+	for(  ;  pos < end  &&  budget > 0;  pos++, budget--  ) {
+		if(  stadt_t *city = rollover_cities[pos]  ) {
+			city->recalc_monthly( rollover_recalc_destinations );
+		}
+	}
+
+	rollover_pos = pos;
+	if(  pos == end  ) {
+		if(  end > 0  ) {
+			DBG_MESSAGE( "karte_t::step_month_rollover()", "Recalculated %u cities", end );
+		}
+		clear_month_rollover();
+	}
+}
+
+
+void karte_t::clear_month_rollover()
+{
+	rollover_cities.clear();
+	rollover_pos = 0;
+	rollover_budget = 0;
+	rollover_recalc_destinations = false;
+}
+
+
 void karte_t::new_year()
 {
 	last_year = current_month/12;
 
 	// advance history ...
+	// the new year starts with the values of the last one
+	finance_history_year.advance();
 	for(  int hist=0;  hist<karte_t::MAX_WORLD_COST;  hist++  ) {
-		for( int y=MAX_WORLD_HISTORY_YEARS-1; y>0;  y--  ) {
-			finance_history_year[y][hist] = finance_history_year[y-1][hist];
-		}
+		finance_history_year.at(0, hist) = finance_history_year.at(1, hist);
 	}
 
 DBG_MESSAGE("karte_t::new_year()","speedbonus for %d %i, %i, %i, %i, %i, %i, %i, %i", last_year,
@@ -3135,6 +3307,9 @@ void karte_t::set_schedule_counter()
 
 void karte_t::step()
 {
+	profiler_t::end_step();
+	PROFILE_SCOPE(SEC_STEP);
+
 	DBG_DEBUG4("karte_t::step", "start step");
 	uint32 time = dr_time();
 
@@ -3156,6 +3331,11 @@ void karte_t::step()
 		new_month();
 	}
 
+	if(  rollover_budget > 0  ) {
+		PROFILE_SCOPE(SEC_NEW_MONTH);
+		step_month_rollover( rollover_budget );
+	}
+
 	DBG_DEBUG4("karte_t::step", "time calculations");
 	if(  step_mode==NORMAL  ) {
 		/* Try to maintain a decent pause, with a step every 170-250 ms (~5,5 simloops/s)
@@ -3185,7 +3365,11 @@ void karte_t::step()
 			simloops = (10000*32) / (last_step_nr[steps%32]-last_step_nr[(steps+1)%32]);
 		}
 		// now try to approach the target speed
-		if(last_5_simloops<env_t::max_acceleration) {
+		if(  env_t::fast_forward_unthrottled  ) {
+			// no target: next step as soon as this one is done
+			idle_time = 0;
+		}
+		else if(last_5_simloops<env_t::max_acceleration) {
 			if(idle_time>0) {
 				idle_time --;
 			}
@@ -3216,24 +3400,29 @@ void karte_t::step()
 	const bool snowline_change = pending_snowline_change > 0;
 	if(  season_change  ||  snowline_change  ) {
 		DBG_DEBUG4("karte_t::step", "pending_season_change");
-		// process
-		const uint32 end_count = min( cached_grid_size.x * cached_grid_size.y,  tile_counter + max( 16384, cached_grid_size.x * cached_grid_size.y / 16 ) );
-		while(  tile_counter < end_count  ) {
-			plan[tile_counter].check_season_snowline( season_change, snowline_change );
-			tile_counter++;
-			if(  (tile_counter & 0x3FF) == 0  ) {
+		// the images of all tiles in parallel
+		// (marking single images dirty would race on the dirty tiles of the display)
+		season_tree_tiles.clear();
+		parallel_image_change = true;
+		world_xy_loop( &karte_t::check_season_snowline_loop, SYNCX_FLAG );
+		parallel_image_change = false;
+		set_dirty();
+
+		// trees plant and die in map order, independent of the number of threads
+		std::sort( season_tree_tiles.begin(), season_tree_tiles.end() );
+		for(  uint32 i = 0;  i < season_tree_tiles.get_count();  i++  ) {
+			plan[ season_tree_tiles[i] ].check_season_tree_events( season_change, snowline_change );
+			if(  (i & 0x3FF) == 0x3FF  ) {
 				INT_CHECK("karte_t::step");
 			}
 		}
+		season_tree_tiles.clear();
 
-		if(  tile_counter >= (uint32)cached_grid_size.x * (uint32)cached_grid_size.y  ) {
-			if(  season_change ) {
-				pending_season_change--;
-			}
-			if(  snowline_change  ) {
-				pending_snowline_change--;
-			}
-			tile_counter = 0;
+		if(  season_change ) {
+			pending_season_change--;
+		}
+		if(  snowline_change  ) {
+			pending_snowline_change--;
 		}
 	}
 
@@ -3241,31 +3430,40 @@ void karte_t::step()
 	INT_CHECK("karte_t::step");
 
 	DBG_DEBUG4("karte_t::step", "step convois");
-	// since convois will be deleted during stepping, we need to step backwards
-	for (size_t i = convoi_array.get_count(); i-- != 0;) {
-		convoihandle_t cnv = convoi_array[i];
-		cnv->step();
-		if((i&7)==0) {
-			INT_CHECK("simworld 1947");
+	{
+		PROFILE_SCOPE(SEC_CONVOI_STEP);
+		// since convois will be deleted during stepping, we need to step backwards
+		for (size_t i = convoi_array.get_count(); i-- != 0;) {
+			convoihandle_t cnv = convoi_array[i];
+			cnv->step();
+			if((i&7)==0) {
+				INT_CHECK("simworld 1947");
+			}
 		}
 	}
 
 	// now step all towns (to generate passengers)
 	DBG_DEBUG4("karte_t::step", "step cities");
 	sint64 bev=0;
-	for(stadt_t* const i : cities) {
-		i->step(delta_t);
-		bev += i->get_finance_history_month(0, HIST_CITIZENS);
+	{
+		PROFILE_SCOPE(SEC_CITY_STEP);
+		for(stadt_t* const i : cities) {
+			i->step(delta_t);
+			bev += i->get_finance_history_month(0, HIST_CITIZENS);
+		}
 	}
 
 	// the inhabitants stuff
-	finance_history_month[0][WORLD_CITIZENS] = bev;
+	finance_history_month.at(0, WORLD_CITIZENS) = bev;
 
 	DBG_DEBUG4("karte_t::step", "step factories");
-	for(fabrik_t* const f : fab_list) {
-		f->step(delta_t);
+	{
+		PROFILE_SCOPE(SEC_FACTORY_STEP);
+		for(fabrik_t* const f : fab_list) {
+			f->step(delta_t);
+		}
 	}
-	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
+	finance_history_year.at(0, WORLD_FACTORIES) = finance_history_month.at(0, WORLD_FACTORIES) = fab_list.get_count();
 
 	// step powerlines - required order: powernet, pumpe then senke
 	DBG_DEBUG4("karte_t::step", "step poweline stuff");
@@ -3343,7 +3541,7 @@ void karte_t::restore_history(bool restore_transported_only)
 				transported += players[i]->get_finance()->get_history_veh_month( TT_ALL, m, ATV_TRANSPORTED );
 			}
 		}
-		finance_history_month[m][WORLD_TRANSPORTED_GOODS] = max(transported, finance_history_month[m][WORLD_TRANSPORTED_GOODS]);
+		finance_history_month.at(m, WORLD_TRANSPORTED_GOODS) = max(transported, finance_history_month.at(m, WORLD_TRANSPORTED_GOODS));
 	}
 	for(  int y=min(MAX_WORLD_HISTORY_YEARS,MAX_CITY_HISTORY_YEARS)-1;  y>0;  y--  ) {
 		sint64 transported_year = 0;
@@ -3352,7 +3550,7 @@ void karte_t::restore_history(bool restore_transported_only)
 				transported_year += players[i]->get_finance()->get_history_veh_year( TT_ALL, y, ATV_TRANSPORTED );
 			}
 		}
-		finance_history_year[y][WORLD_TRANSPORTED_GOODS] = max(transported_year, finance_history_year[y][WORLD_TRANSPORTED_GOODS]);
+		finance_history_year.at(y, WORLD_TRANSPORTED_GOODS) = max(transported_year, finance_history_year.at(y, WORLD_TRANSPORTED_GOODS));
 	}
 	if (restore_transported_only) {
 		return;
@@ -3379,16 +3577,16 @@ void karte_t::restore_history(bool restore_transported_only)
 		if(last_month_bev == -1) {
 			last_month_bev = bev;
 		}
-		finance_history_month[m][WORLD_GROWTH] = bev-last_month_bev;
-		finance_history_month[m][WORLD_CITIZENS] = bev;
+		finance_history_month.at(m, WORLD_GROWTH) = bev-last_month_bev;
+		finance_history_month.at(m, WORLD_CITIZENS) = bev;
 		last_month_bev = bev;
 
 		// transportation ratio and total number
-		finance_history_month[m][WORLD_PAS_RATIO] = (10000*trans_pas)/total_pas;
-		finance_history_month[m][WORLD_PAS_GENERATED] = total_pas-1;
-		finance_history_month[m][WORLD_MAIL_RATIO] = (10000*trans_mail)/total_mail;
-		finance_history_month[m][WORLD_MAIL_GENERATED] = total_mail-1;
-		finance_history_month[m][WORLD_GOODS_RATIO] = (10000*supplied_goods)/total_goods;
+		finance_history_month.at(m, WORLD_PAS_RATIO) = (10000*trans_pas)/total_pas;
+		finance_history_month.at(m, WORLD_PAS_GENERATED) = total_pas-1;
+		finance_history_month.at(m, WORLD_MAIL_RATIO) = (10000*trans_mail)/total_mail;
+		finance_history_month.at(m, WORLD_MAIL_GENERATED) = total_mail-1;
+		finance_history_month.at(m, WORLD_GOODS_RATIO) = (10000*supplied_goods)/total_goods;
 	}
 
 	sint64 bev_last_year = -1;
@@ -3412,16 +3610,16 @@ void karte_t::restore_history(bool restore_transported_only)
 		if(bev_last_year == -1) {
 			bev_last_year = bev;
 		}
-		finance_history_year[y][WORLD_GROWTH] = bev-bev_last_year;
-		finance_history_year[y][WORLD_CITIZENS] = bev;
+		finance_history_year.at(y, WORLD_GROWTH) = bev-bev_last_year;
+		finance_history_year.at(y, WORLD_CITIZENS) = bev;
 		bev_last_year = bev;
 
 		// transportation ratio and total number
-		finance_history_year[y][WORLD_PAS_RATIO] = (10000*trans_pas_year)/total_pas_year;
-		finance_history_year[y][WORLD_PAS_GENERATED] = total_pas_year-1;
-		finance_history_year[y][WORLD_MAIL_RATIO] = (10000*trans_mail_year)/total_mail_year;
-		finance_history_year[y][WORLD_MAIL_GENERATED] = total_mail_year-1;
-		finance_history_year[y][WORLD_GOODS_RATIO] = (10000*supplied_goods_year)/total_goods_year;
+		finance_history_year.at(y, WORLD_PAS_RATIO) = (10000*trans_pas_year)/total_pas_year;
+		finance_history_year.at(y, WORLD_PAS_GENERATED) = total_pas_year-1;
+		finance_history_year.at(y, WORLD_MAIL_RATIO) = (10000*trans_mail_year)/total_mail_year;
+		finance_history_year.at(y, WORLD_MAIL_GENERATED) = total_mail_year-1;
+		finance_history_year.at(y, WORLD_GOODS_RATIO) = (10000*supplied_goods_year)/total_goods_year;
 	}
 
 	// fix current month/year
@@ -3431,8 +3629,8 @@ void karte_t::restore_history(bool restore_transported_only)
 
 void karte_t::update_history()
 {
-	finance_history_year[0][WORLD_CONVOIS] = finance_history_month[0][WORLD_CONVOIS] = convoi_array.get_count();
-	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
+	finance_history_year.at(0, WORLD_CONVOIS) = finance_history_month.at(0, WORLD_CONVOIS) = convoi_array.get_count();
+	finance_history_year.at(0, WORLD_FACTORIES) = finance_history_month.at(0, WORLD_FACTORIES) = fab_list.get_count();
 
 	// now step all towns (to generate passengers)
 	sint64 bev=0;
@@ -3458,27 +3656,27 @@ void karte_t::update_history()
 		total_goods_year    += i->get_finance_history_year( 0, HIST_GOODS_NEEDED);
 	}
 
-	finance_history_month[0][WORLD_GROWTH] = bev-last_month_bev;
-	finance_history_year[0][WORLD_GROWTH] = bev - (finance_history_year[1][WORLD_CITIZENS]==0 ? finance_history_month[0][WORLD_CITIZENS] : finance_history_year[1][WORLD_CITIZENS]);
+	finance_history_month.at(0, WORLD_GROWTH) = bev-last_month_bev;
+	finance_history_year.at(0, WORLD_GROWTH) = bev - (finance_history_year.at(1, WORLD_CITIZENS)==0 ? finance_history_month.at(0, WORLD_CITIZENS) : finance_history_year.at(1, WORLD_CITIZENS));
 
 	// the inhabitants stuff
-	finance_history_year[0][WORLD_TOWNS] = finance_history_month[0][WORLD_TOWNS] = cities.get_count();
-	finance_history_year[0][WORLD_CITIZENS] = finance_history_month[0][WORLD_CITIZENS] = bev;
-	finance_history_month[0][WORLD_GROWTH] = bev-last_month_bev;
-	finance_history_year[0][WORLD_GROWTH] = bev - (finance_history_year[1][WORLD_CITIZENS]==0 ? finance_history_month[0][WORLD_CITIZENS] : finance_history_year[1][WORLD_CITIZENS]);
+	finance_history_year.at(0, WORLD_TOWNS) = finance_history_month.at(0, WORLD_TOWNS) = cities.get_count();
+	finance_history_year.at(0, WORLD_CITIZENS) = finance_history_month.at(0, WORLD_CITIZENS) = bev;
+	finance_history_month.at(0, WORLD_GROWTH) = bev-last_month_bev;
+	finance_history_year.at(0, WORLD_GROWTH) = bev - (finance_history_year.at(1, WORLD_CITIZENS)==0 ? finance_history_month.at(0, WORLD_CITIZENS) : finance_history_year.at(1, WORLD_CITIZENS));
 
 	// transportation ratio and total number
-	finance_history_month[0][WORLD_PAS_RATIO] = (10000*trans_pas)/total_pas;
-	finance_history_month[0][WORLD_PAS_GENERATED] = total_pas-1;
-	finance_history_month[0][WORLD_MAIL_RATIO] = (10000*trans_mail)/total_mail;
-	finance_history_month[0][WORLD_MAIL_GENERATED] = total_mail-1;
-	finance_history_month[0][WORLD_GOODS_RATIO] = (10000*supplied_goods)/total_goods;
-
-	finance_history_year[0][WORLD_PAS_RATIO] = (10000*trans_pas_year)/total_pas_year;
-	finance_history_year[0][WORLD_PAS_GENERATED] = total_pas_year-1;
-	finance_history_year[0][WORLD_MAIL_RATIO] = (10000*trans_mail_year)/total_mail_year;
-	finance_history_year[0][WORLD_MAIL_GENERATED] = total_mail_year-1;
-	finance_history_year[0][WORLD_GOODS_RATIO] = (10000*supplied_goods_year)/total_goods_year;
+	finance_history_month.at(0, WORLD_PAS_RATIO) = (10000*trans_pas)/total_pas;
+	finance_history_month.at(0, WORLD_PAS_GENERATED) = total_pas-1;
+	finance_history_month.at(0, WORLD_MAIL_RATIO) = (10000*trans_mail)/total_mail;
+	finance_history_month.at(0, WORLD_MAIL_GENERATED) = total_mail-1;
+	finance_history_month.at(0, WORLD_GOODS_RATIO) = (10000*supplied_goods)/total_goods;
+
+	finance_history_year.at(0, WORLD_PAS_RATIO) = (10000*trans_pas_year)/total_pas_year;
+	finance_history_year.at(0, WORLD_PAS_GENERATED) = total_pas_year-1;
+	finance_history_year.at(0, WORLD_MAIL_RATIO) = (10000*trans_mail_year)/total_mail_year;
+	finance_history_year.at(0, WORLD_MAIL_GENERATED) = total_mail_year-1;
+	finance_history_year.at(0, WORLD_GOODS_RATIO) = (10000*supplied_goods_year)/total_goods_year;
 
 	// update total transported, including passenger and mail
 	sint64 transported = 0;
@@ -3490,8 +3688,8 @@ void karte_t::update_history()
 			transported_year += players[i]->get_finance()->get_history_veh_year( TT_ALL, 0, ATV_TRANSPORTED_GOOD );
 		}
 	}
-	finance_history_month[0][WORLD_TRANSPORTED_GOODS] = transported;
-	finance_history_year[0][WORLD_TRANSPORTED_GOODS] = transported_year;
+	finance_history_month.at(0, WORLD_TRANSPORTED_GOODS) = transported;
+	finance_history_year.at(0, WORLD_TRANSPORTED_GOODS) = transported_year;
 }
 
 
@@ -3582,6 +3780,9 @@ void karte_t::save(loadsave_t *file,bool silent)
 {
 	bool needs_redraw = false;
 
+	// a pending rollover is not finished here, saving must not change the game
+	// (the targets of all cities are recalculated on loading anyway)
+
 	loadingscreen_t *ls = NULL;
 DBG_MESSAGE("karte_t::save(loadsave_t *file)", "start");
 	if(!silent) {
@@ -3661,12 +3862,12 @@ DBG_MESSAGE("karte_t::save(loadsave_t *file)", "saved messages");
 		// most recent version is 99018
 		for (int year = 0;  year</*MAX_WORLD_HISTORY_YEARS*/12;  year++) {
 			for (int cost_type = 0; cost_type</*MAX_WORLD_COST*/12; cost_type++) {
-				file->rdwr_longlong(finance_history_year[year][cost_type]);
+				file->rdwr_longlong(finance_history_year.at(year, cost_type));
 			}
 		}
 		for (int month = 0;month</*MAX_WORLD_HISTORY_MONTHS*/12;month++) {
 			for (int cost_type = 0; cost_type</*MAX_WORLD_COST*/12; cost_type++) {
-				file->rdwr_longlong(finance_history_month[month][cost_type]);
+				file->rdwr_longlong(finance_history_month.at(month, cost_type));
 			}
 		}
 	}
@@ -4014,6 +4215,82 @@ void karte_t::plans_finish_rd( sint16 x_min, sint16 x_max, sint16 y_min, sint16
 }
 
 
+#ifdef MULTI_THREAD
+// indices are handed out in blocks, as the work per element is often small
+#define INDEX_LOOP_BLOCK (16)
+
+typedef struct {
+	index_loop_func function;
+	uint32 count;
+	uint32 next;
+	pthread_mutex_t mutex;
+} index_loop_param_t;
+
+
+static void *index_loop_thread(void *ptr)
+{
+	index_loop_param_t *param = reinterpret_cast<index_loop_param_t *>(ptr);
+	while(  true  ) {
+		pthread_mutex_lock( &param->mutex );
+		const uint32 first = param->next;
+		const uint32 last = min( first + INDEX_LOOP_BLOCK, param->count );
+		param->next = last;
+		pthread_mutex_unlock( &param->mutex );
+
+		if(  first >= last  ) {
+			return NULL;
+		}
+		for(  uint32 i = first;  i < last;  i++  ) {
+			param->function( i );
+		}
+	}
+}
+#endif
+
+
+void karte_t::index_loop(index_loop_func function, uint32 count)
+{
+#ifdef MULTI_THREAD
+	if(  env_t::num_threads > 1  &&  count > INDEX_LOOP_BLOCK  ) {
+		set_random_mode( INTERACTIVE_RANDOM ); // do not allow simrand() here!
+
+		index_loop_param_t param;
+		param.function = function;
+		param.count = count;
+		param.next = 0;
+		pthread_mutex_init( &param.mutex, NULL );
+
+		pthread_t thread[MAX_THREADS];
+		int spawned = 0;
+		while(  spawned < env_t::num_threads - 1  &&  pthread_create( &thread[spawned], NULL, index_loop_thread, &param ) == 0  ) {
+			spawned++;
+		}
+		// the main thread works too, so everything is done even if no thread could be started
+		index_loop_thread( &param );
+		for(  int t = 0;  t < spawned;  t++  ) {
+			pthread_join( thread[t], NULL );
+		}
+		pthread_mutex_destroy( &param.mutex );
+
+		clear_random_mode( INTERACTIVE_RANDOM );
+		return;
+	}
+#endif
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		function( i );
+	}
+}
+
+
+// logs the time since @p start for one part of karte_t::load() and restarts the clock
+static void log_load_phase(const char *phase, uint32 &start)
+{
+	const uint32 now = dr_time();
+	dbg->message( "karte_t::load()", "%-24s took %u ms", phase, now - start );
+	start = now;
+}
+
+
 void karte_t::load(loadsave_t *file)
 {
 	intr_disable();
@@ -4032,7 +4309,6 @@ void karte_t::load(loadsave_t *file)
 
 	loadingscreen_t ls(translator::translate("Loading map ..."), 1, true, true );
 
-	tile_counter = 0;
 	simloops = 60;
 
 	// jetzt geht das Laden los
@@ -4076,6 +4352,7 @@ DBG_MESSAGE("karte_t::load()", "%d ways loaded",weg_t::get_alle_wege().get_count
 
 	ls.set_progress( (get_size().y*3)/2+256 );
 
+	uint32 phase_start = dr_time();
 	world_xy_loop(&karte_t::plans_finish_rd, SYNCX_FLAG);
 
 	// update power nets with correct power
@@ -4089,17 +4366,20 @@ DBG_MESSAGE("karte_t::load()", "%d ways loaded",weg_t::get_alle_wege().get_count
 	ls.set_progress( (get_size().y*3)/2+256+get_size().y/8 );
 
 DBG_MESSAGE("karte_t::load()", "laden_abschliesen for tiles finished" );
+	log_load_phase( "tiles", phase_start );
 
 	// must finish loading cities first before cleaning up factories
 	weighted_vector_tpl<stadt_t*> new_cities(cities.get_count() + 1);
 	for(stadt_t* const s : cities) {
 		s->finish_rd();
-		s->recalc_target_cities();
 		new_cities.append(s, s->get_einwohner());
 		INT_CHECK("simworld 1278");
 	}
 	swap(cities, new_cities);
+	// each city only changes its own targets, and all cities are complete now
+	index_loop( [](uint32 i) { world->get_cities()[i]->recalc_target_cities(); }, cities.get_count() );
 	DBG_MESSAGE("karte_t::load()", "cities initialized");
+	log_load_phase( "cities", phase_start );
 
 	ls.set_progress( (get_size().y*3)/2+256+get_size().y/4 );
 
@@ -4109,6 +4389,7 @@ DBG_MESSAGE("karte_t::load()", "laden_abschliesen for tiles finished" );
 	}
 
 DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
+	log_load_phase( "factories", phase_start );
 
 	// old versions did not save factory connections
 	if(file->is_version_less(99, 14)) {
@@ -4145,6 +4426,7 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 	}
 
 	ls.set_progress( (get_size().y*3)/2+256+(get_size().y*3)/8 );
+	log_load_phase( "stops", phase_start );
 
 	// adding lines and other stuff for convois
 	for(unsigned i=0;  i<convoi_array.get_count();  i++ ) {
@@ -4156,6 +4438,7 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 		}
 	}
 	haltestelle_t::end_load_game();
+	log_load_phase( "convois", phase_start );
 
 	// register all line stops and change line types, if needed
 	for(int i=0; i<MAX_PLAYER_COUNT ; i++) {
@@ -4163,22 +4446,19 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 			players[i]->finish_rd();
 		}
 	}
+	log_load_phase( "players", phase_start );
+
+	// ways and stops were read without updating the tile summary
+	world_xy_loop(&karte_t::update_tile_summary_range, 0);
+	log_load_phase( "tile summary", phase_start );
 
-#ifdef DEBUG
-	uint32 dt = dr_time();
-#endif
 	// recalculate halt connections
-	haltestelle_t::reset_routing();
-	do {
-		haltestelle_t::step_all();
-	} while (  haltestelle_t::get_rerouting_status()==RECONNECTING  );
-#ifdef DEBUG
-	dbg->message("karte_t::load()", "for all haltstellen_t took %ld ms", dr_time()-dt );
-#endif
+	haltestelle_t::rebuild_all_connections();
+	log_load_phase( "stop connections", phase_start );
 
 #if 0
 	// reroute goods for benchmarking
-	dt = dr_time();
+	uint32 dt = dr_time();
 	for(halthandle_t const i : haltestelle_t::get_alle_haltestellen()) {
 		sint16 dummy = 0x7FFF;
 		i->reroute_goods(dummy);
@@ -4193,15 +4473,15 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 	else {
 		for (int year = 0;  year</*MAX_WORLD_HISTORY_YEARS*/12;  year++) {
 			for (int cost_type = 0; cost_type</*MAX_WORLD_COST*/12; cost_type++) {
-				file->rdwr_longlong(finance_history_year[year][cost_type]);
+				file->rdwr_longlong(finance_history_year.at(year, cost_type));
 			}
 		}
 		for (int month = 0;month</*MAX_WORLD_HISTORY_MONTHS*/12;month++) {
 			for (int cost_type = 0; cost_type</*MAX_WORLD_COST*/12; cost_type++) {
-				file->rdwr_longlong(finance_history_month[month][cost_type]);
+				file->rdwr_longlong(finance_history_month.at(month, cost_type));
 			}
 		}
-		last_month_bev = finance_history_month[1][WORLD_CITIZENS];
+		last_month_bev = finance_history_month.at(1, WORLD_CITIZENS);
 
 		if (file->is_version_atleast(112, 5) &&  file->is_version_less(120, 6)) {
 			restore_history(true);
@@ -4795,6 +5075,40 @@ void karte_t::update_map_intern(sint16 x_min, sint16 x_max, sint16 y_min, sint16
 }
 
 
+#ifdef MULTI_THREAD
+static pthread_mutex_t season_tree_tiles_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+void karte_t::check_season_snowline_loop(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
+{
+	const bool season_change = pending_season_change > 0;
+	const bool snowline_change = pending_snowline_change > 0;
+
+	vector_tpl<uint32> tree_tiles;
+	for(  int y = y_min;  y < y_max;  y++  ) {
+		for(  int x = x_min;  x < x_max;  x++  ) {
+			const uint32 nr = y * cached_grid_size.x + x;
+			if(  plan[nr].check_season_snowline( season_change, snowline_change, true )  ) {
+				tree_tiles.append( nr );
+			}
+		}
+	}
+
+	if(  !tree_tiles.empty()  ) {
+#ifdef MULTI_THREAD
+		pthread_mutex_lock( &season_tree_tiles_mutex );
+#endif
+		for(  uint32 const nr : tree_tiles  ) {
+			season_tree_tiles.append( nr );
+		}
+#ifdef MULTI_THREAD
+		pthread_mutex_unlock( &season_tree_tiles_mutex );
+#endif
+	}
+}
+
+
 bool karte_t::can_flood_to_depth(koord k, sint8 new_water_height, sint8 *stage, sint8 *our_stage, sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max  ) const
 {
 	bool succeeded = true;
@@ -5380,7 +5694,7 @@ void karte_t::reset_timer()
 	else if(step_mode==FAST_FORWARD) {
 		next_step_time = last_tick_sync+1;
 		idle_time = 0;
-		set_frame_time( 1000 / env_t::ff_fps );
+		set_frame_time( env_t::fast_forward_unthrottled ? 1000 / env_t::min_fps : 1000 / env_t::ff_fps );
 		time_multiplier = 16;
 		intr_enable();
 	}
@@ -5391,7 +5705,6 @@ void karte_t::reset_timer()
 		set_frame_time( fix_ratio_frame_time );
 		intr_disable();
 		// other stuff needed to synchronize
-		tile_counter = 0;
 		pending_season_change = 1;
 		pending_snowline_change = 1;
 	}
@@ -6227,6 +6540,7 @@ bool karte_t::interactive(uint32 quit_month)
 
 								if (timelag/time_per_step > previous_lag/time_per_step) {
 									dbg->warning("karte_t::interactive", "Server lagging by %lli ms (%d steps)", timelag, (sint32)(timelag/time_per_step) );
+									profiler_t::log_summary();
 								}
 							}
 
@@ -6267,6 +6581,14 @@ bool karte_t::interactive(uint32 quit_month)
 			}
 		}
 
+		// wall-clock cap for unthrottled fast forward
+		if(  step_mode==FAST_FORWARD  &&  env_t::fast_forward_unthrottled  &&  env_t::fast_forward_time_limit > 0  &&
+			(dr_time() - interactive_start_timer) / 1000 >= env_t::fast_forward_time_limit  ) {
+			dbg->message("karte_t::interactive()", "Fast forward time limit of %u s reached", env_t::fast_forward_time_limit);
+			env_t::quit_simutrans = true;
+			break;
+		}
+
 		// Interval-based server announcements
 		if (  env_t::server  &&  env_t::server_announce  &&  env_t::server_announce_interval > 0  &&
 			dr_time() - server_last_announce_time >= (uint32)env_t::server_announce_interval * 1000  ) {
@@ -18,6 +18,7 @@
 #include "../tpl/array2d_tpl.h"
 #include "../tpl/vector_tpl.h"
 #include "../tpl/slist_tpl.h"
+#include "../tpl/history_tpl.h"
 
 #include "../dataobj/settings.h"
 #include "../dataobj/loadsave.h"
@@ -59,6 +60,11 @@ class terraformer_t;
  */
 typedef void (karte_t::*xy_loop_func)(sint16, sint16, sint16, sint16);
 
+/**
+ * Threaded function caller for lists, gets the index of one element.
+ */
+typedef void (*index_loop_func)(uint32);
+
 
 /**
  * The map is the central part of the simulation. It stores all data and objects.
@@ -139,6 +145,12 @@ private:
 	 */
 	bool background_dirty;
 
+	/**
+	 * Images of all tiles are changed in parallel, objects must not mark
+	 * their images dirty. The whole map is redrawn afterwards.
+	 */
+	bool parallel_image_change;
+
 	/**
 	 * True during destroying of the map.
 	 */
@@ -227,17 +239,31 @@ private:
 	 */
 	weighted_vector_tpl<stadt_t*> cities;
 
+	/**
+	 * Cities still waiting for their monthly recalculation of targets.
+	 * Removed cities are set to NULL.
+	 */
+	vector_tpl<stadt_t *> rollover_cities;
+
+	/// next entry of rollover_cities
+	uint32 rollover_pos;
+
+	/// objects per step, so the rollover is done after MONTH_ROLLOVER_STEPS steps
+	uint32 rollover_budget;
+
+	bool rollover_recalc_destinations;
+
 	sint64 last_month_bev;
 
 	/**
 	 * The recorded history so far.
 	 */
-	sint64 finance_history_year[MAX_WORLD_HISTORY_YEARS][MAX_WORLD_COST];
+	history_tpl<sint64, MAX_WORLD_HISTORY_YEARS, MAX_WORLD_COST> finance_history_year;
 
 	/**
 	 * The recorded history so far.
 	 */
-	sint64 finance_history_month[MAX_WORLD_HISTORY_MONTHS][MAX_WORLD_COST];
+	history_tpl<sint64, MAX_WORLD_HISTORY_MONTHS, MAX_WORLD_COST> finance_history_month;
 
 	/**
 	 * World record speed manager.
@@ -445,9 +471,10 @@ private:
 	sint32 average_speed[8];
 
 	/**
-	 * Used to distribute the workload when changing seasons to several steps.
+	 * Tiles with trees, which plant new trees or die at the current change
+	 * of season. They are handled in map order after the parallel update.
 	 */
-	uint32 tile_counter;
+	vector_tpl<uint32> season_tree_tiles;
 
 	/**
 	 * To identify different stages of the same game.
@@ -461,9 +488,24 @@ private:
 
 	/**
 	 * Monthly actions.
+	 * All histories are rolled at once, only the recalculation of the
+	 * city targets is spread over the next steps, see step_month_rollover().
 	 */
 	void new_month();
 
+	/**
+	 * Calls recalc_monthly() of at most budget cities still waiting for it.
+	 * The number of cities per step is fixed, so all clients of a network
+	 * game process the same cities in the same step.
+	 */
+	void step_month_rollover(uint32 budget);
+
+	/// finishes the rollover of the current month immediately
+	void finish_month_rollover() { step_month_rollover( 0xFFFFFFFFu ); }
+
+	/// clears the rollover list without recalculating the cities
+	void clear_month_rollover();
+
 	/**
 	 * Yearly actions.
 	 */
@@ -518,6 +560,12 @@ private:
 	 */
 	void distribute_cities(int new_cities, sint32 new_mean_citizen_count, sint16 old_x, sint16 old_y );
 	void distribute_groundobjs(sint16 old_x, sint16 old_y);
+
+	/// decides on the ground objects of one region, see distribute_groundobjs()
+	void plan_groundobjs_region(uint32 region);
+
+	/// decides on the trees of one region, see distribute_trees_region()
+	void plan_trees_region(uint32 region);
 	void distribute_movingobjs(sint16 old_x, sint16 old_y);
 
 	/**
@@ -543,11 +591,22 @@ private:
 	 */
 	void update_map_intern(sint16, sint16, sint16, sint16);
 
+	/**
+	 * Updates season and snowline dependent images, collects season_tree_tiles.
+	 */
+	void check_season_snowline_loop(sint16, sint16, sint16, sint16);
+
 	bool can_flood_to_depth(koord k, sint8 new_water_height, sint8 *stage, sint8 *our_stage, sint16, sint16, sint16, sint16) const;
 
 	void flood_to_depth(sint8 new_water_height, sint8 *stage);
 
 public:
+	/**
+	 * Calls @p func for all indices below @p count, spread over all threads.
+	 * @p func must only change the element with its index and may not use simrand().
+	 */
+	void index_loop(index_loop_func func, uint32 count);
+
 	enum server_announce_type_t
 	{
 		SERVER_ANNOUNCE_HELLO     = 0, ///< my server is now up
@@ -617,6 +676,11 @@ public:
 	 */
 	void unset_background_dirty() { background_dirty = false; }
 
+	/**
+	 * parallel_image_change: no dirty marking of single images.
+	 */
+	bool is_parallel_image_change() const { return parallel_image_change; }
+
 	// do the internal accounting
 	void buche(sint64 betrag, player_cost type);
 
@@ -629,22 +693,22 @@ public:
 	/**
 	 * Returns the finance history for player.
 	 */
-	sint64 get_finance_history_year(int year, int type) const { return finance_history_year[year][type]; }
+	sint64 get_finance_history_year(int year, int type) const { return finance_history_year.at(year, type); }
 
 	/**
 	 * Returns the finance history for player.
 	 */
-	sint64 get_finance_history_month(int month, int type) const { return finance_history_month[month][type]; }
+	sint64 get_finance_history_month(int month, int type) const { return finance_history_month.at(month, type); }
 
 	/**
-	 * Returns pointer to finance history for player.
+	 * Returns finance history for player.
 	 */
-	const sint64* get_finance_history_year() const { return *finance_history_year; }
+	const history_tpl<sint64, MAX_WORLD_HISTORY_YEARS, MAX_WORLD_COST> &get_finance_history_year() const { return finance_history_year; }
 
 	/**
-	 * Returns pointer to finance history for player.
+	 * Returns finance history for player.
 	 */
-	const sint64* get_finance_history_month() const { return *finance_history_month; }
+	const history_tpl<sint64, MAX_WORLD_HISTORY_MONTHS, MAX_WORLD_COST> &get_finance_history_month() const { return finance_history_month; }
 
 	/**
 	 * Recalcs all map images.
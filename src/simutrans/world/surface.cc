@@ -10,6 +10,7 @@
 
 #include "../descriptor/ground_desc.h"
 #include "../ground/grund.h"
+#include "../obj/way/weg.h"
 #include "../player/simplay.h"
 
 
@@ -64,6 +65,57 @@ koord surface_t::get_closest_coordinate(koord outside_pos)
 }
 
 
+void surface_t::update_tile_summary(const grund_t *gr)
+{
+	const koord k = gr->get_pos().get_2d();
+	if(  tile_summary == NULL  ||  !is_within_limits(k)  ) {
+		return;
+	}
+	const planquadrat_t *pl = access_nocheck(k);
+	if(  pl->get_kartenboden() != gr  ) {
+		// not the ground level or not yet (or no longer) on the map
+		return;
+	}
+
+	tile_summary_t &ts = tile_summary[k.x + k.y*cached_grid_size.x];
+	ts.hoehe = gr->get_hoehe();
+	ts.slope = gr->get_grund_hang();
+	ts.ground_typ = gr->get_typ();
+	ts.ways = 0;
+	for(  int i = 0;  i < 2;  i++  ) {
+		if(  const weg_t *w = gr->get_weg_nr(i)  ) {
+			ts.ways |= get_way_bit( w->get_waytype() );
+		}
+	}
+	ts.flags = 0;
+	if(  pl->get_boden_count() > 1  ) {
+		ts.flags |= tile_summary_t::MULTIPLE_GROUNDS;
+	}
+	if(  gr->has_two_ways()  ) {
+		ts.flags |= tile_summary_t::HAS_TWO_WAYS;
+	}
+	ts.halt_id = gr->get_halt().get_id();
+}
+
+
+void surface_t::update_tile_summary_range(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
+{
+	for(  sint16 y = y_min;  y < y_max;  y++  ) {
+		for(  sint16 x = x_min;  x < x_max;  x++  ) {
+			const grund_t *gr = access_nocheck(x, y)->get_kartenboden();
+			if(  gr  ) {
+				update_tile_summary( gr );
+			}
+			else {
+				tile_summary_t &ts = tile_summary[x + y*cached_grid_size.x];
+				memset( &ts, 0, sizeof(tile_summary_t) );
+				ts.hoehe = groundwater;
+			}
+		}
+	}
+}
+
+
 bool surface_t::is_water(koord pos, koord dim) const
 {
 	koord k;
@@ -24,6 +24,47 @@ class player_t;
 /// The *_nocheck variant should be used if the 2d coordinate is already known to be valid.
 class surface_t
 {
+public:
+	/**
+	 * The most used properties of the ground level (kartenboden) of a tile.
+	 * Route search, city growth and display culling read these from one small
+	 * array instead of following planquadrat_t -> grund_t -> objlist_t.
+	 * Kept up to date by grund_t and planquadrat_t, see update_tile_summary().
+	 */
+	struct tile_summary_t
+	{
+		enum {
+			MULTIPLE_GROUNDS = 1 << 0, ///< there are bridges or tunnels on this tile, check the grounds
+			HAS_TWO_WAYS     = 1 << 1
+		};
+
+		sint8 hoehe;
+		uint8 slope;      ///< slope_t::type of the ground
+		uint8 ground_typ; ///< grund_t::typ, 0 for no ground
+		uint8 ways;       ///< get_way_bit() of all ways on the ground
+		uint8 flags;
+		uint16 halt_id;   ///< halthandle id, 0 for no halt
+	};
+
+	/**
+	 * @return bit for @p wt in tile_summary_t::ways, or 0 if this waytype is not tracked
+	 * (then the summary cannot tell if the tile has such a way)
+	 */
+	static uint8 get_way_bit(waytype_t wt)
+	{
+		switch(  wt  ) {
+			case road_wt:        return 1 << 0;
+			case track_wt:
+			case tram_wt:        return 1 << 1;
+			case water_wt:       return 1 << 2;
+			case monorail_wt:    return 1 << 3;
+			case maglev_wt:      return 1 << 4;
+			case narrowgauge_wt: return 1 << 5;
+			case air_wt:         return 1 << 6;
+			default:             return 0;
+		}
+	}
+
 protected:
 	/**
 	 * For performance reasons we have the map grid size cached locally, comes from the environment (Einstellungen)
@@ -89,6 +130,12 @@ protected:
 	 * @see cached_grid_size
 	 */
 	sint8 *water_hgts = NULL;
+
+	/**
+	 * Summary of the ground level of each tile.
+	 * @see cached_size
+	 */
+	tile_summary_t *tile_summary = NULL;
 	/** @} */
 
 	/// Table for fast conversion from height to climate.
@@ -274,6 +321,25 @@ public:
 
 	inline planquadrat_t *access(koord k) const { return access(k.x, k.y); }
 
+public:
+	inline const tile_summary_t &get_tile_summary_nocheck(koord k) const {
+		return tile_summary[k.x + k.y*cached_grid_size.x];
+	}
+
+	/// @return NULL outside the map
+	inline const tile_summary_t *get_tile_summary(koord k) const {
+		return is_within_limits(k) ? &tile_summary[k.x + k.y*cached_grid_size.x] : NULL;
+	}
+
+	/**
+	 * Copies the properties of @p gr to the tile summary.
+	 * Does nothing unless gr is the ground level of its tile.
+	 */
+	void update_tile_summary(const grund_t *gr);
+
+	/// recalculates the summary of all tiles in this range
+	void update_tile_summary_range(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max);
+
 public:
 	/**
 	 * @return Height at the grid point x,y - versions without checks for speed
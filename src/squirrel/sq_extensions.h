@@ -71,4 +71,7 @@ SQRESULT sq_get_ops_total(HSQUIRRELVM v);
 /// @returns amount of remaining opcodes until vm will be suspended
 SQRESULT sq_get_ops_remaing(HSQUIRRELVM v);
 
+/// @returns bytes currently allocated by all vms together
+SQUnsignedInteger sq_get_allocated_memory();
+
 #endif
@@ -3,9 +3,14 @@
 */
 #include "sqpcheader.h"
 #ifndef SQ_EXCLUDE_DEFAULT_MEMFUNCTIONS
-void *sq_vm_malloc(SQUnsignedInteger size){ return malloc(size); }
+// simutrans: count the memory of all vms, see sq_get_allocated_memory()
+static SQUnsignedInteger allocated_memory = 0;
 
-void *sq_vm_realloc(void *p, SQUnsignedInteger SQ_UNUSED_ARG(oldsize), SQUnsignedInteger size){ return realloc(p, size); }
+SQUnsignedInteger sq_get_allocated_memory(){ return allocated_memory; }
 
-void sq_vm_free(void *p, SQUnsignedInteger SQ_UNUSED_ARG(size)){ free(p); }
+void *sq_vm_malloc(SQUnsignedInteger size){ allocated_memory += size; return malloc(size); }
+
+void *sq_vm_realloc(void *p, SQUnsignedInteger oldsize, SQUnsignedInteger size){ allocated_memory += size - oldsize; return realloc(p, size); }
+
+void sq_vm_free(void *p, SQUnsignedInteger size){ allocated_memory -= size; free(p); }
 #endif
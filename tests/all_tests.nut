@@ -19,6 +19,7 @@ include("tests/test_groundobj")
 include("tests/test_halt")
 include("tests/test_headquarters")
 include("tests/test_label")
+include("tests/test_month")
 include("tests/test_player")
 include("tests/test_powerline")
 include("tests/test_reservation")
@@ -131,6 +132,8 @@ all_tests <- [
 	test_halt_move_stop_invalid_param,
 	test_headquarters_build_flat,
 	test_label,
+	test_month_rollover_recalc_cities,
+	test_month_rollover_remove_city,
 	test_player_cash,
 	test_player_isactive,
 	test_player_headquarters,
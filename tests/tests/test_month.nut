@@ -0,0 +1,116 @@
+//
+// This file is part of the Simutrans project under the Artistic License.
+// (see LICENSE.txt)
+//
+
+//
+// Tests for the monthly rollover
+//
+
+
+// the recalculation of the city targets is spread over this many steps (see simworld.cc)
+local month_rollover_steps = 16
+
+local month_city_pos = [ coord(2, 2), coord(12, 2), coord(2, 12) ]
+
+
+function wait_for_new_month()
+{
+	local month = world.get_time().raw
+	while (world.get_time().raw == month) {
+		sleep()
+	}
+}
+
+
+function wait_for_month_rollover()
+{
+	for (local i = 0; i <= month_rollover_steps; i++) {
+		sleep()
+	}
+}
+
+
+function add_month_cities()
+{
+	local cities = []
+	foreach (pos in month_city_pos) {
+		ASSERT_EQUAL(command_x(tool_add_city).work(player_x(1), coord3d(pos.x, pos.y, 0)), null)
+		local city = city_x(pos.x, pos.y)
+		city.set_citygrowth_enabled(false)
+		cities.append(city)
+	}
+	return cities
+}
+
+
+function remove_month_cities()
+{
+	foreach (pos in month_city_pos) {
+		local townhall = tile_x(pos.x, pos.y, 0)
+		if (townhall.find_object(mo_building) != null) {
+			ASSERT_EQUAL(command_x(tool_remover).work(player_x(1), townhall), null)
+		}
+	}
+	// the houses are gone with their cities, but not the roads they built
+	for (local y = 0; y < 16; y++) {
+		for (local x = 0; x < 16; x++) {
+			local tile = tile_x(x, y, 0)
+			if (tile.get_way(wt_road) != null) {
+				ASSERT_EQUAL(command_x(tool_remover).work(player_x(1), tile), null)
+			}
+		}
+	}
+}
+
+
+function test_month_rollover_recalc_cities()
+{
+	local cities = add_month_cities()
+
+	// the targets of the other cities do not change before the next month
+	local weights = []
+	{
+		local before = cities[0].get_target_cities_weight()
+		ASSERT_EQUAL(command_x(tool_change_city_size).work(player_x(0), coord3d(12, 2, 0), "100"), null)
+		ASSERT_EQUAL(cities[0].get_target_cities_weight(), before)
+
+		foreach (city in cities) {
+			weights.append(city.get_target_cities_weight())
+		}
+	}
+
+	// all cities know the new size once the rollover is done
+	{
+		wait_for_new_month()
+		wait_for_month_rollover()
+		foreach (i, city in cities) {
+			ASSERT_GREATER(city.get_target_cities_weight(), weights[i])
+		}
+	}
+
+	// clean up
+	remove_month_cities()
+	RESET_ALL_PLAYER_FUNDS()
+}
+
+
+function test_month_rollover_remove_city()
+{
+	local cities = add_month_cities()
+	ASSERT_EQUAL(command_x(tool_change_city_size).work(player_x(0), coord3d(2, 12, 0), "100"), null)
+
+	// remove the second city while the last one still waits for its recalculation
+	{
+		wait_for_new_month()
+		ASSERT_EQUAL(command_x(tool_remover).work(player_x(1), coord3d(12, 2, 0)), null)
+		local weight = cities[2].get_target_cities_weight()
+
+		wait_for_month_rollover()
+		ASSERT_GREATER(cities[2].get_target_cities_weight(), weight)
+	}
+
+	// clean up
+	remove_month_cities()
+	RESET_ALL_PLAYER_FUNDS()
+}